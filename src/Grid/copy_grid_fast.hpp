@@ -9,12 +9,70 @@
 #define OPENFPM_DATA_SRC_GRID_COPY_GRID_FAST_HPP_
 
 #include "Grid/iterators/grid_key_dx_iterator.hpp"
+#include "memory_ly/memory_aosoa.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+#include <emmintrin.h>
+#endif
+
+//! Minimum number of elements in a box copy before the copy is split across threads
+#ifndef GRID_COPY_PAR_MIN
+#define GRID_COPY_PAR_MIN 65536
+#endif
+
+/*! Minimum number of bytes written by a box copy before the rows are written with non-temporal stores,
+ *  disabled by default (memcpy already stream the big rows)
+ */
+#ifndef GRID_COPY_NT_MIN
+#define GRID_COPY_NT_MIN ((size_t)-1)
+#endif
+
+/*! \brief Indicate if all the properties of an aggregate can be copied with memcpy
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct is_trivially_copyable_prp
+{
+	typedef typename boost::mpl::fold<typename T::type,
+									  boost::mpl::true_,
+									  boost::mpl::and_<boost::mpl::_1,std::is_trivially_copyable<boost::mpl::_2>>>::type type;
+
+	enum
+	{
+		value = type::value
+	};
+};
+
+/*! \brief Select between the element by element copy and the row copy of copy_grid_fast
+ *
+ * A copy marked as complex (properties that need pack or a not contiguous property list) is
+ * still done in rows with memcpy when all the properties are trivially copyable. The AoSoA
+ * layout and objects without properties are always copied element by element
+ *
+ * \tparam is_complex the copy is marked as complex
+ * \tparam grid type of the grid
+ *
+ */
+template<bool is_complex, typename grid>
+struct copy_grid_fast_is_complex
+{
+	enum
+	{
+		value = (is_complex && !is_trivially_copyable_prp<typename grid::value_type>::value) ||
+				is_layout_aosoa<typename grid::layout_base_>::value ||
+				grid::value_type::max_prop == 0
+	};
+};
 
 template<unsigned int dim>
 struct striding
 {
-	size_t striding_src[dim - 1];
-	size_t striding_dst[dim - 1];
+	size_t striding_src[(dim > 1)?dim - 1:1];
+	size_t striding_dst[(dim > 1)?dim - 1:1];
 	size_t n_cpy;
 	size_t tot_y;
 };
@@ -251,24 +309,130 @@ struct copy_grid_fast<true,1,grid,ginfo>
 
 ////// In case the property is not complex
 
-template<unsigned int object_size>
-void copy_grid_fast_longx_3(const Box<3,size_t> & bx_src,
-							unsigned char * ptr_dst,
-							unsigned char * ptr_src,
-							striding<3> & sr)
+/*! \brief Copy a row of bytes bypassing the cache on the destination
+ *
+ * \param ptr_dst destination
+ * \param ptr_src source
+ * \param n number of bytes
+ *
+ */
+static inline void copy_grid_fast_row_nt(unsigned char * ptr_dst, const unsigned char * ptr_src, size_t n)
 {
-	for (size_t i = bx_src.getLow(2) ; i <= bx_src.getHigh(2) ; i++)
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+
+	// align the destination to 16 byte
+	size_t head = (16 - ((size_t)ptr_dst & 15)) & 15;
+	head = (head > n)?n:head;
+
+	memcpy(ptr_dst,ptr_src,head);
+	ptr_dst += head;
+	ptr_src += head;
+	n -= head;
+
+	for ( ; n >= 64 ; n -= 64)
 	{
-		for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
+		__m128i a0 = _mm_loadu_si128((const __m128i *)ptr_src);
+		__m128i a1 = _mm_loadu_si128((const __m128i *)(ptr_src + 16));
+		__m128i a2 = _mm_loadu_si128((const __m128i *)(ptr_src + 32));
+		__m128i a3 = _mm_loadu_si128((const __m128i *)(ptr_src + 48));
+
+		_mm_stream_si128((__m128i *)ptr_dst,a0);
+		_mm_stream_si128((__m128i *)(ptr_dst + 16),a1);
+		_mm_stream_si128((__m128i *)(ptr_dst + 32),a2);
+		_mm_stream_si128((__m128i *)(ptr_dst + 48),a3);
+
+		ptr_dst += 64;
+		ptr_src += 64;
+	}
+
+	for ( ; n >= 16 ; n -= 16)
+	{
+		_mm_stream_si128((__m128i *)ptr_dst,_mm_loadu_si128((const __m128i *)ptr_src));
+
+		ptr_dst += 16;
+		ptr_src += 16;
+	}
+
+	memcpy(ptr_dst,ptr_src,n);
+
+#else
+
+	memcpy(ptr_dst,ptr_src,n);
+
+#endif
+}
+
+/*! \brief Copy a box of objects row by row with memcpy, for any dimension
+ *
+ * The objects must be contiguous along x. Consecutive dimensions are merged when the box
+ * cover the full rows (slabs) in both source and destination, so in that case few large
+ * memcpy are done. Copies bigger than GRID_COPY_NT_MIN bytes are written with non-temporal
+ * stores
+ *
+ * \tparam dim dimensionality
+ * \tparam object_size size of the object
+ *
+ * \param bx_src source box
+ * \param ptr_dst pointer to the first object of the destination box
+ * \param ptr_src pointer to the first object of the source box
+ * \param sr striding
+ *
+ */
+template<unsigned int dim, unsigned int object_size>
+void copy_grid_fast_rows(const Box<dim,size_t> & bx_src,
+		unsigned char * ptr_dst,
+		unsigned char * ptr_src,
+		striding<dim> & sr)
+{
+	size_t sz[dim];
+	for (size_t i = 0 ; i < dim ; i++)
+	{sz[i] = bx_src.getHigh(i) - bx_src.getLow(i) + 1;}
+
+	// merge the dimensions covered completely
+	size_t row = sz[0]*object_size;
+	size_t d = 1;
+	while (d < dim && sr.striding_src[d-1] == row && sr.striding_dst[d-1] == row)
+	{
+		row *= sz[d];
+		d++;
+	}
+
+	size_t n_row = 1;
+	for (size_t i = d ; i < dim ; i++)
+	{n_row *= sz[i];}
+
+	bool nt = row*n_row >= GRID_COPY_NT_MIN;
+
+	size_t cnt[dim];
+	for (size_t i = 0 ; i < dim ; i++)
+	{cnt[i] = 0;}
+
+	for (size_t r = 0 ; r < n_row ; r++)
+	{
+		if (nt == true)
+		{copy_grid_fast_row_nt(ptr_dst,ptr_src,row);}
+		else
+		{memcpy(ptr_dst,ptr_src,row);}
+
+		for (size_t i = d ; i < dim ; i++)
 		{
-			memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);
+			cnt[i]++;
+			ptr_dst += sr.striding_dst[i-1];
+			ptr_src += sr.striding_src[i-1];
 
-			ptr_dst += sr.striding_dst[0];
-			ptr_src += sr.striding_src[0];
+			if (cnt[i] < sz[i])
+			{break;}
+
+			cnt[i] = 0;
+			ptr_dst -= sz[i]*sr.striding_dst[i-1];
+			ptr_src -= sz[i]*sr.striding_src[i-1];
 		}
-		ptr_dst += sr.striding_dst[1] - sr.tot_y*sr.striding_dst[0];
-		ptr_src += sr.striding_src[1] - sr.tot_y*sr.striding_src[0];
 	}
+
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+	if (nt == true)
+	{_mm_sfence();}
+#endif
 }
 
 template<unsigned int object_size, unsigned int n_cpy>
@@ -291,24 +455,6 @@ void copy_grid_fast_shortx_3(const Box<3,size_t> & bx_src,
 	}
 }
 
-
-////// In case the property is not complex
-
-template<unsigned int object_size>
-void copy_grid_fast_longx_2(const Box<2,size_t> & bx_src,
-							unsigned char * ptr_dst,
-							unsigned char * ptr_src,
-							striding<2> & sr)
-{
-	for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
-	{
-		memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);
-
-		ptr_dst += sr.striding_dst[0];
-		ptr_src += sr.striding_src[0];
-	}
-}
-
 template<unsigned int object_size, unsigned int n_cpy>
 void copy_grid_fast_shortx_2(const Box<2,size_t> & bx_src,
 		unsigned char * ptr_dst,
@@ -324,6 +470,11 @@ void copy_grid_fast_shortx_2(const Box<2,size_t> & bx_src,
 	}
 }
 
+/*! \brief Select the row copy for a box (any dimension)
+ *
+ * \tparam dim dimensionality
+ *
+ */
 template<unsigned int dim>
 struct copy_ndim_fast_selector
 {
@@ -333,7 +484,7 @@ struct copy_ndim_fast_selector
 			 striding<dim> & sr,
   const Box<dim,size_t> & bx_src)
 	{
-		std::cout << __FILE__ << ":" << __LINE__ << " error, wrong specialization. this case is not handled" << std::endl;
+		copy_grid_fast_rows<dim,object_size>(bx_src,ptr_dst,ptr_src,sr);
 	}
 };
 
@@ -378,7 +529,7 @@ struct copy_ndim_fast_selector<3>
 				break;
 
 		default:
-				copy_grid_fast_longx_3<object_size>(bx_src,ptr_dst,ptr_src,sr);
+				copy_grid_fast_rows<3,object_size>(bx_src,ptr_dst,ptr_src,sr);
 		}
 	}
 };
@@ -424,7 +575,7 @@ struct copy_ndim_fast_selector<2>
 				break;
 
 		default:
-				copy_grid_fast_longx_2<object_size>(bx_src,ptr_dst,ptr_src,sr);
+				copy_grid_fast_rows<2,object_size>(bx_src,ptr_dst,ptr_src,sr);
 		}
 	}
 };
@@ -467,34 +618,26 @@ struct get_striding
 
 		grid_key_dx<dim> zero;
 		zero.zero();
-		grid_key_dx<dim> one = zero;
-		one.set_d(1,1);
 
-		unsigned char * ptr_final_src = get_pointer<dim_prp,prp,grid_type>::get(gd_src,one,id);
 		unsigned char * ptr_start_src = get_pointer<dim_prp,prp,grid_type>::get(gd_src,zero,id);
-
-		unsigned char * ptr_final_dst = get_pointer<dim_prp,prp,grid_type>::get(gd_dst,one,id);
 		unsigned char * ptr_start_dst = get_pointer<dim_prp,prp,grid_type>::get(gd_dst,zero,id);
 
 		sr.n_cpy = bx_src.getHigh(0) - bx_src.getLow(0) + 1;
-		sr.tot_y = bx_src.getHigh(1) - bx_src.getLow(1) + 1;
-
-		sr.striding_src[0] = ptr_final_src - ptr_start_src;
-		sr.striding_dst[0] = ptr_final_dst - ptr_start_dst;
+		sr.tot_y = 1;
 
-		if (dim == 3)
+		for (unsigned int d = 1 ; d < dim ; d++)
 		{
-			grid_key_dx<dim> one2 = zero;
-			one2.set_d(2,1);
+			grid_key_dx<dim> one = zero;
+			one.set_d(d,1);
 
-			unsigned char * ptr_final_src = get_pointer<dim_prp,prp,grid_type>::get(gd_src,one2,id);
-			unsigned char * ptr_start_src = get_pointer<dim_prp,prp,grid_type>::get(gd_src,zero,id);
+			unsigned char * ptr_final_src = get_pointer<dim_prp,prp,grid_type>::get(gd_src,one,id);
+			unsigned char * ptr_final_dst = get_pointer<dim_prp,prp,grid_type>::get(gd_dst,one,id);
 
-			unsigned char * ptr_final_dst = get_pointer<dim_prp,prp,grid_type>::get(gd_dst,one2,id);
-			unsigned char * ptr_start_dst = get_pointer<dim_prp,prp,grid_type>::get(gd_dst,zero,id);
+			sr.striding_src[d-1] = ptr_final_src - ptr_start_src;
+			sr.striding_dst[d-1] = ptr_final_dst - ptr_start_dst;
 
-			sr.striding_src[1] = ptr_final_src - ptr_start_src;
-			sr.striding_dst[1] = ptr_final_dst - ptr_start_dst;
+			if (d == 1)
+			{sr.tot_y = bx_src.getHigh(1) - bx_src.getLow(1) + 1;}
 		}
 
 		return sr;
@@ -633,45 +776,81 @@ struct copy_grid_fast_layout_switch<true,dim,grid,ginfo>
 
 /*! \brief This is a way to quickly copy a grid into another grid
  *
+ * The properties are copied in rows with memcpy (any dimension)
  *
  */
-template<typename grid, typename ginfo>
-struct copy_grid_fast<false,3,grid,ginfo>
+template<unsigned int N, typename grid, typename ginfo>
+struct copy_grid_fast<false,N,grid,ginfo>
 {
 	static void copy(ginfo & gs_src,
 				   ginfo & gs_dst,
-				   const Box<3,size_t> & bx_src,
-				   const Box<3,size_t> & bx_dst,
+				   const Box<N,size_t> & bx_src,
+				   const Box<N,size_t> & bx_dst,
 				   const grid & gd_src,
 				   grid & gd_dst,
-				   grid_key_dx<3> (& cnt)[1] )
+				   grid_key_dx<N> (& cnt)[1] )
 	{
-		copy_grid_fast_layout_switch<is_layout_inte<typename grid::layout_base_>::value,3,grid,ginfo>::copy(gs_src,gs_dst,bx_src,bx_dst,gd_src,gd_dst,cnt);
+		copy_grid_fast_layout_switch<is_layout_inte<typename grid::layout_base_>::value,N,grid,ginfo>::copy(gs_src,gs_dst,bx_src,bx_dst,gd_src,gd_dst,cnt);
 	}
 };
 
-
-
-
-
-/*! \brief This is a way to quickly copy a grid into another grid
+/*! \brief Copy a box of a grid into a box of another grid with multiple threads
  *
+ * The boxes are split in slabs along the outer dimension, every thread copy one slab
+ * with copy_grid_fast. Boxes with less than GRID_COPY_PAR_MIN elements are copied by
+ * the calling thread. The copy is done in rows unless copy_grid_fast_is_complex select
+ * the element by element copy
+ *
+ * \param gs_src source grid information
+ * \param gs_dst destination grid information
+ * \param bx_src source box
+ * \param bx_dst destination box
+ * \param gd_src source grid
+ * \param gd_dst destination grid
  *
  */
-template<typename grid, typename ginfo>
-struct copy_grid_fast<false,2,grid,ginfo>
+template<bool is_complex, unsigned int N, typename grid, typename ginfo>
+void copy_grid_fast_par(ginfo & gs_src,
+						ginfo & gs_dst,
+						const Box<N,size_t> & bx_src,
+						const Box<N,size_t> & bx_dst,
+						const grid & gd_src,
+						grid & gd_dst)
 {
-	static void copy(ginfo & gs_src,
-				   ginfo & gs_dst,
-				   const Box<2,size_t> & bx_src,
-				   const Box<2,size_t> & bx_dst,
-				   const grid & gd_src,
-				   grid & gd_dst,
-				   grid_key_dx<2> (& cnt)[1] )
+	for (size_t i = 0 ; i < N ; i++)
 	{
-		copy_grid_fast_layout_switch<is_layout_inte<typename grid::layout_base_>::value,2,grid,ginfo>::copy(gs_src,gs_dst,bx_src,bx_dst,gd_src,gd_dst,cnt);
+		if (bx_src.getHigh(i) < bx_src.getLow(i))
+		{return;}
 	}
-};
+
+	size_t n_out = bx_src.getHigh(N-1) - bx_src.getLow(N-1) + 1;
+
+	size_t n_slab = 1;
+#ifdef HAVE_OPENMP
+	if (bx_src.getVolumeKey() >= GRID_COPY_PAR_MIN)
+	{n_slab = std::min(n_out,(size_t)omp_get_max_threads());}
+#endif
+
+	#pragma omp parallel for schedule(static) if(n_slab > 1)
+	for (size_t s = 0 ; s < n_slab ; s++)
+	{
+		size_t start = n_out * s / n_slab;
+		size_t stop = n_out * (s+1) / n_slab;
+
+		Box<N,size_t> bs = bx_src;
+		Box<N,size_t> bd = bx_dst;
+
+		bs.setLow(N-1,bx_src.getLow(N-1) + start);
+		bs.setHigh(N-1,bx_src.getLow(N-1) + stop - 1);
+		bd.setLow(N-1,bx_dst.getLow(N-1) + start);
+		bd.setHigh(N-1,bx_dst.getLow(N-1) + stop - 1);
+
+		grid_key_dx<N> cnt[1];
+		cnt[0].zero();
+
+		copy_grid_fast<copy_grid_fast_is_complex<is_complex,grid>::value,N,grid,ginfo>::copy(gs_src,gs_dst,bs,bd,gd_src,gd_dst,cnt);
+	}
+}
 
 //////////////////// Pack grid fast
 
@@ -282,6 +282,287 @@ BOOST_AUTO_TEST_CASE( copy_grid_test_invalid)
 	}
 }
 
+/*! \brief copy_to and resize on grids big enough to be copied by multiple threads
+ *
+ * \tparam grid type of grid with properties <double,float[3]>
+ *
+ */
+template<typename grid>
+void Test_copy_grid_par()
+{
+	size_t sz[3] = {70,66,61};
+
+	grid g_src(sz);
+	grid g_dst(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto & gs = g_src.getGrid();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = gs.LinId(key);
+		g_src.template get<1>(key)[0] = key.get(0);
+		g_src.template get<1>(key)[1] = key.get(1);
+		g_src.template get<1>(key)[2] = key.get(2);
+
+		++it;
+	}
+
+	Box<3,long int> bsrc({1,2,3},{66,62,57});
+	Box<3,long int> bdst({3,1,2},{68,61,56});
+
+	g_dst.copy_to(g_src,bsrc,bdst);
+
+	bool match = true;
+
+	grid_key_dx_iterator_sub<3> its(gs,bsrc.getKP1(),bsrc.getKP2());
+	grid_key_dx_iterator_sub<3> itd(g_dst.getGrid(),bdst.getKP1(),bdst.getKP2());
+
+	while (its.isNext())
+	{
+		auto ks = its.get();
+		auto kd = itd.get();
+
+		match &= g_dst.template get<0>(kd) == g_src.template get<0>(ks);
+		match &= g_dst.template get<1>(kd)[0] == g_src.template get<1>(ks)[0];
+		match &= g_dst.template get<1>(kd)[1] == g_src.template get<1>(ks)[1];
+		match &= g_dst.template get<1>(kd)[2] == g_src.template get<1>(ks)[2];
+
+		++its;
+		++itd;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// resize bigger and smaller, the common part is retained
+
+	size_t sz_b[3] = {80,70,63};
+	size_t sz_s[3] = {50,66,40};
+
+	g_src.resize(sz_b);
+	g_src.resize(sz_s);
+
+	grid_sm<3,void> g_old(sz);
+
+	auto it2 = g_src.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g_src.template get<0>(key) == g_old.LinId(key);
+		match &= g_src.template get<1>(key)[0] == key.get(0);
+		match &= g_src.template get<1>(key)[1] == key.get(1);
+		match &= g_src.template get<1>(key)[2] == key.get(2);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( copy_grid_test_parallel)
+{
+	typedef aggregate<double,float[3]> aggr;
+
+	Test_copy_grid_par<grid_cpu<3,aggr>>();
+	Test_copy_grid_par<grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>>();
+	Test_copy_grid_par<grid_cpu_aosoa<3,aggr>>();
+
+	// not trivially copyable property
+	size_t sz[3] = {48,48,48};
+	size_t sz_b[3] = {50,49,48};
+
+	grid_cpu<3,aggregate<openfpm::vector<double>>> g(sz);
+	g.setMemory();
+
+	auto & gs = g.getGrid();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		for (size_t k = 0 ; k < (size_t)gs.LinId(key) % 3 ; k++)
+		{g.template get<0>(key).add(gs.LinId(key));}
+
+		++it;
+	}
+
+	g.resize(sz_b);
+
+	grid_sm<3,void> g_old(sz);
+
+	bool match = true;
+	grid_key_dx_iterator<3> it2(g_old);
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g.template get<0>(key).size() == (size_t)g_old.LinId(key) % 3;
+
+		for (size_t k = 0 ; k < g.template get<0>(key).size() ; k++)
+		{match &= g.template get<0>(key).get(k) == g_old.LinId(key);}
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Copy a box with copy_to_prp and check the copied properties and the
+ *         destination outside the box
+ *
+ * \tparam grid type of grid with properties <double,float[2],int>
+ * \tparam prp properties to copy
+ *
+ */
+template<typename grid, unsigned int ... prp>
+void Test_copy_grid_rows(const size_t (& sz)[grid::dims],
+						 const Box<grid::dims,size_t> & bsrc,
+						 const Box<grid::dims,size_t> & bdst)
+{
+	const unsigned int dim = grid::dims;
+
+	grid g_src(sz);
+	grid g_dst(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto & gs = g_src.getGrid();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = gs.LinId(key);
+		g_src.template get<1>(key)[0] = 2*gs.LinId(key);
+		g_src.template get<1>(key)[1] = 3*gs.LinId(key);
+		g_src.template get<2>(key) = 5*gs.LinId(key);
+
+		g_dst.template get<0>(key) = -1.0;
+		g_dst.template get<1>(key)[0] = -1.0;
+		g_dst.template get<1>(key)[1] = -1.0;
+		g_dst.template get<2>(key) = -1;
+
+		++it;
+	}
+
+	g_dst.template copy_to_prp<prp...>(g_src,bsrc,bdst);
+
+	bool match = true;
+
+	auto it2 = g_dst.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		if (bdst.isInsideKey(key) == true)
+		{
+			grid_key_dx<dim> key_s;
+			for (size_t i = 0 ; i < dim ; i++)
+			{key_s.set_d(i,key.get(i) - bdst.getLow(i) + bsrc.getLow(i));}
+
+			match &= g_dst.template get<0>(key) == g_src.template get<0>(key_s);
+			match &= g_dst.template get<2>(key) == g_src.template get<2>(key_s);
+		}
+		else
+		{
+			match &= g_dst.template get<0>(key) == -1.0;
+			match &= g_dst.template get<1>(key)[0] == -1.0;
+			match &= g_dst.template get<1>(key)[1] == -1.0;
+			match &= g_dst.template get<2>(key) == -1;
+		}
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( copy_grid_test_rows)
+{
+	typedef aggregate<double,float[2],int> aggr;
+
+	// short and long rows
+	size_t sz1[1] = {100};
+	Box<1,size_t> bs1({3},{90});
+	Box<1,size_t> bd1({7},{94});
+
+	Test_copy_grid_rows<grid_cpu<1,aggr>,0,1,2>(sz1,bs1,bd1);
+	Test_copy_grid_rows<grid_base<1,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>,0,1,2>(sz1,bs1,bd1);
+
+	// full rows, the box is a slab
+	size_t sz2[2] = {40,30};
+	Box<2,size_t> bs2({0,3},{39,20});
+	Box<2,size_t> bd2({0,8},{39,25});
+
+	Test_copy_grid_rows<grid_cpu<2,aggr>,0,1,2>(sz2,bs2,bd2);
+	Test_copy_grid_rows<grid_base<2,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>,0,1,2>(sz2,bs2,bd2);
+
+	// full rows in x and y, not contiguous property list
+	size_t sz3[3] = {20,21,22};
+	Box<3,size_t> bs3({0,0,2},{19,20,10});
+	Box<3,size_t> bd3({0,0,11},{19,20,19});
+
+	Test_copy_grid_rows<grid_cpu<3,aggr>,0,2>(sz3,bs3,bd3);
+	Test_copy_grid_rows<grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>,0,2>(sz3,bs3,bd3);
+
+	// full rows in x only
+	Box<3,size_t> bs3_x({0,1,2},{19,15,10});
+	Box<3,size_t> bd3_x({0,4,11},{19,18,19});
+
+	Test_copy_grid_rows<grid_cpu<3,aggr>,0,1,2>(sz3,bs3_x,bd3_x);
+
+	// 4D with long rows
+	size_t sz4[4] = {17,9,8,7};
+	Box<4,size_t> bs4({1,0,2,1},{15,8,6,5});
+	Box<4,size_t> bd4({0,0,1,2},{14,8,5,6});
+
+	Test_copy_grid_rows<grid_cpu<4,aggr>,0,1,2>(sz4,bs4,bd4);
+	Test_copy_grid_rows<grid_base<4,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>,0,2>(sz4,bs4,bd4);
+}
+
+BOOST_AUTO_TEST_CASE( copy_grid_test_row_nt)
+{
+	openfpm::vector<unsigned char> src;
+	openfpm::vector<unsigned char> dst;
+
+	src.resize(1024);
+	dst.resize(1024);
+
+	for (size_t i = 0 ; i < src.size() ; i++)
+	{src.get(i) = i*7 + 3;}
+
+	bool match = true;
+
+	// all the alignments and the lengths around the 16 and 64 byte blocks
+	for (size_t off_s = 0 ; off_s < 16 ; off_s++)
+	{
+		for (size_t off_d = 0 ; off_d < 16 ; off_d++)
+		{
+			for (size_t n = 0 ; n < 200 ; n += 13)
+			{
+				std::fill(&dst.get(0),&dst.get(0) + dst.size(),0);
+
+				copy_grid_fast_row_nt(&dst.get(0) + off_d,&src.get(0) + off_s,n);
+
+				for (size_t i = 0 ; i < 300 ; i++)
+				{
+					unsigned char exp = (i >= off_d && i < off_d + n)?src.get(i - off_d + off_s):0;
+					match &= dst.get(i) == exp;
+				}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -14,6 +14,8 @@
 #include "util/create_vmpl_sequence.hpp"
 #include "util/cuda_launch.hpp"
 #include "util/object_si_di.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
+#include "Packer_Unpacker/Pack_compress.hpp"
 
 constexpr int DATA_ON_HOST = 32;
 constexpr int DATA_ON_DEVICE = 64;
@@ -342,22 +344,80 @@ struct copy_grid_fast_caller<index_tuple_sq<prp ...>>
 	template<typename grid_type>
 	static void call(grid_type & gd, const grid_type & gs, const Box<grid_type::dims,size_t> & box_src, const Box<grid_type::dims,size_t> & box_dst)
 	{
-        grid_key_dx<grid_type::dims> cnt[1];
-        cnt[0].zero();
-
         typedef typename std::remove_reference<decltype(gd)>::type grid_cp;
         typedef typename std::remove_reference<decltype(gd.getGrid())>::type grid_info_cp;
 
-        typedef typename to_int_sequence<0,grid_type::value_type::max_prop>::type result;
-
-        copy_grid_fast<!is_contiguos<prp...>::type::value || has_pack_gen<typename grid_type::value_type>::value,
+        copy_grid_fast_par<!is_contiguos<prp...>::type::value || has_pack_gen<typename grid_type::value_type>::value,
                                    grid_type::dims,
                                    grid_cp,
-                                   grid_info_cp>::copy(gs.getGrid(),
+                                   grid_info_cp>(gs.getGrid(),
                                    gd.getGrid(),
                                    box_src,
                                    box_dst,
-                                   gs,gd,cnt);
+                                   gs,gd);
+	}
+};
+
+/*! \brief Copy the common part of two grids on host (used by resize)
+ *
+ * Generic linearizer, the elements are copied one by one
+ *
+ */
+template<bool is_grid_sm>
+struct resize_impl_host_copy
+{
+	template<typename grid_type>
+	static void copy(grid_type & grid_new, const grid_type & grid_old, const size_t (& sz_c)[grid_type::dims])
+	{
+		grid_sm<grid_type::dims,void> g1_c(sz_c);
+
+		//! create a source grid iterator
+		grid_key_dx_iterator<grid_type::dims> it(g1_c);
+
+		while(it.isNext())
+		{
+			// get the grid key
+			grid_key_dx<grid_type::dims> key = it.get();
+
+			// create a copy element
+
+			grid_new.get_o(key) = grid_old.get_o(key);
+
+			++it;
+		}
+	}
+};
+
+/*! \brief Copy the common part of two grids on host (used by resize)
+ *
+ * grid_sm linearizer, the copy is a box copy with copy_grid_fast split across threads,
+ * properties that are not trivially copyable are copied element by element
+ *
+ */
+template<>
+struct resize_impl_host_copy<true>
+{
+	template<typename grid_type>
+	static void copy(grid_type & grid_new, const grid_type & grid_old, const size_t (& sz_c)[grid_type::dims])
+	{
+		Box<grid_type::dims,size_t> bx;
+
+		for (size_t i = 0 ; i < grid_type::dims ; i++)
+		{
+			if (sz_c[i] == 0)
+			{return;}
+
+			bx.setLow(i,0);
+			bx.setHigh(i,sz_c[i]-1);
+		}
+
+		typedef typename std::remove_reference<decltype(grid_new.getGrid())>::type grid_info_cp;
+		typedef typename grid_type::value_type T;
+
+		copy_grid_fast_par<has_pack_gen<T>::value || !is_trivially_copyable_prp<T>::value,
+						   grid_type::dims,
+						   grid_type,
+						   grid_info_cp>(grid_old.getGrid(),grid_new.getGrid(),bx,bx,grid_old,grid_new);
 	}
 };
 
@@ -590,22 +650,7 @@ private:
 		for (size_t i = 0 ; i < dim ; i++)
 		{sz_c[i] = (g1.size(i) < sz[i])?g1.size(i):sz[i];}
 
-		grid_sm<dim,void> g1_c(sz_c);
-
-		//! create a source grid iterator
-		grid_key_dx_iterator<dim> it(g1_c);
-
-		while(it.isNext())
-		{
-			// get the grid key
-			grid_key_dx<dim> key = it.get();
-
-			// create a copy element
-
-			grid_new.get_o(key) = this->get_o(key);
-
-			++it;
-		}
+		resize_impl_host_copy<std::is_same<ord_type,grid_sm<dim,void>>::value>::copy(grid_new,*this,sz_c);
 	}
 
 	void resize_impl_memset(grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new)
@@ -1333,20 +1378,17 @@ public:
 			     const Box<dim,size_t> & box_src,
 				 const Box<dim,size_t> & box_dst)
 	{
-        typedef typename std::remove_reference<decltype(grid_src)>::type grid_cp;
+        typedef typename std::remove_const<typename std::remove_reference<decltype(grid_src)>::type>::type grid_cp;
         typedef typename std::remove_reference<decltype(grid_src.getGrid())>::type grid_info_cp;
 
-        grid_key_dx<dim> cnt[1];
-        cnt[0].zero();
-
-        copy_grid_fast<!is_contiguos<prp...>::type::value || has_pack_gen<T>::value,
+        copy_grid_fast_par<!is_contiguos<prp...>::type::value || has_pack_gen<T>::value,
                                    dim,
                                    grid_cp,
-                                   grid_info_cp>::copy(grid_src.getGrid(),
+                                   grid_info_cp>(grid_src.getGrid(),
                                    this->getGrid(),
                                    box_src,
                                    box_dst,
-                                   grid_src,*this,cnt);
+                                   grid_src,*this);
 	}
 
 	/*! \brief It does nothing
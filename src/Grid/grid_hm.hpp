@@ -0,0 +1,212 @@
+/*
+ * grid_hm.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef GRID_HM_HPP_
+#define GRID_HM_HPP_
+
+#include "util/hilbert.hpp"
+
+/*! \brief class that store the information of the grid like number of point on each direction and
+ *  define the index linearization following an Hilbert curve
+ *
+ * The points are stored along the Hilbert curve of the smallest order m that cover
+ * the grid, so the memory is allocated for 2^m x 2^m ... points (size()). Compared to
+ * grid_sm and grid_zm, neighborhood points are closer in memory on average, but every
+ * access must compute the Hilbert key, that cost much more than the few multiply-add
+ * of grid_sm. A stencil that access the points through LinId is for this reason
+ * slower than on grid_sm (around 6x for a 3D Laplacian), the curve pay off only when
+ * the memory traffic dominate or the points are traversed in Hilbert order
+ *
+ * ### Usage
+ * \snippet grid_unit_tests.hpp Hilbert linearized grid
+ *
+ * \param N dimensionality
+ * \param T type of object is going to store the grid
+ *
+ */
+template<unsigned int N, typename T>
+class grid_hm : private grid_sm<N,T>
+{
+	//! order of the Hilbert curve
+	unsigned int m = 0;
+
+public:
+
+
+	/*! \brief Reset the dimension of the grid
+	 *
+	 * \param dims store on each dimension the size of the grid
+	 *
+	 */
+	inline void setDimensions(const size_t  (& dims)[N])
+	{
+		((grid_sm<N,T> *)this)->setDimensions(dims);
+		m = hilbert_order(dims);
+	}
+
+	grid_hm(){};
+
+	/*! \brief construct a grid from another grid
+	 *
+	 * \param g grid info
+	 *
+	 * construct a grid from another grid, type can be different
+	 *
+	 */
+
+	template<typename S> inline grid_hm(const grid_hm<N,S> & g)
+	{
+		this->setDimensions(g.getSize());
+	}
+
+	/*! \brief Construct a grid of a specified size
+	 *
+	 * Construct a grid of a specified size
+	 *
+	 * \param sz is an array that contain the size of the grid on each dimension
+	 *
+	 */
+
+	inline grid_hm(const size_t (& sz)[N])
+	{
+		this->setDimensions(sz);
+	}
+
+	//! Destructor
+	~grid_hm() {};
+
+	/*! \brief Linearization of the grid_key_dx
+	 *
+	 * Linearization of the grid_key_dx given a key, it spit out a number that is the position
+	 * of the key along the Hilbert curve
+	 *
+	 * \param gk grid key to access the element of the grid
+	 *
+	 */
+	template<typename ids_type> inline mem_id LinId(const grid_key_dx<N,ids_type> & gk) const
+	{
+		return lin_hid(gk,m);
+	}
+
+	/*! \brief Inverse of LinId
+	 *
+	 * \param id position along the Hilbert curve
+	 *
+	 * \return the grid key
+	 *
+	 */
+	inline grid_key_dx<N> InvLinId(mem_id id) const
+	{
+		grid_key_dx<N> gk;
+		invlin_hid(id,gk,m);
+
+		return gk;
+	}
+
+	/*! \brief Copy the grid from another grid
+	 *
+	 * \param g grid from witch to copy
+	 *
+	 */
+
+	inline grid_hm<N,T> & operator=(const grid_hm<N,T> & g)
+	{
+		((grid_sm<N,T> *)this)->operator=(g);
+		m = g.m;
+
+		return *this;
+	}
+
+	/*! \brief Check if the two grid_sm are the same
+	 *
+	 * \param g element to check
+	 *
+	 * \return true if they are the same
+	 *
+	 */
+
+	inline bool operator==(const grid_hm<N,T> & g)
+	{
+		return ((grid_sm<N,T> *)this)->operator==(g);
+	}
+
+	/*! \brief Check if the two grid_sm are the same
+	 *
+	 * \param g element to check
+	 *
+	 */
+
+	inline bool operator!=(const grid_hm<N,T> & g)
+	{
+		return ((grid_sm<N,T> *)this)->operator!=(g);
+	}
+
+	/*! \brief swap the grid_sm informations
+	 *
+	 * \param g grid to swap
+	 *
+	 */
+	inline void swap(grid_hm<N,T> & g)
+	{
+		((grid_sm<N,T> *)this)->swap(g);
+		std::swap(m,g.m);
+	}
+
+	/*! \brief Return the size of the grid as an array
+	 *
+	 * \return get the size of the grid as an array
+	 *
+	 */
+	inline const size_t (& getSize() const)[N]
+	{
+		return ((grid_sm<N,T> *)this)->getSize();
+	}
+
+	/*! \brief Return the order of the Hilbert curve
+	 *
+	 * \return the order m of the curve
+	 *
+	 */
+	inline unsigned int getOrder() const
+	{
+		return m;
+	}
+
+	/**
+	 *
+	 * Get the size of the grid on the direction i
+	 *
+	 * \param i direction
+	 * \return the size on the direction i
+	 *
+	 */
+	inline size_t size(unsigned int i) const
+	{
+		return ((grid_sm<N,T> *)this)->size(i);
+	}
+
+	/**
+	 *
+	 * Get the number of points of the Hilbert curve, the grid allocate this number of elements
+	 *
+	 * \return 2^(m*N), or 0 if the grid is empty
+	 *
+	 */
+	inline size_t size() const
+	{
+		if (((grid_sm<N,T> *)this)->size() == 0)
+		{return 0;}
+
+		return (size_t)1 << (m*N);
+	}
+
+	//!  It simply mean that all the classes grid are friend of all its specialization
+	template <unsigned int,typename> friend class grid_hm;
+};
+
+
+#endif /* GRID_HM_HPP_ */
@@ -355,6 +355,184 @@ struct unpack_simple_cond<true, prp ...>
 		}
 	}
 	
+	/*! \brief Insert an allocation request for a compressed pack of the grid
+	 *
+	 * The request is an upper bound, the compressed pack can use less memory
+	 *
+	 * \tparam prp properties to pack (all if empty)
+	 *
+	 * \param req request
+	 *
+	 */
+	template<int ... prp> void packRequestCompressed(size_t & req) const
+	{
+		req += dim*sizeof(size_t);
+
+		pack_compress_request_prp<T> pr(this->size(),req);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(pr);
+	}
+
+	/*! \brief Pack the grid in a compressed format
+	 *
+	 * After the sizes of the grid every property is stored as a block (one component after the
+	 * other for array properties) that can be byte-shuffled and compressed (see pack_compress_block).
+	 * Use unpackCompressed to unpack
+	 *
+	 * \tparam prp properties to pack (all if empty)
+	 *
+	 * \param mem preallocated memory where to pack the grid (see packRequestCompressed)
+	 * \param sts pack-stat info
+	 * \param opt PACK_COMPRESS_NONE or PACK_COMPRESS_SHUFFLE_LZ
+	 *
+	 */
+	template<int ... prp> void packCompressed(ExtPreAlloc<S> & mem, Pack_stat & sts, int opt = PACK_COMPRESS_SHUFFLE_LZ) const
+	{
+		static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be packed compressed");
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{Packer<size_t, S>::pack(mem,this->getGrid().size(i),sts);}
+
+		pack_compress_grid_prp<grid_base_impl<dim,T,S,layout_base,ord_type>,S> pp(*this,mem,opt,sts);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(pp);
+	}
+
+	/*! \brief Unpack a grid packed with packCompressed
+	 *
+	 * \tparam prp properties to unpack (all if empty)
+	 *
+	 * \param mem preallocated memory from where to unpack the grid
+	 * \param ps unpack-stat info
+	 *
+	 * \return false if the blocks do not match the grid or are corrupted, in this case the
+	 *         content of the grid is not valid
+	 *
+	 */
+	template<int ... prp> bool unpackCompressed(ExtPreAlloc<S> & mem, Unpack_stat & ps)
+	{
+		size_t dims[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{Unpacker<size_t, S>::unpack(mem,dims[i],ps);}
+
+		bool same = is_mem_init;
+		for (size_t i = 0 ; i < dim ; i++)
+		{same &= (this->getGrid().size(i) == dims[i]);}
+
+		if (same == false)
+		{this->resize(dims);}
+
+		unpack_compress_grid_prp<grid_base_impl<dim,T,S,layout_base,ord_type>,S> up(*this,mem,ps);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(up);
+
+		return up.ok;
+	}
+
+	/*! \brief Pack the grid as a list of segments without copying the data
+	 *
+	 * A header segment with the sizes of the grid is appended to segs, followed by one segment for
+	 * each selected property (one for each component of array properties) that point directly to the
+	 * data of the grid. With memory_traits_lin the grid is a single segment and all the properties
+	 * must be selected. The segments are valid until the grid is modified
+	 *
+	 * \tparam prp properties to pack (all if empty)
+	 *
+	 * \param segs list where the segments are appended
+	 *
+	 */
+	template<int ... prp> void packSegments(Pack_segments & segs) const
+	{
+		static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be packed in segments");
+
+		size_t sz[dim];
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = this->getGrid().size(i);}
+
+		segs.addHeader(sz,dim);
+
+		pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::add(*this,segs,this->size(),this->size());
+	}
+
+	/*! \brief Resize the grid and append the segments where the packed data must be placed
+	 *
+	 * It is the receiving side of packSegments, the data segments of a packed grid (header excluded)
+	 * can be received directly into the returned segments
+	 *
+	 * \tparam prp properties to unpack (all if empty)
+	 *
+	 * \param sz sizes of the grid (from the header)
+	 * \param segs list where the destination segments are appended
+	 *
+	 */
+	template<int ... prp> void placeSegments(const size_t (& sz)[dim], Pack_segments & segs)
+	{
+		static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be unpacked from segments");
+
+		bool same = is_mem_init;
+		for (size_t i = 0 ; i < dim ; i++)
+		{same &= (this->getGrid().size(i) == sz[i]);}
+
+		// resize copy the old content, it is not needed when the grid has already the right size
+		if (same == false)
+		{this->resize(sz);}
+
+		pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::add(*this,segs,this->size(),this->size());
+	}
+
+	/*! \brief Check that a list of segments contains a grid packed with packSegments
+	 *
+	 * \tparam prp properties (all if empty)
+	 *
+	 * \param segs segments
+	 * \param id segment where the grid start (its header)
+	 *
+	 * \return false if the segments do not match the grid
+	 *
+	 */
+	template<int ... prp> static bool checkSegments(const Pack_segments & segs, size_t id)
+	{
+		const size_t * hdr = pack_segments_header(segs,id,dim);
+		if (hdr == NULL)
+		{return false;}
+
+		size_t n = 1;
+		for (size_t i = 0 ; i < dim ; i++)
+		{n *= hdr[i];}
+
+		Pack_segments exp;
+		pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::expected(exp,n);
+
+		return pack_segments_check(segs,id+1,exp);
+	}
+
+	/*! \brief Unpack a grid from a list of segments produced by packSegments
+	 *
+	 * \tparam prp properties to unpack (all if empty)
+	 *
+	 * \param segs segments
+	 * \param id segment where the grid start (its header), at the end the segment after the grid
+	 *
+	 * \return false if the segments do not match the grid, in this case the grid is not modified
+	 *
+	 */
+	template<int ... prp> bool unpackSegments(const Pack_segments & segs, size_t & id)
+	{
+		if (checkSegments<prp...>(segs,id) == false)
+		{return false;}
+
+		size_t sz[dim];
+		const size_t * hdr = (const size_t *)segs.getPointer(id);
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = hdr[i];}
+
+		id++;
+
+		Pack_segments dst;
+		placeSegments<prp...>(sz,dst);
+
+		return pack_segments_copy(segs,id,dst);
+	}
+
 	/*! \brief Pack finalize Finalize the pack of this object. In this case it does nothing
 	 *
 	 * \tparam prp properties to pack
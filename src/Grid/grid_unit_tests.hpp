@@ -594,6 +594,197 @@ BOOST_AUTO_TEST_CASE( grid_use_zmb)
 	std::cout << "Grid unit test end" << "\n";
 }
 
+/*! \brief Check that an Hilbert curve of order m pass once through every cell moving to a neighborhood cell at every step
+ *
+ * \tparam dim dimensionality
+ *
+ * \param m order of the curve
+ *
+ */
+template<unsigned int dim> void hilbert_check_curve(unsigned int m)
+{
+	bool match = true;
+
+	grid_key_dx<dim> prev;
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{prev.set_d(i,0);}
+
+	for (size_t h = 0 ; h < (size_t)1 << (m*dim) ; h++)
+	{
+		grid_key_dx<dim> k;
+		invlin_hid(h,k,m);
+
+		match &= lin_hid(k,m) == h;
+
+		size_t dist = 0;
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{
+			match &= k.get(i) >= 0 && k.get(i) < (1 << m);
+			dist += std::abs(k.get(i) - prev.get(i));
+		}
+
+		match &= (h == 0)?(dist == 0):(dist == 1);
+
+		prev = k;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( hilbert_key_test )
+{
+	for (unsigned int m = 0 ; m <= 6 ; m++)
+	{
+		hilbert_check_curve<1>(m);
+		hilbert_check_curve<2>(m);
+		hilbert_check_curve<3>(m);
+		hilbert_check_curve<4>(m/2);
+		hilbert_check_curve<5>(m/2);
+	}
+
+	// large keys
+	grid_key_dx<3> k({1048575,3,524288});
+	grid_key_dx<3> k2;
+
+	invlin_hid(lin_hid(k,20),k2,20);
+	BOOST_REQUIRE(k == k2);
+
+	// batch
+	openfpm::vector<grid_key_dx<3>> keys;
+	openfpm::vector<size_t> lin;
+	openfpm::vector<grid_key_dx<3>> keys2;
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		grid_key_dx<3> kb({(long int)(i % 17),(long int)((i*7) % 31),(long int)((i*13) % 63)});
+		keys.add(kb);
+	}
+
+	lin_hid_batch(keys,lin,6);
+	invlin_hid_batch(lin,keys2,6);
+
+	BOOST_REQUIRE_EQUAL(lin.size(),keys.size());
+	BOOST_REQUIRE_EQUAL(keys2.size(),keys.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{
+		match &= lin.get(i) == lin_hid(keys.get(i),6);
+		match &= keys2.get(i) == keys.get(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Check that the table-driven Hilbert keys match the generic Skilling transform on every key
+ *
+ * \tparam dim dimensionality
+ *
+ * \param m order of the curve
+ *
+ */
+template<unsigned int dim> void hilbert_check_table(unsigned int m)
+{
+	bool match = true;
+
+	for (size_t h = 0 ; h < (size_t)1 << (m*dim) ; h++)
+	{
+		grid_key_dx<dim> k;
+		grid_key_dx<dim> k2;
+
+		invlin_hid(h,k,m);
+		invlin_hid_skilling(h,k2,m);
+
+		match &= k == k2;
+		match &= lin_hid(k,m) == lin_hid_skilling(k,m);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( hilbert_table_test )
+{
+	for (unsigned int m = 0 ; m <= 7 ; m++)
+	{
+		hilbert_check_table<2>(m);
+		hilbert_check_table<3>(m-m/3);
+	}
+
+	// large keys
+	bool match = true;
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		grid_key_dx<3> k({(long int)((i*104729) % 1048576),(long int)((i*7919) % 1048576),(long int)((i*15485863) % 1048576)});
+		match &= lin_hid(k,20) == lin_hid_skilling(k,20);
+
+		grid_key_dx<2> k2({(long int)((i*104729) % 4294967296),(long int)((i*15485863) % 4294967296)});
+		match &= lin_hid(k2,32) == lin_hid_skilling(k2,32);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( grid_use_hm)
+{
+	/*  tests:
+	 *
+	 * - Hilbert linearized grid
+	 *
+	 */
+
+	size_t sz[3] = {GS_SIZE,GS_SIZE,GS_SIZE};
+
+	for (int i = 4 ; i <= GS_SIZE ; i*=2)
+	{
+		grid_cpu<3, Point_test<float>, grid_hm<3,void> > c3(sz);
+		c3.setMemory();
+		test_layout_grid3d(c3,i);
+	}
+
+	//! [Hilbert linearized grid]
+
+	// the data are stored along an Hilbert curve of order 3 covering 8x8x8 points
+	size_t sz2[3] = {5,7,3};
+	grid_cpu<3, aggregate<long int[3]>, grid_hm<3,void> > g(sz2);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		for (size_t i = 0 ; i < 3 ; i++)
+		{g.template get<0>(key)[i] = key.get(i);}
+
+		++it;
+	}
+
+	//! [Hilbert linearized grid]
+
+	BOOST_REQUIRE_EQUAL(g.getGrid().getOrder(),3ul);
+	BOOST_REQUIRE_EQUAL(g.getGrid().size(),512ul);
+
+	bool match = true;
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		for (size_t i = 0 ; i < 3 ; i++)
+		{match &= g.template get<0>(key)[i] == key.get(i);}
+
+		match &= g.getGrid().InvLinId(g.getGrid().LinId(key)) == key;
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+
 /* \brief This is an ordinary test simple 3D with plain C array
  *
  * This is an ordinary test simple 3D with plain C array
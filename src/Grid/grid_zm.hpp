@@ -91,6 +91,21 @@ public:
 		return lin_zid(gk);
 	}
 
+	/*! \brief Inverse of LinId
+	 *
+	 * \param id Morton key
+	 *
+	 * \return the grid key
+	 *
+	 */
+	__device__ __host__ inline grid_key_dx<N> InvLinId(mem_id id) const
+	{
+		grid_key_dx<N> gk;
+		invlin_zid(id,gk);
+
+		return gk;
+	}
+
 
 	/*! \brief Copy the grid from another grid
 	 *
@@ -34,6 +34,7 @@
 #endif
 #include "grid_sm.hpp"
 #include "grid_zm.hpp"
+#include "grid_hm.hpp"
 #include "memory_ly/Encap.hpp"
 #include "memory_ly/memory_array.hpp"
 #include "memory_ly/memory_c.hpp"
@@ -366,6 +367,211 @@ public:
 
 
 
+/*! \brief This is an N-dimensional grid or an N-dimensional array with memory_traits_aosoa layout
+ *
+ * The elements are stored in tiles of W elements, inside a tile each property is an array
+ * of W values (see memory_aosoa)
+ *
+ * \tparam dim Dimensionality of the grid
+ * \tparam T type of object the grid store
+ * \tparam S type of memory HeapMemory CudaMemory
+ * \tparam W number of elements in a tile
+ *
+ */
+template<unsigned int dim, typename T, typename S, unsigned int W, typename linearizer>
+class grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> : public grid_base_impl<dim,T,S,memory_traits_aosoa<W>::template layout,linearizer>
+{
+	//! base implementation
+	typedef grid_base_impl<dim,T,S,memory_traits_aosoa<W>::template layout,linearizer> base_impl;
+
+	T background;
+
+public:
+
+	//! type of layout of the structure
+	typedef memory_aosoa<T,W> layout;
+
+	//! Object container for T, it is the return type of get_o it return a object type trough
+	// you can access all the properties of T
+	typedef typename base_impl::container container;
+
+	//! grid_base has no grow policy
+	typedef void grow_policy;
+
+	//! type that identify one point in the grid
+	typedef grid_key_dx<dim> base_key;
+
+	//! sub-grid iterator type
+	typedef grid_key_dx_iterator_sub<dim> sub_grid_iterator_type;
+
+	//! linearizer type Z-morton Hilbert curve , normal striding
+	typedef typename base_impl::linearizer_type linearizer_type;
+
+	//! Default constructor
+	inline grid_base() THROW
+	:base_impl()
+	{}
+
+	/*! \brief create a grid from another grid
+	 *
+	 * \param g the grid to copy
+	 *
+	 */
+	inline grid_base(const grid_base & g) THROW
+	:base_impl(g)
+	{
+	}
+
+	/*! \brief create a grid of size sz on each direction
+	 *
+	 * \param sz size if the grid on each directions
+	 *
+	 */
+	inline grid_base(const size_t & sz) THROW
+	:base_impl(sz)
+	{
+	}
+
+	/*! \brief Constructor allocate memory
+	 *
+	 * \param sz size of the grid in each dimension
+	 *
+	 */
+	inline grid_base(const size_t (& sz)[dim]) THROW
+	:base_impl(sz)
+	{
+	}
+
+	/*! \brief It copy a grid
+	 *
+	 * \param g grid to copy
+	 *
+	 */
+	grid_base & operator=(const grid_base & g)
+	{
+		(static_cast<base_impl *>(this))->swap(g.duplicate());
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
+	/*! \brief It copy a grid
+	 *
+	 * \param g grid to copy
+	 *
+	 */
+	grid_base & operator=(grid_base && g)
+	{
+		(static_cast<base_impl *>(this))->swap(g);
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
+	/*! \brief It return the tiles buffer
+	 *
+	 * In case of Cuda memory it return the device pointer to pass to the kernels
+	 *
+	 */
+	template<unsigned int id> void * getDeviceBuffer()
+	{
+		return ((S*)this->data_.mem)->getDevicePointer();
+	}
+
+	/*! \brief This is a meta-function return which type of sub iterator a grid produce
+	 *
+	 * \return the type of the sub-grid iterator
+	 *
+	 */
+	template <typename stencil = no_stencil>
+	static grid_key_dx_iterator_sub<dim, stencil> type_of_subiterator()
+	{
+		return grid_key_dx_iterator_sub<dim, stencil>();
+	}
+
+	/*! \brief Return if in this representation data are stored is a compressed way
+	 *
+	 * \return false this is a normal grid no compression
+	 *
+	 */
+	static constexpr bool isCompressed()
+	{
+		return false;
+	}
+
+	/*! \brief This is a meta-function return which type of iterator a grid produce
+	 *
+	 * \return the type of the sub-grid iterator
+	 *
+	 */
+	static grid_key_dx_iterator<dim> type_of_iterator()
+	{
+		return grid_key_dx_iterator<dim>();
+	}
+
+	/*! \brief In this case it just copy the key_in in key_out
+	 *
+	 * \param key_out output key
+	 * \param key_in input key
+	 *
+	 */
+	void convert_key(grid_key_dx<dim> & key_out, const grid_key_dx<dim> & key_in) const
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{key_out.set_d(i,key_in.get(i));}
+	}
+
+	/*! \brief Get the background value
+	 *
+	 * For dense grid this function is useless
+	 *
+	 * \return background value
+	 *
+	 */
+	T & getBackgroundValue()
+	{
+		return background;
+	}
+
+	/*! \brief Get the background value
+	 *
+	 * For dense grid this function is useless
+	 *
+	 * \return background value
+	 *
+	 */
+	T & getBackgroundValueAggr()
+	{
+		return background;
+	}
+
+	/*! \brief assign operator
+	 *
+	 * \return itself
+	 *
+	 */
+	grid_base & operator=(const base_impl & base)
+	{
+		base_impl::operator=(base);
+
+		return *this;
+	}
+
+	/*! \brief assign operator
+	 *
+	 * \return itself
+	 *
+	 */
+	grid_base & operator=(base_impl && base)
+	{
+		base_impl::operator=((base_impl &&)base);
+
+		return *this;
+	}
+};
+
 /*! \brief this class is a functor for "for_each" algorithm
  *
  * This class is a functor for "for_each" algorithm. For each
@@ -690,6 +896,9 @@ template <unsigned int dim, typename T, typename linearizer = grid_sm<dim,void>
 //! short formula for a grid on gpu
 template <unsigned int dim, typename T, typename linearizer = grid_sm<dim,void> > using grid_cpu = grid_base<dim,T,HeapMemory,typename memory_traits_lin<T>::type,linearizer>;
 
+//! short formula for a grid on cpu with AoSoA layout and tiles of W elements
+template <unsigned int dim, typename T, unsigned int W = 8, typename linearizer = grid_sm<dim,void> > using grid_cpu_aosoa = grid_base<dim,T,HeapMemory,memory_aosoa<T,W>,linearizer>;
+
 
 #endif
 
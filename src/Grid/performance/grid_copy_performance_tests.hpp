@@ -0,0 +1,275 @@
+/*
+ * grid_copy_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_COPY_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_COPY_PERFORMANCE_TESTS_HPP_
+
+#include "Grid/map_grid.hpp"
+#include "Vector/map_vector.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Bandwidth of a STREAM-like copy a[i] = b[i] on n doubles
+ *
+ * \param n number of doubles
+ * \param mean output mean bandwidth in GB/s (read + write)
+ * \param dev output standard deviation of the time
+ *
+ */
+static inline void grid_copy_performance_stream(size_t n, double & mean, double & dev)
+{
+	openfpm::vector<double> a;
+	openfpm::vector<double> b;
+	a.resize(n);
+	b.resize(n);
+
+	double * pa = &a.get(0);
+	double * pb = &b.get(0);
+
+	#pragma omp parallel for schedule(static)
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		pa[i] = 0.0;
+		pb[i] = i;
+	}
+
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n ; i++)
+		{pa[i] = pb[i];}
+
+		t.stop();
+		times.add(t.getwct());
+	}
+
+	standard_deviation(times,mean,dev);
+	mean = 2.0 * n * sizeof(double) / mean / 1e9;
+}
+
+/*! \brief Bandwidth of copy_to and resize on a grid
+ *
+ * \tparam grid type of the grid
+ *
+ * \param name name of the layout
+ * \param sz_d size of the grid in each direction
+ * \param stream bandwidth of the STREAM-like copy
+ *
+ */
+template<typename grid>
+void grid_copy_performance_layout(const char * name, size_t sz_d, double stream)
+{
+	typedef typename grid::value_type T;
+
+	size_t sz[3] = {sz_d,sz_d,sz_d};
+	size_t sz_r[3] = {sz_d+2,sz_d+2,sz_d+2};
+
+	grid g_src(sz);
+	grid g_dst(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = key.get(0);
+		g_dst.template get<0>(key) = 0.0;
+
+		++it;
+	}
+
+	// copy the whole grid but one layer of ghost
+	Box<3,long int> box({1,1,1},{(long int)sz_d-2,(long int)sz_d-2,(long int)sz_d-2});
+
+	double bytes_copy = 2.0 * box.getVolumeKey() * sizeof(T);
+	double bytes_resize = 2.0 * sz_d * sz_d * sz_d * sizeof(T);
+
+	openfpm::vector<double> times_c;
+	openfpm::vector<double> times_r;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		g_dst.copy_to(g_src,box,box);
+
+		t.stop();
+		times_c.add(t.getwct());
+
+		grid g_rs;
+		g_rs.swap(g_src.duplicate());
+
+		timer t2;
+		t2.start();
+
+		g_rs.resize(sz_r);
+
+		t2.stop();
+		times_r.add(t2.getwct());
+	}
+
+	double mean_c, dev_c, mean_r, dev_r;
+	standard_deviation(times_c,mean_c,dev_c);
+	standard_deviation(times_r,mean_r,dev_r);
+
+	std::cout << "    " << name << "  copy_to: " << bytes_copy / mean_c / 1e9 << " GB/s (" << 100.0 * bytes_copy / mean_c / 1e9 / stream << "% of STREAM, dev "
+	          << dev_c << " s)  resize: " << bytes_resize / mean_r / 1e9 << " GB/s (" << 100.0 * bytes_resize / mean_r / 1e9 / stream << "% of STREAM, dev "
+	          << dev_r << " s)" << std::endl;
+
+	BOOST_REQUIRE_EQUAL(g_dst.template get<0>(grid_key_dx<3>({(long int)sz_d-2,1,1})),sz_d-2);
+}
+
+/*! \brief Time a box copy
+ *
+ * \param f function that does the copy
+ * \param bytes bytes read and written by the copy
+ *
+ * \return bandwidth in GB/s
+ *
+ */
+template<typename copy_func>
+double grid_copy_performance_time(copy_func f, double bytes)
+{
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		f();
+
+		t.stop();
+		times.add(t.getwct());
+	}
+
+	double mean, dev;
+	standard_deviation(times,mean,dev);
+
+	return bytes / mean / 1e9;
+}
+
+/*! \brief Bandwidth of the element by element copy and of the row copy of copy_grid_fast
+ *
+ * \tparam grid type of the grid
+ *
+ * \param name name of the layout
+ * \param sz_d size of the grid in each direction
+ *
+ */
+template<typename grid>
+void grid_copy_performance_rows_layout(const char * name, size_t sz_d)
+{
+	typedef typename grid::value_type T;
+	typedef typename std::remove_reference<decltype(std::declval<grid>().getGrid())>::type ginfo;
+
+	size_t sz[3] = {sz_d,sz_d,sz_d};
+
+	grid g_src(sz);
+	grid g_dst(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = key.get(0);
+		g_dst.template get<0>(key) = 0.0;
+
+		++it;
+	}
+
+	// interior box (rows in x) and slab (full planes)
+	Box<3,size_t> box({1,1,1},{sz_d-2,sz_d-2,sz_d-2});
+	Box<3,size_t> slab({0,0,1},{sz_d-1,sz_d-1,sz_d-2});
+
+	double bytes_box = 2.0 * box.getVolumeKey() * sizeof(T);
+	double bytes_slab = 2.0 * slab.getVolumeKey() * sizeof(T);
+
+	auto & gs = g_src.getGrid();
+	auto & gd = g_dst.getGrid();
+
+	auto elem = [&](Box<3,size_t> & b)
+	{
+		grid_key_dx<3> cnt[1];
+		cnt[0].zero();
+
+		copy_grid_fast<true,3,grid,ginfo>::copy(gs,gd,b,b,g_src,g_dst,cnt);
+	};
+
+	double bw_elem_box = grid_copy_performance_time([&](){elem(box);},bytes_box);
+	double bw_rows_box = grid_copy_performance_time([&](){g_dst.template copy_to_prp<0,2>(g_src,box,box);},bytes_box);
+	double bw_elem_slab = grid_copy_performance_time([&](){elem(slab);},bytes_slab);
+	double bw_rows_slab = grid_copy_performance_time([&](){g_dst.template copy_to_prp<0,2>(g_src,slab,slab);},bytes_slab);
+
+	std::cout << "    " << name << "  box: element " << bw_elem_box << " GB/s, rows " << bw_rows_box << " GB/s (speedup " << bw_rows_box / bw_elem_box << ")"
+	          << "  slab: element " << bw_elem_slab << " GB/s, rows " << bw_rows_slab << " GB/s (speedup " << bw_rows_slab / bw_elem_slab << ")" << std::endl;
+
+	BOOST_REQUIRE_EQUAL(g_dst.template get<0>(grid_key_dx<3>({(long int)sz_d-2,1,1})),sz_d-2);
+}
+
+BOOST_AUTO_TEST_SUITE( grid_copy_performance )
+
+BOOST_AUTO_TEST_CASE(grid_copy_performance_rows)
+{
+	typedef aggregate<double,double[3],int> aggr;
+
+	size_t sz_d = 192;
+
+	std::cout << "Grid copy " << sz_d << "^3 aggregate<double,double[3],int> copy_to_prp<0,2>" << std::endl;
+
+	grid_copy_performance_rows_layout<grid_cpu<3,aggr>>("AoS (memory_traits_lin) ",sz_d);
+	grid_copy_performance_rows_layout<grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>>("SoA (memory_traits_inte)",sz_d);
+}
+
+BOOST_AUTO_TEST_CASE(grid_copy_performance_bandwidth)
+{
+	typedef aggregate<double,double[3]> aggr;
+
+	size_t sz_d = 256;
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	// 1,2,4 ... threads, the last one is always max_threads
+	for (size_t nt = 1 ; nt <= max_threads ; nt = (nt < max_threads && 2*nt > max_threads)?max_threads:2*nt)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		double stream, stream_dev;
+		grid_copy_performance_stream(sz_d*sz_d*sz_d*4,stream,stream_dev);
+
+		std::cout << "Grid copy " << sz_d << "^3 aggregate<double,double[3]>, threads: " << nt << "  STREAM copy: " << stream << " GB/s" << std::endl;
+
+		grid_copy_performance_layout<grid_cpu<3,aggr>>("AoS (memory_traits_lin) ",sz_d,stream);
+		grid_copy_performance_layout<grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type>>("SoA (memory_traits_inte)",sz_d,stream);
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_COPY_PERFORMANCE_TESTS_HPP_ */
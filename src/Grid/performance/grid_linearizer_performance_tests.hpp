@@ -0,0 +1,110 @@
+/*
+ * grid_linearizer_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_LINEARIZER_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_LINEARIZER_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+#include "util/stat/common_statistics.hpp"
+
+/*! \brief Time a 7-point laplacian on a 3D grid with a given linearizer
+ *
+ * The points are visited in the order they are stored in memory, so the stencil
+ * access the neighborhood points along the space filling curve of the linearizer
+ *
+ * \tparam linearizer grid_sm, grid_zm or grid_hm
+ *
+ * \param n number of points in each direction
+ * \param t_lap output time of the stencil (mean and deviation)
+ * \param check output checksum
+ *
+ */
+template<typename linearizer>
+void grid_lin_performance_laplacian(size_t n, double (& t_lap)[2], double & check)
+{
+	size_t sz[3] = {n,n,n};
+
+	grid_cpu<3,aggregate<double,double>,linearizer> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = sin(0.1*key.get(0)) + cos(0.2*key.get(1)) + 0.05*key.get(2);
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({(long int)n-2,(long int)n-2,(long int)n-2});
+
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		// visit the points in the order they are stored
+		for (size_t lin = 0 ; lin < g.getGrid().size() ; lin++)
+		{
+			grid_key_dx<3> key = g.getGrid().InvLinId(lin);
+
+			if (key.get(0) < 1 || key.get(0) > (long int)n-2 ||
+			    key.get(1) < 1 || key.get(1) > (long int)n-2 ||
+			    key.get(2) < 1 || key.get(2) > (long int)n-2)
+			{continue;}
+
+			g.template get<1>(key) = g.template get<0>(key.move(0,1)) + g.template get<0>(key.move(0,-1)) +
+			                         g.template get<0>(key.move(1,1)) + g.template get<0>(key.move(1,-1)) +
+			                         g.template get<0>(key.move(2,1)) + g.template get<0>(key.move(2,-1)) -
+			                         6.0*g.template get<0>(key);
+		}
+
+		t.stop();
+		times.add(t.getwct());
+	}
+
+	standard_deviation(times,t_lap[0],t_lap[1]);
+
+	check = 0.0;
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator_sub<3> it3(g_sm,start,stop);
+
+	while (it3.isNext())
+	{
+		check += g.template get<1>(it3.get());
+
+		++it3;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(grid_linearizer_performance_laplacian)
+{
+	size_t n = 128;
+
+	double t_sm[2], t_zm[2], t_hm[2];
+	double check_sm, check_zm, check_hm;
+
+	grid_lin_performance_laplacian<grid_sm<3,void>>(n,t_sm,check_sm);
+	grid_lin_performance_laplacian<grid_zm<3,void>>(n,t_zm,check_zm);
+	grid_lin_performance_laplacian<grid_hm<3,void>>(n,t_hm,check_hm);
+
+	std::cout << "Laplacian on a " << n << "^3 grid" << std::endl;
+	std::cout << "    row-major (grid_sm): " << t_sm[0] << " s (dev " << t_sm[1] << " s)" << std::endl;
+	std::cout << "    Morton    (grid_zm): " << t_zm[0] << " s (dev " << t_zm[1] << " s)" << std::endl;
+	std::cout << "    Hilbert   (grid_hm): " << t_hm[0] << " s (dev " << t_hm[1] << " s)" << std::endl;
+
+	BOOST_REQUIRE_EQUAL(check_sm,check_zm);
+	BOOST_REQUIRE_EQUAL(check_sm,check_hm);
+}
+
+#endif /* OPENFPM_DATA_SRC_GRID_PERFORMANCE_GRID_LINEARIZER_PERFORMANCE_TESTS_HPP_ */
@@ -26,7 +26,9 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCsr.hpp"
 #include "NN/CellList/NNc_array.hpp"
+#include "NN/CellList/CellList_reorder.hpp"
 #include "cuda/CellList_cpu_ker.cuh"
 
 //! Wrapper of the unordered map
@@ -388,6 +390,23 @@ private:
 	//! Cells for the neighborhood radius
 	openfpm::vector<long int> nnc_rad;
 
+	//! Cell id of each particle (used by the parallel construction)
+	openfpm::vector<aggregate<typename Mem_type::local_index_type>> part_cell;
+
+	//! For each particle of the reordered vector, the id in the original vector
+	openfpm::vector<aggregate<typename Mem_type::local_index_type>> sorted_to_not_sorted;
+
+	//! For each particle of the original vector, the id in the reordered vector
+	openfpm::vector<aggregate<typename Mem_type::local_index_type>> non_sorted_to_sorted;
+
+	//! Order in which the cells are visited by reorder() (cached)
+	openfpm::vector<aggregate<size_t>> cell_order;
+
+	//! Offset of each cell in the reordered vector (in cell_order order)
+	openfpm::vector<aggregate<size_t>> cell_order_off;
+
+	//! Type of ordering stored in cell_order
+	cl_reorder_type cell_order_type = CL_REORDER_CELL;
 
 
 	//! Initialize the structures of the data structure
@@ -634,6 +653,9 @@ public:
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
 
+		sorted_to_not_sorted.swap(cell.sorted_to_not_sorted);
+		non_sorted_to_sorted.swap(cell.non_sorted_to_sorted);
+
 		return *this;
 	}
 
@@ -656,6 +678,9 @@ public:
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
 
+		sorted_to_not_sorted = cell.sorted_to_not_sorted;
+		non_sorted_to_sorted = cell.non_sorted_to_sorted;
+
 		return *this;
 	}
 
@@ -746,6 +771,177 @@ public:
 	}
 
 
+	/*! \brief Fill the cell list with all the particles in pos using multiple threads
+	 *
+	 * The cell of each particle is calculated in parallel, then the memory structure
+	 * is constructed with a parallel count and scatter. The result is the same of
+	 * calling clear() and add(pos.get(i),i) for each particle
+	 *
+	 * \note the memory structure must support the parallel construction (Mem_fast)
+	 *
+	 * \param pos vector of positions
+	 *
+	 */
+	template<typename vector_pos_type2>
+	void fill_parallel(vector_pos_type2 & pos)
+	{
+		part_cell.resize(pos.size());
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{part_cell.template get<0>(i) = this->getCell(pos.get(i));}
+
+		Mem_type::construct_host(part_cell);
+	}
+
+	/*! \brief Fill the cell-list and reorder the particles so that particles in the same cell are contiguous
+	 *
+	 * The particles in pos and prp are copied into pos_out and prp_out following the cell
+	 * order selected by opt. At the end the cell-list contain the ids of the reordered
+	 * particles (pos_out, prp_out). The permutation is stored and can be retrieved with
+	 * getSortToNonSort() and getNonSortToSort(), or used with restoreOrder()
+	 *
+	 * \param pos vector of positions
+	 * \param pos_out reordered positions
+	 * \param prp vector of properties
+	 * \param prp_out reordered properties
+	 * \param opt order of the cells (CL_REORDER_CELL,CL_REORDER_MORTON,CL_REORDER_HILBERT)
+	 *
+	 */
+	template<typename vector_pos_type2, typename vector_prp_type>
+	void reorder(vector_pos_type2 & pos, vector_pos_type2 & pos_out,
+			     vector_prp_type & prp, vector_prp_type & prp_out,
+			     cl_reorder_type opt = CL_REORDER_CELL)
+	{
+		reorder(pos,pos_out,opt);
+
+		prp_out.resize(prp.size());
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < sorted_to_not_sorted.size() ; i++)
+		{prp_out.set(i,prp,sorted_to_not_sorted.template get<0>(i));}
+	}
+
+	/*! \brief Fill the cell-list and reorder the particle positions so that particles in the same cell are contiguous
+	 *
+	 * \see reorder
+	 *
+	 * \param pos vector of positions
+	 * \param pos_out reordered positions
+	 * \param opt order of the cells (CL_REORDER_CELL,CL_REORDER_MORTON,CL_REORDER_HILBERT)
+	 *
+	 */
+	template<typename vector_pos_type2>
+	void reorder(vector_pos_type2 & pos, vector_pos_type2 & pos_out, cl_reorder_type opt = CL_REORDER_CELL)
+	{
+		typedef typename Mem_type::local_index_type ids_type;
+
+		// fill the cell-list with the original ids
+
+		Mem_type::clear();
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			size_t cell_id = this->getCell(pos.get(i));
+			Mem_type::add(cell_id,i);
+		}
+
+		if (cell_order.size() != this->getGrid().size() || cell_order_type != opt)
+		{
+			cl_calculate_cell_order(this->getGrid(),opt,cell_order);
+			cell_order_type = opt;
+		}
+
+		// offset of each cell in the reordered vector
+
+		cell_order_off.resize(cell_order.size()+1);
+		cell_order_off.template get<0>(0) = 0;
+		for (size_t i = 0 ; i < cell_order.size() ; i++)
+		{cell_order_off.template get<0>(i+1) = cell_order_off.template get<0>(i) + Mem_type::getNelements(cell_order.template get<0>(i));}
+
+		sorted_to_not_sorted.resize(pos.size());
+		non_sorted_to_sorted.resize(pos.size());
+		pos_out.resize(pos.size());
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < cell_order.size() ; i++)
+		{
+			size_t cell = cell_order.template get<0>(i);
+			size_t off = cell_order_off.template get<0>(i);
+			size_t n = cell_order_off.template get<0>(i+1) - off;
+
+			for (size_t j = 0 ; j < n ; j++)
+			{
+				ids_type id = Mem_type::get(cell,j);
+
+				sorted_to_not_sorted.template get<0>(off+j) = id;
+				non_sorted_to_sorted.template get<0>(id) = off+j;
+				pos_out.set(off+j,pos,id);
+			}
+		}
+
+		// fill the cell-list with the reordered ids
+
+		Mem_type::clear();
+		for (size_t i = 0 ; i < cell_order.size() ; i++)
+		{
+			size_t cell = cell_order.template get<0>(i);
+
+			for (size_t j = cell_order_off.template get<0>(i) ; j < cell_order_off.template get<0>(i+1) ; j++)
+			{Mem_type::add(cell,j);}
+		}
+	}
+
+	/*! \brief Copy a vector in reordered form back into the original order
+	 *
+	 * It is the inverse of reorder(), v_out.get(i) is the element of the original particle i
+	 *
+	 * \tparam prp properties to copy, if empty all the properties are copied
+	 *
+	 * \param v_sorted vector in reordered form
+	 * \param v_out vector in the original order
+	 *
+	 */
+	template<int ... prp, typename vector_type>
+	void restoreOrder(vector_type & v_sorted, vector_type & v_out)
+	{
+		v_out.resize(sorted_to_not_sorted.size());
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < sorted_to_not_sorted.size() ; i++)
+		{
+			size_t dst = sorted_to_not_sorted.template get<0>(i);
+
+			if (sizeof...(prp) == 0)
+			{v_out.set(dst,v_sorted,i);}
+			else
+			{
+				auto src_e = v_sorted.get(i);
+				auto dst_e = v_out.get(dst);
+				object_si_di<decltype(src_e),decltype(dst_e),OBJ_ENCAP,prp...>(src_e,dst_e);
+			}
+		}
+	}
+
+	/*! \brief Return the permutation from the reordered vector to the original one
+	 *
+	 * \return for each reordered particle the id in the original vector
+	 *
+	 */
+	const openfpm::vector<aggregate<typename Mem_type::local_index_type>> & getSortToNonSort() const
+	{
+		return sorted_to_not_sorted;
+	}
+
+	/*! \brief Return the permutation from the original vector to the reordered one
+	 *
+	 * \return for each original particle the id in the reordered vector
+	 *
+	 */
+	const openfpm::vector<aggregate<typename Mem_type::local_index_type>> & getNonSortToSort() const
+	{
+		return non_sorted_to_sorted;
+	}
+
 	/*! \brief Add an element in the cell list forcing to be in the domain cells
 	 *
 	 * \warning careful is intended to be used ONLY to avoid round-off problems
@@ -900,6 +1096,9 @@ public:
 
 		n_dec = cl.n_dec;
 		from_cd = cl.from_cd;
+
+		sorted_to_not_sorted.swap(cl.sorted_to_not_sorted);
+		non_sorted_to_sorted.swap(cl.non_sorted_to_sorted);
 	}
 
 	/*! \brief Get the Cell iterator
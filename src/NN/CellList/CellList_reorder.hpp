@@ -0,0 +1,90 @@
+/*
+ * CellList_reorder.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_
+
+#include <algorithm>
+#include "Grid/grid_sm.hpp"
+#include "util/zmorton.hpp"
+
+extern "C"
+{
+#include "hilbertKey.h"
+}
+
+/*! \brief Order used to reorder the particles with the cell-list
+ *
+ * * CL_REORDER_CELL particles are ordered by linearized cell index
+ * * CL_REORDER_MORTON cells are visited following a Morton (Z) curve
+ * * CL_REORDER_HILBERT cells are visited following an Hilbert curve
+ *
+ */
+enum cl_reorder_type
+{
+	CL_REORDER_CELL,
+	CL_REORDER_MORTON,
+	CL_REORDER_HILBERT
+};
+
+/*! \brief Calculate the order in which the cells are visited to reorder the particles
+ *
+ * \param gs grid of cells (including padding)
+ * \param opt type of ordering
+ * \param cell_order output for each position the linearized id of the cell
+ *
+ */
+template<unsigned int dim, typename vector_type>
+void cl_calculate_cell_order(const grid_sm<dim,void> & gs, cl_reorder_type opt, vector_type & cell_order)
+{
+	cell_order.resize(gs.size());
+
+	if (opt == CL_REORDER_CELL)
+	{
+		for (size_t i = 0 ; i < gs.size() ; i++)
+		{cell_order.template get<0>(i) = i;}
+
+		return;
+	}
+
+	// order of the curve
+	size_t m = 0;
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		while (((size_t)1 << m) < gs.size(i))	{m++;}
+	}
+
+	std::vector<std::pair<size_t,size_t>> keys(gs.size());
+
+	#pragma omp parallel for
+	for (size_t i = 0 ; i < gs.size() ; i++)
+	{
+		grid_key_dx<dim> gk = gs.InvLinId(i);
+
+		if (opt == CL_REORDER_MORTON)
+		{keys[i].first = lin_zid(gk);}
+		else
+		{
+			int err;
+			uint64_t point[dim];
+
+			for (size_t j = 0 ; j < dim ; j++)
+			{point[j] = gk.get(j);}
+
+			keys[i].first = getHKeyFromIntCoord(m, dim, point, &err);
+		}
+
+		keys[i].second = i;
+	}
+
+	std::sort(keys.begin(),keys.end());
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{cell_order.template get<0>(i) = keys[i].second;}
+}
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_REORDER_HPP_ */
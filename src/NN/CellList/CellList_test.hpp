@@ -7,6 +7,7 @@
 
 #include "CellList.hpp"
 #include "CellListM.hpp"
+#include "NNdist_filter.hpp"
 #include "Grid/grid_sm.hpp"
 
 #ifndef CELLLIST_TEST_HPP_
@@ -488,6 +489,232 @@ template<unsigned int dim, typename T, typename CellS> void Test_NN_iterator_rad
 	BOOST_REQUIRE(number_of_nn2 < number_of_nn);
 }
 
+/*! \brief Test that the parallel construction produce the same cell-list of the serial one
+ *
+ * \tparam CellS
+ *
+ */
+template<unsigned int dim, typename T, typename CellS> void Test_cell_fill_parallel(SpaceBox<dim,T> & box)
+{
+	size_t div[dim];
+	for (size_t i = 0 ; i < dim ; i++)	{div[i] = 8;}
+
+	CellS cl_ser(box,div);
+	CellS cl_par(box,div);
+
+	openfpm::vector<Point<dim,T>> pos;
+
+	// with 100000 particles on 8^3 cells we force the slot reallocation
+	for (size_t j = 0 ; j < 100000 ; j++)
+	{
+		Point<dim,T> p;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{p.get(i) = ((T)rand() / (T)RAND_MAX)*(box.getHigh(i) - box.getLow(i)) + box.getLow(i);}
+
+		pos.add(p);
+		cl_ser.add(p,j);
+	}
+
+	cl_par.fill_parallel(pos);
+
+	BOOST_REQUIRE_EQUAL(cl_ser.getNCells(),cl_par.getNCells());
+	BOOST_REQUIRE_EQUAL(cl_ser.private_get_slot(),cl_par.private_get_slot());
+
+	bool match = true;
+	for (size_t i = 0 ; i < cl_ser.getNCells() ; i++)
+	{
+		match &= cl_ser.getNelements(i) == cl_par.getNelements(i);
+
+		for (size_t j = 0 ; j < cl_ser.getNelements(i) && match == true ; j++)
+		{match &= cl_ser.get(i,j) == cl_par.get(i,j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// refill with less particles, the structure must be cleared
+	pos.resize(pos.size() / 2);
+	cl_par.fill_parallel(pos);
+
+	size_t tot = 0;
+	for (size_t i = 0 ; i < cl_par.getNCells() ; i++)
+	{tot += cl_par.getNelements(i);}
+
+	BOOST_REQUIRE_EQUAL(tot,pos.size());
+}
+
+/*! \brief Test the reordering of the particles following the cell-list
+ *
+ * \tparam CellS
+ *
+ */
+template<unsigned int dim, typename T, typename CellS> void Test_cell_reorder(SpaceBox<dim,T> & box, cl_reorder_type opt)
+{
+	size_t div[dim];
+	for (size_t i = 0 ; i < dim ; i++)	{div[i] = 8;}
+
+	CellS cl(box,div);
+
+	openfpm::vector<Point<dim,T>> pos;
+	openfpm::vector<Point<dim,T>> pos_out;
+	openfpm::vector<aggregate<size_t,T[dim]>> prp;
+	openfpm::vector<aggregate<size_t,T[dim]>> prp_out;
+
+	for (size_t j = 0 ; j < 10000 ; j++)
+	{
+		Point<dim,T> p;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{p.get(i) = ((T)rand() / (T)RAND_MAX)*(box.getHigh(i) - box.getLow(i)) + box.getLow(i);}
+
+		pos.add(p);
+
+		prp.add();
+		prp.template get<0>(j) = j;
+		for (size_t i = 0 ; i < dim ; i++)
+		{prp.template get<1>(j)[i] = p.get(i);}
+	}
+
+	cl.reorder(pos,pos_out,prp,prp_out,opt);
+
+	BOOST_REQUIRE_EQUAL(pos_out.size(),pos.size());
+	BOOST_REQUIRE_EQUAL(prp_out.size(),prp.size());
+
+	auto & s2ns = cl.getSortToNonSort();
+	auto & ns2s = cl.getNonSortToSort();
+
+	bool match = true;
+	for (size_t i = 0 ; i < pos_out.size() ; i++)
+	{
+		size_t id = s2ns.template get<0>(i);
+
+		match &= ns2s.template get<0>(id) == i;
+		match &= prp_out.template get<0>(i) == id;
+
+		for (size_t k = 0 ; k < dim ; k++)
+		{match &= pos_out.template get<0>(i)[k] == pos.template get<0>(id)[k];}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the cell-list refer to the reordered particles and the particles in a cell are contiguous
+	size_t tot = 0;
+	for (size_t i = 0 ; i < cl.getGrid().size() ; i++)
+	{
+		for (size_t j = 0 ; j < cl.getNelements(i) ; j++)
+		{
+			size_t p = cl.get(i,j);
+
+			match &= cl.getCell(pos_out.get(p)) == i;
+			match &= p == cl.get(i,0) + j;
+		}
+
+		tot += cl.getNelements(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(tot,pos.size());
+
+	// modify the reordered properties and move them back to the original order
+
+	for (size_t i = 0 ; i < prp_out.size() ; i++)
+	{prp_out.template get<1>(i)[0] += 1.0;}
+
+	openfpm::vector<aggregate<size_t,T[dim]>> prp_back;
+	prp_back.resize(prp.size());
+	cl.template restoreOrder<1>(prp_out,prp_back);
+
+	openfpm::vector<Point<dim,T>> pos_back;
+	cl.restoreOrder(pos_out,pos_back);
+
+	for (size_t i = 0 ; i < prp.size() ; i++)
+	{
+		match &= prp_back.template get<1>(i)[0] == prp.template get<1>(i)[0] + 1.0;
+
+		for (size_t k = 0 ; k < dim ; k++)
+		{match &= pos_back.template get<0>(i)[k] == pos.template get<0>(i)[k];}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Check that the SIMD distance filter select the same neighbors (in the same order) of the scalar loop
+ *
+ */
+template<unsigned int dim, typename T> void Test_NN_dist_filter()
+{
+	Box<dim,T> box;
+
+	size_t div[dim];
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		box.setLow(i,0.0);
+		box.setHigh(i,1.0);
+		div[i] = 10;
+	}
+
+	T r_cut = 0.17;
+	T r_cut2 = r_cut*r_cut;
+
+	// the radius span two cells
+	CellList<dim,T,Mem_fast<>,shift<dim,T>> cl;
+	cl.Initialize(box,div,2);
+
+	openfpm::vector<Point<dim,T>> pos;
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		Point<dim,T> p;
+
+		for (size_t k = 0 ; k < dim ; k++)
+		{p.get(k) = (T)rand() / RAND_MAX;}
+
+		pos.add(p);
+		cl.add(p,i);
+	}
+
+	bool match = true;
+	size_t n_nn = 0;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		Point<dim,T> xp = pos.get(i);
+
+		openfpm::vector<size_t> ids1;
+		openfpm::vector<size_t> ids2;
+
+		auto NN = cl.getNNIteratorRadius(cl.getCell(xp),r_cut);
+
+		while (NN.isNext())
+		{
+			auto q = NN.get();
+
+			if (xp.distance2(pos.get(q)) < r_cut2)
+			{ids1.add(q);}
+
+			++NN;
+		}
+
+		//! [NN radius filter]
+
+		auto NN2 = cl.getNNIteratorRadius(cl.getCell(xp),r_cut);
+
+		NN_filter_radius(NN2,pos,xp,r_cut2,[&](size_t q){ids2.add(q);});
+
+		//! [NN radius filter]
+
+		match &= ids1.size() == ids2.size();
+
+		for (size_t j = 0 ; j < ids1.size() && match == true ; j++)
+		{match &= ids1.get(j) == ids2.get(j);}
+
+		n_nn += ids2.size();
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(n_nn > pos.size());
+}
+
 BOOST_AUTO_TEST_SUITE( CellList_test )
 
 BOOST_AUTO_TEST_CASE ( NN_radius_check )
@@ -519,12 +746,43 @@ BOOST_AUTO_TEST_CASE( CellList_use)
 
 	Test_cell_s<3,double,CellList<3,double,Mem_bal<>>>(box);
 	Test_cell_s<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_csr<>>>(box);
 
 	std::cout << "End cell list" << "\n";
 
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( CellList_NN_dist_filter )
+{
+	Test_NN_dist_filter<2,float>();
+	Test_NN_dist_filter<3,float>();
+	Test_NN_dist_filter<2,double>();
+	Test_NN_dist_filter<3,double>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_fill_parallel )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+	SpaceBox<2,float> box2({-1.0f,-1.0f},{1.0f,1.0f});
+
+	Test_cell_fill_parallel<3,double,CellList<3,double,Mem_fast<>>>(box);
+	Test_cell_fill_parallel<3,double,CellList<3,double,Mem_fast<>,shift<3,double>>>(box);
+	Test_cell_fill_parallel<2,float,CellList<2,float,Mem_fast<>,shift<2,float>>>(box2);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_reorder )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+	SpaceBox<2,float> box2({-1.0f,-1.0f},{1.0f,1.0f});
+
+	Test_cell_reorder<3,double,CellList<3,double,Mem_fast<>>>(box,CL_REORDER_CELL);
+	Test_cell_reorder<3,double,CellList<3,double,Mem_fast<>>>(box,CL_REORDER_MORTON);
+	Test_cell_reorder<3,double,CellList<3,double,Mem_fast<>>>(box,CL_REORDER_HILBERT);
+	Test_cell_reorder<3,double,CellList<3,double,Mem_csr<>>>(box,CL_REORDER_HILBERT);
+	Test_cell_reorder<2,float,CellList<2,float,Mem_fast<>,shift<2,float>>>(box2,CL_REORDER_MORTON);
+}
+
 BOOST_AUTO_TEST_CASE( CellList_consistent )
 {
 	Test_CellDecomposer_consistent<CellList<2,float,Mem_fast<>,shift<2,float>>>();
@@ -39,6 +39,39 @@ template<unsigned int dim, typename T, typename CellList> void populate_cell_lis
 
 #include "Vector/map_vector.hpp"
 
+/*! \brief Fill the cell-list on host, one particle at time
+ *
+ * \tparam is_parallel the memory structure of the cell-list support the parallel construction
+ *
+ */
+template<bool is_parallel>
+struct populate_cell_list_no_sym_host_impl
+{
+	template<typename vector_pos_type, typename CellList>
+	static void populate(vector_pos_type & pos, CellList & cli)
+	{
+		cli.clear();
+
+		for (size_t i = 0; i < pos.size() ; i++)
+		{
+			cli.add(pos.get(i), i);
+		}
+	}
+};
+
+/*! \brief Fill the cell-list on host with multiple threads (count, and scatter)
+ *
+ */
+template<>
+struct populate_cell_list_no_sym_host_impl<true>
+{
+	template<typename vector_pos_type, typename CellList>
+	static void populate(vector_pos_type & pos, CellList & cli)
+	{
+		cli.fill_parallel(pos);
+	}
+};
+
 template<bool is_gpu>
 struct populate_cell_list_no_sym_impl
 {
@@ -52,12 +85,7 @@ struct populate_cell_list_no_sym_impl
 			   	   	   	   size_t g_m,
 			   	   	   	   cl_construct_opt optc)
 	{
-		cli.clear();
-
-		for (size_t i = 0; i < pos.size() ; i++)
-		{
-			cli.add(pos.get(i), i);
-		}
+		populate_cell_list_no_sym_host_impl<has_host_parallel_construct<CellList>::value>::populate(pos,cli);
 	}
 };
 
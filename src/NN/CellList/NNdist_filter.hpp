@@ -0,0 +1,152 @@
+/*
+ * NNdist_filter.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_NNDIST_FILTER_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_NNDIST_FILTER_HPP_
+
+#include <Vc/Vc>
+#include "Space/Shape/Point.hpp"
+
+//! Number of candidates gathered before the distances are evaluated
+#define NN_DIST_FILTER_BATCH 64
+
+/*! \brief Filter the neighborhood candidates of a particle by distance with SIMD instructions
+ *
+ * The coordinates of the candidates are gathered in batches (one array for each
+ * component), the squared distances of a batch are computed with Vc vectors and
+ * the candidates with distance2 < r_cut2 are passed to a function in the same
+ * order they were added
+ *
+ * ### Usage
+ * \snippet CellList_test.hpp NN radius filter
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of the space
+ * \tparam index_type type of the candidate ids
+ *
+ */
+template<unsigned int dim, typename T, typename index_type = size_t>
+class NN_dist_filter
+{
+	typedef Vc::Vector<T> vtype;
+
+	static_assert(NN_DIST_FILTER_BATCH % Vc::Vector<T>::Size == 0,"NN_DIST_FILTER_BATCH must be a multiple of the vector size");
+
+	//! coordinates of the candidates
+	alignas(64) T x[dim][NN_DIST_FILTER_BATCH];
+
+	//! id of the candidates
+	index_type id[NN_DIST_FILTER_BATCH];
+
+	//! number of candidates in the batch
+	unsigned int n;
+
+	//! position of the particle
+	vtype xp[dim];
+
+	//! squared radius
+	vtype r_cut2;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param p position of the particle
+	 * \param r_cut2 squared cut-off radius
+	 *
+	 */
+	inline NN_dist_filter(const Point<dim,T> & p, T r_cut2)
+	:n(0),r_cut2(r_cut2)
+	{
+		for (size_t k = 0 ; k < dim ; k++)
+		{xp[k] = vtype(p.get(k));}
+	}
+
+	/*! \brief Add a candidate
+	 *
+	 * \param q candidate id
+	 * \param pos vector of the positions
+	 * \param f function called with the id of each candidate that pass the filter
+	 *
+	 */
+	template<typename vector_pos_type, typename lambda_f>
+	inline void add(index_type q, const vector_pos_type & pos, lambda_f & f)
+	{
+		for (size_t k = 0 ; k < dim ; k++)
+		{x[k][n] = pos.template get<0>(q)[k];}
+
+		id[n] = q;
+		n++;
+
+		if (n == NN_DIST_FILTER_BATCH)
+		{flush(f);}
+	}
+
+	/*! \brief Evaluate the distances of the candidates in the batch
+	 *
+	 * \param f function called with the id of each candidate that pass the filter
+	 *
+	 */
+	template<typename lambda_f>
+	inline void flush(lambda_f & f)
+	{
+		for (unsigned int b = 0 ; b < n ; b += vtype::Size)
+		{
+			vtype d2(T(0));
+
+			for (size_t k = 0 ; k < dim ; k++)
+			{
+				vtype dx = vtype(&x[k][b],Vc::Aligned) - xp[k];
+				d2 += dx*dx;
+			}
+
+			// compress the lanes that pass the filter, the lanes after n
+			// are not initialized and are discarded
+			unsigned int m = (d2 < r_cut2).toInt();
+
+			if (n - b < vtype::Size)
+			{m &= (1u << (n - b)) - 1;}
+
+			while (m != 0)
+			{
+				f(id[b + __builtin_ctz(m)]);
+				m &= m - 1;
+			}
+		}
+
+		n = 0;
+	}
+};
+
+/*! \brief Iterate a neighborhood and call f for the neighbors inside a radius
+ *
+ * It can be used with any neighborhood iterator like the one returned by
+ * getNNIteratorRadius, the distances are evaluated with NN_dist_filter
+ *
+ * \param NN neighborhood iterator
+ * \param pos vector of the positions of the neighborhood particles
+ * \param xp position of the particle
+ * \param r_cut2 squared cut-off radius
+ * \param f function called with the id of each neighbor q with xp.distance2(q) < r_cut2
+ *
+ */
+template<unsigned int dim, typename T, typename NN_type, typename vector_pos_type, typename lambda_f>
+inline void NN_filter_radius(NN_type & NN, const vector_pos_type & pos, const Point<dim,T> & xp, T r_cut2, lambda_f f)
+{
+	NN_dist_filter<dim,T,typename std::remove_const<typename std::remove_reference<decltype(NN.get())>::type>::type> flt(xp,r_cut2);
+
+	while (NN.isNext())
+	{
+		flt.add(NN.get(),pos,f);
+
+		++NN;
+	}
+
+	flt.flush(f);
+}
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_NNDIST_FILTER_HPP_ */
@@ -0,0 +1,459 @@
+/*
+ * CellList_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "NN/CellList/CellList_util.hpp"
+#include "NN/CellList/NNdist_filter.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/*! \brief Create a set of random particles in a unit box
+ *
+ * \param pos vector of particles to fill
+ * \param n_part number of particles
+ *
+ */
+template<unsigned int dim, typename T>
+void cl_performance_create_particles(openfpm::vector<Point<dim,T>> & pos, size_t n_part)
+{
+	pos.resize(n_part);
+
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		for (size_t j = 0 ; j < dim ; j++)
+		{pos.template get<0>(i)[j] = (T)rand() / (T)RAND_MAX;}
+	}
+}
+
+/*! \brief Create a set of clustered particles in a unit box
+ *
+ * A fraction of the particles is concentrated in a small cube, the rest is uniform
+ *
+ * \param pos vector of particles to fill
+ * \param n_part number of particles
+ * \param frac fraction of particles in the cluster
+ * \param c_size size of the cluster
+ *
+ */
+template<unsigned int dim, typename T>
+void cl_performance_create_clustered_particles(openfpm::vector<Point<dim,T>> & pos, size_t n_part, double frac, T c_size)
+{
+	pos.resize(n_part);
+
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		T scale = ((double)rand() / RAND_MAX < frac)?c_size:1.0;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{pos.template get<0>(i)[j] = scale * (T)rand() / (T)RAND_MAX;}
+	}
+}
+
+/*! \brief Return the number of bytes currently allocated on the heap
+ *
+ * \return the allocated bytes (0 if not available)
+ *
+ */
+static inline size_t cl_performance_heap_bytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 mi = mallinfo2();
+	return mi.uordblks + mi.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+/*! \brief Measure construction time and memory of a cell-list with a given memory type
+ *
+ * \param pos particles
+ * \param div number of cells in each direction
+ * \param name name of the memory type
+ *
+ */
+template<typename CellS>
+void cl_performance_mem_type(openfpm::vector<Point<3,float>> & pos, size_t (& div)[3], const char * name)
+{
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	size_t mem_start = cl_performance_heap_bytes();
+
+	CellS cl(box,div);
+
+	std::vector<double> times(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		cl.clear();
+		for (size_t j = 0 ; j < pos.size() ; j++)
+		{cl.add(pos.get(j),j);}
+
+		// force the construction (lazy for Mem_csr)
+		cl.getNelements(0);
+
+		t.stop();
+
+		times[i] = t.getwct();
+	}
+
+	size_t mem = cl_performance_heap_bytes() - mem_start;
+
+	double mean;
+	double dev;
+	standard_deviation(times,mean,dev);
+
+	// time to traverse all the cells
+	timer t;
+	t.start();
+
+	size_t tot = 0;
+	for (size_t i = 0 ; i < cl.getGrid().size() ; i++)
+	{
+		for (size_t j = 0 ; j < cl.getNelements(i) ; j++)
+		{tot += cl.get(i,j);}
+	}
+
+	t.stop();
+
+	std::cout << "Cell-list " << name << " clustered construction: " << mean << " s (dev " << dev << ")"
+			  << "  traverse: " << t.getwct() << " s"
+			  << "  memory: " << mem / (1024*1024) << " MB  (" << tot << ")" << std::endl;
+}
+
+/*! \brief Compute a Lennard-Jones like force loop using the cell-list
+ *
+ * \param cl cell-list
+ * \param pos particles
+ * \param force output force
+ * \param r_cut cut-off radius
+ *
+ */
+template<typename CellS>
+void cl_performance_force_loop(CellS & cl, openfpm::vector<Point<3,float>> & pos, openfpm::vector<Point<3,float>> & force, float r_cut)
+{
+	force.resize(pos.size());
+	float r_cut2 = r_cut*r_cut;
+
+	#pragma omp parallel for schedule(static)
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,float> xp = pos.get(p);
+		Point<3,float> f = {0.0,0.0,0.0};
+
+		auto NN = cl.getNNIterator(cl.getCell(xp));
+
+		while (NN.isNext())
+		{
+			auto q = NN.get();
+
+			if (q != p)
+			{
+				Point<3,float> xq = pos.get(q);
+				float rn2 = xp.distance2(xq);
+
+				if (rn2 < r_cut2)
+				{
+					Point<3,float> r = xp - xq;
+					f += r / (rn2*rn2*rn2 + 1e-3f);
+				}
+			}
+
+			++NN;
+		}
+
+		force.get(p) = f;
+	}
+}
+
+/*! \brief Compare the scalar and the SIMD distance filter on the full neighborhood of all the particles
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of the space
+ *
+ * \param n_part number of particles
+ *
+ */
+template<unsigned int dim, typename T>
+void cl_performance_dist_filter(size_t n_part)
+{
+	Box<dim,T> box;
+	size_t div[dim];
+
+	// around 20 particles in each cell
+	size_t n_div = std::pow((double)n_part / 20.0,1.0 / dim);
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		box.setLow(i,0.0);
+		box.setHigh(i,1.0);
+		div[i] = n_div;
+	}
+
+	T r_cut = 1.0 / n_div;
+	T r_cut2 = r_cut*r_cut;
+
+	openfpm::vector<Point<dim,T>> pos_r;
+	cl_performance_create_particles(pos_r,n_part);
+
+	CellList<dim,T,Mem_fast<HeapMemory,unsigned int>> cl;
+	cl.Initialize(box,div);
+
+	for (size_t i = 0 ; i < pos_r.size() ; i++)
+	{cl.add(pos_r.get(i),i);}
+
+	// the particles are ordered by cell, otherwise the loops are dominated by the cache misses
+	openfpm::vector<Point<dim,T>> pos;
+
+	for (size_t c = 0 ; c < cl.getGrid().size() ; c++)
+	{
+		for (size_t k = 0 ; k < cl.getNelements(c) ; k++)
+		{pos.add(pos_r.get(cl.get(c,k)));}
+	}
+
+	cl.clear();
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{cl.add(pos.get(i),i);}
+
+	// the neighbors are stored like in the Verlet-list construction
+	std::vector<unsigned int> out(4096);
+
+	openfpm::vector<double> times_s;
+	openfpm::vector<double> times_v;
+	size_t n_cand = 0;
+	size_t n_s = 0;
+	size_t n_v = 0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		n_cand = 0;
+		n_s = 0;
+		n_v = 0;
+
+		timer t;
+		t.start();
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<dim,T> xp = pos.get(p);
+			auto NN = cl.getNNIterator(cl.getCell(xp));
+
+			while (NN.isNext())
+			{
+				auto q = NN.get();
+
+				if (xp.distance2(pos.get(q)) < r_cut2)
+				{out[n_s++ % out.size()] = q;}
+
+				n_cand++;
+
+				++NN;
+			}
+		}
+
+		t.stop();
+		times_s.add(t.getwct());
+
+		timer t2;
+		t2.start();
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<dim,T> xp = pos.get(p);
+			auto NN = cl.getNNIterator(cl.getCell(xp));
+
+			NN_filter_radius(NN,pos,xp,r_cut2,[&](unsigned int q){out[n_v++ % out.size()] = q;});
+		}
+
+		t2.stop();
+		times_v.add(t2.getwct());
+	}
+
+	BOOST_REQUIRE_EQUAL(n_s,n_v);
+
+	double mean_s, dev_s, mean_v, dev_v;
+	standard_deviation(times_s,mean_s,dev_s);
+	standard_deviation(times_v,mean_v,dev_v);
+
+	std::cout << "Distance filter " << dim << "D " << ((sizeof(T) == 4)?"float":"double") << " " << n_cand << " candidates, " << n_s << " neighbors  scalar: "
+			  << mean_s << " s (dev " << dev_s << ")  " << n_cand / mean_s << " candidates/s  SIMD: "
+			  << mean_v << " s (dev " << dev_v << ")  " << n_cand / mean_v << " candidates/s  speedup: " << mean_s / mean_v << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE( celllist_performance )
+
+BOOST_AUTO_TEST_CASE(celllist_performance_reorder_force)
+{
+	size_t n_part = 512*1024;
+	size_t div[3] = {40,40,40};
+	float r_cut = 1.0 / 40.0;
+
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	openfpm::vector<Point<3,float>> pos;
+	openfpm::vector<Point<3,float>> pos_out;
+	openfpm::vector<Point<3,float>> force;
+	cl_performance_create_particles(pos,n_part);
+
+	CellList<3,float,Mem_fast<>> cl(box,div);
+
+	const char * names[] = {"not reordered","cell","morton","hilbert"};
+
+	double mean_ref = 0.0;
+
+	for (size_t k = 0 ; k < 4 ; k++)
+	{
+		openfpm::vector<Point<3,float>> * pos_f = &pos;
+
+		timer t_r;
+		t_r.start();
+
+		if (k == 0)
+		{
+			cl.clear();
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{cl.add(pos.get(j),j);}
+		}
+		else
+		{
+			cl.reorder(pos,pos_out,(cl_reorder_type)(k-1));
+			pos_f = &pos_out;
+		}
+
+		t_r.stop();
+
+		std::vector<double> times(N_STAT_SMALL + 1);
+
+		for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+		{
+			timer t;
+			t.start();
+
+			cl_performance_force_loop(cl,*pos_f,force,r_cut);
+
+			t.stop();
+
+			times[i] = t.getwct();
+		}
+
+		double mean;
+		double dev;
+		standard_deviation(times,mean,dev);
+
+		if (k == 0)	{mean_ref = mean;}
+
+		std::cout << "Cell-list force loop " << names[k] << " construction: " << t_r.getwct() << " s  force: " << mean << " s (dev " << dev << ")  speedup: " << mean_ref / mean << std::endl;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(celllist_performance_mem_type_clustered)
+{
+	size_t n_part = 256*1024;
+	size_t div[3] = {32,32,32};
+
+	// 50% of the particles in 1/64 of the volume
+	openfpm::vector<Point<3,float>> pos;
+	cl_performance_create_clustered_particles(pos,n_part,0.5,0.25f);
+
+	cl_performance_mem_type<CellList<3,float,Mem_fast<>>>(pos,div,"Mem_fast");
+	cl_performance_mem_type<CellList<3,float,Mem_bal<>>>(pos,div,"Mem_bal");
+	cl_performance_mem_type<CellList<3,float,Mem_mw<>>>(pos,div,"Mem_mw");
+	cl_performance_mem_type<CellList<3,float,Mem_csr<>>>(pos,div,"Mem_csr");
+}
+
+BOOST_AUTO_TEST_CASE(celllist_performance_construct_thread_scaling)
+{
+	size_t n_part = 4*1024*1024;
+	size_t div[3] = {128,128,128};
+
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	openfpm::vector<Point<3,float>> pos;
+	cl_performance_create_particles(pos,n_part);
+
+	CellList<3,float,Mem_fast<>> cl(box,div);
+
+	// serial reference
+	std::vector<double> times(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		cl.clear();
+		for (size_t j = 0 ; j < pos.size() ; j++)
+		{cl.add(pos.get(j),j);}
+
+		t.stop();
+
+		times[i] = t.getwct();
+	}
+
+	double mean_ser;
+	double dev;
+	standard_deviation(times,mean_ser,dev);
+
+	std::cout << "Cell-list serial construction " << n_part << " particles: " << mean_ser << " s (dev " << dev << ")" << std::endl;
+
+#ifdef HAVE_OPENMP
+	int max_threads = omp_get_max_threads();
+#else
+	int max_threads = 1;
+#endif
+
+	for (int nt = 1 ; nt <= max_threads ; nt *= 2)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+		{
+			timer t;
+			t.start();
+
+			cl.fill_parallel(pos);
+
+			t.stop();
+
+			times[i] = t.getwct();
+		}
+
+		double mean;
+		standard_deviation(times,mean,dev);
+
+		std::cout << "Cell-list parallel construction threads: " << nt << " time: " << mean << " s (dev " << dev << ")  speedup: " << mean_ser / mean << std::endl;
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(celllist_performance_dist_filter)
+{
+	cl_performance_dist_filter<2,float>(1024*1024);
+	cl_performance_dist_filter<2,double>(1024*1024);
+	cl_performance_dist_filter<3,float>(512*1024);
+	cl_performance_dist_filter<3,double>(512*1024);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELLLIST_PERFORMANCE_TESTS_HPP_ */
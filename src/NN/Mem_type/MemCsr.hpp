@@ -0,0 +1,596 @@
+/*
+ * MemCsr.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MEMCSR_HPP_
+#define MEMCSR_HPP_
+
+#include "config.h"
+#include <algorithm>
+#include "util/common.hpp"
+#include "Vector/map_vector.hpp"
+
+/*! \brief Class for CSR (compressed) cell list implementation
+ *
+ * \tparam Memory memory used for the internal buffers
+ * \tparam local_index type used for the local index
+ *
+ * It work like a vector of vector, but all the elements are stored contiguously
+ * cell by cell and an offset array indicate where each cell start.
+ * The memory allocation is (in byte) Size = (M+1)*sizeof(ele) + (N+1)*sizeof(ele)
+ *
+ * * M = number of cells
+ * * N = total number of elements
+ *
+ * In contrast to Mem_fast the memory does not depend on the maximum number of
+ * elements in a cell, so one dense cell does not inflate the memory of all the others.
+ *
+ * Elements added in increasing cell order (like the Verlet-list construction) are
+ * appended directly. Elements added in arbitrary order (like the Cell-list construction)
+ * are staged and placed with a counting sort (count, prefix sum, scatter) the first time
+ * the structure is read. The order of the elements inside a cell is the insertion order.
+ *
+ * \warning Reading the structure after an add() is not thread safe (it can trigger the
+ *          construction), call construct() before reading it from multiple threads
+ *
+ */
+template <typename Memory = HeapMemory, typename local_index = size_t>
+class Mem_csr
+{
+	//! base that store the data
+	typedef typename openfpm::vector<aggregate<local_index>,Memory> base;
+
+	//! offset of each cell in cl_base (number of cells + 1)
+	mutable base cl_off;
+
+	//! elements of all the cells (number of elements + 1, the last is a guard
+	//! so that getStopId of the last cell is a valid reference)
+	mutable base cl_base;
+
+	//! Staged elements, cell id
+	mutable base st_cell;
+
+	//! Staged elements, element
+	mutable base st_ele;
+
+	//! temporal buffers used in the counting sort
+	mutable base cl_off_tmp;
+
+	//! temporal buffers used in the counting sort
+	mutable base cl_base_tmp;
+
+	//! Number of elements placed in cl_base
+	mutable size_t n_ele;
+
+	//! Cell that is receiving elements in append mode
+	mutable size_t open_cell;
+
+	//! The offsets after open_cell must be completed
+	mutable bool dirty;
+
+	/*! \brief Complete the offsets and place the staged elements
+	 *
+	 *
+	 */
+	inline void flush() const
+	{
+		if (dirty == false)	{return;}
+
+		size_t n_cell = cl_off.size() - 1;
+
+		// complete the offsets of the cells after the open cell
+		for (size_t i = open_cell + 1 ; i <= n_cell ; i++)
+		{cl_off.template get<0>(i) = n_ele;}
+
+		if (st_cell.size() != 0)
+		{
+			// counting pass
+			cl_off_tmp.resize(n_cell + 1);
+			cl_off_tmp.template fill<0>(0);
+
+			for (size_t i = 0 ; i < st_cell.size() ; i++)
+			{cl_off_tmp.template get<0>(st_cell.template get<0>(i) + 1)++;}
+
+			// prefix sum, including the elements already placed
+			for (size_t i = 0 ; i < n_cell ; i++)
+			{
+				cl_off_tmp.template get<0>(i+1) += cl_off_tmp.template get<0>(i) +
+													cl_off.template get<0>(i+1) - cl_off.template get<0>(i);
+			}
+
+			size_t n_ele_new = n_ele + st_cell.size();
+			cl_base_tmp.resize(n_ele_new + 1);
+
+			// copy the elements already placed, the staged ones go after them
+			for (size_t i = 0 ; i < n_cell ; i++)
+			{
+				local_index start = cl_off.template get<0>(i);
+				local_index n = cl_off.template get<0>(i+1) - start;
+				local_index start_new = cl_off_tmp.template get<0>(i);
+
+				for (local_index j = 0 ; j < n ; j++)
+				{cl_base_tmp.template get<0>(start_new + j) = cl_base.template get<0>(start + j);}
+
+				// cl_off keep the insertion point of each cell
+				cl_off.template get<0>(i) = start_new + n;
+			}
+
+			// scatter (stable)
+			for (size_t i = 0 ; i < st_cell.size() ; i++)
+			{
+				local_index & ins = cl_off.template get<0>(st_cell.template get<0>(i));
+				cl_base_tmp.template get<0>(ins) = st_ele.template get<0>(i);
+				ins++;
+			}
+
+			cl_off.swap(cl_off_tmp);
+			cl_base.swap(cl_base_tmp);
+
+			n_ele = n_ele_new;
+			st_cell.clear();
+			st_ele.clear();
+
+			// we can continue to append only on the last non empty cell
+			open_cell = n_cell - 1;
+			while (open_cell > 0 && cl_off.template get<0>(open_cell) == n_ele)
+			{open_cell--;}
+		}
+
+		dirty = false;
+	}
+
+public:
+
+	typedef void toKernel_type;
+
+	//! expose the type of the local index
+	typedef local_index local_index_type;
+
+	//! It can be constructed in parallel with construct_host
+	typedef int yes_has_host_parallel_construct;
+
+	/*! \brief return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return cl_off.size() - 1;
+	}
+
+	/*! \brief Destroy the internal memory including the retained one
+	 *
+	 */
+	inline void destroy()
+	{
+		cl_off.swap(base());
+		cl_base.swap(base());
+		st_cell.swap(base());
+		st_ele.swap(base());
+		cl_off_tmp.swap(base());
+		cl_base_tmp.swap(base());
+
+		cl_off.resize(1);
+		clear();
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot unused
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	inline void init_to_zero(size_t slot, size_t tot_n_cell)
+	{
+		cl_off.resize(tot_n_cell + 1);
+		clear();
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(const Mem_csr<Memory,local_index> & mem)
+	{
+		mem.flush();
+
+		cl_off = mem.cl_off;
+		cl_base = mem.cl_base;
+		st_cell.clear();
+		st_ele.clear();
+
+		n_ele = mem.n_ele;
+		open_cell = mem.open_cell;
+		dirty = false;
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(Mem_csr<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	template<typename Memory2>
+	inline void copy_general(const Mem_csr<Memory2,local_index> & mem)
+	{
+		cl_off = mem.private_get_cl_off();
+		cl_base = mem.private_get_cl_base();
+		st_cell.clear();
+		st_ele.clear();
+
+		n_ele = cl_base.size() - 1;
+		open_cell = size() - 1;
+		dirty = true;
+	}
+
+	/*! \brief Fill the structure in parallel from the cell id of each element
+	 *
+	 * The offsets are calculated from a parallel counting pass and a prefix sum,
+	 * the element ids are then scattered. Each cell is sorted at the end so the
+	 * order is the same of calling add(cell_ids.get(i),i) for each element
+	 *
+	 * \note all the elements previously stored are removed
+	 *
+	 * \param cell_ids for each element i the cell where it must be stored
+	 *
+	 */
+	template<typename vector_cid_type>
+	inline void construct_host(const vector_cid_type & cell_ids)
+	{
+		size_t n_cell = size();
+
+		cl_off.template fill<0>(0);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			local_index & cnt = cl_off.template get<0>(cell_ids.template get<0>(i) + 1);
+
+			#pragma omp atomic
+			cnt++;
+		}
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cl_off.template get<0>(i+1) += cl_off.template get<0>(i);}
+
+		n_ele = cell_ids.size();
+		cl_base.resize(n_ele + 1);
+
+		// use cl_off_tmp as insertion point of each cell
+		cl_off_tmp = cl_off;
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			local_index & ins = cl_off_tmp.template get<0>(cell_ids.template get<0>(i));
+			local_index pos;
+
+			#pragma omp atomic capture
+			pos = ins++;
+
+			cl_base.template get<0>(pos) = i;
+		}
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			local_index start = cl_off.template get<0>(i);
+			local_index stop = cl_off.template get<0>(i+1);
+
+			if (stop - start <= 1)	{continue;}
+
+			local_index * ptr = &cl_base.template get<0>(0);
+			std::sort(ptr + start,ptr + stop);
+		}
+
+		st_cell.clear();
+		st_ele.clear();
+		open_cell = n_cell - 1;
+		dirty = false;
+	}
+
+	/*! \brief Set the number of elements of each cell
+	 *
+	 * The offsets are the prefix sum of the counts. The elements of the cells are
+	 * not set, they must be written with getCellPointer (different cells can be
+	 * written from different threads)
+	 *
+	 * \note all the elements previously stored are removed
+	 *
+	 * \param cnt for each cell the number of elements
+	 *
+	 */
+	template<typename vector_cnt_type>
+	inline void construct_host_count(const vector_cnt_type & cnt)
+	{
+		size_t n_cell = cnt.size();
+
+		cl_off.resize(n_cell + 1);
+		cl_off.template get<0>(0) = 0;
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cl_off.template get<0>(i+1) = cl_off.template get<0>(i) + cnt.template get<0>(i);}
+
+		n_ele = cl_off.template get<0>(n_cell);
+		cl_base.resize(n_ele + 1);
+
+		st_cell.clear();
+		st_ele.clear();
+		open_cell = (n_cell == 0)?0:n_cell - 1;
+		dirty = false;
+	}
+
+	/*! \brief Get the pointer to the first element of a cell
+	 *
+	 * \param cell cell id
+	 *
+	 * \return the pointer to the elements of the cell
+	 *
+	 */
+	inline local_index * getCellPointer(local_index cell)
+	{
+		flush();
+		return &cl_base.template get<0>(cl_off.template get<0>(cell));
+	}
+
+	/*! \brief Construct the structure placing all the elements added
+	 *
+	 * It is not necessary to call it, the structure is constructed the first time
+	 * it is read
+	 *
+	 */
+	inline void construct()
+	{
+		flush();
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, local_index ele)
+	{
+		if (st_cell.size() == 0 && cell_id >= open_cell)
+		{
+			// append mode
+
+			for (size_t i = open_cell + 1 ; i <= cell_id ; i++)
+			{cl_off.template get<0>(i) = n_ele;}
+
+			open_cell = cell_id;
+
+			cl_base.template get<0>(n_ele) = ele;
+			cl_base.add();
+			n_ele++;
+		}
+		else
+		{
+			st_cell.add();
+			st_cell.template get<0>(st_cell.size()-1) = cell_id;
+			st_ele.add();
+			st_ele.template get<0>(st_ele.size()-1) = ele;
+		}
+
+		dirty = true;
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void add(local_index cell_id, local_index ele)
+	{
+		this->addCell(cell_id,ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) -> decltype(cl_base.template get<0>(0)) &
+	{
+		flush();
+		return cl_base.template get<0>(cl_off.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) const -> decltype(cl_base.template get<0>(0)) &
+	{
+		flush();
+		return cl_base.template get<0>(cl_off.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Remove an element in the cell
+	 *
+	 * \warning it shift all the elements after the removed one, it is O(N)
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id to remove
+	 *
+	 */
+	inline void remove(local_index cell, local_index ele)
+	{
+		flush();
+
+		size_t start = cl_off.template get<0>(cell) + ele;
+
+		for (size_t i = start ; i < n_ele ; i++)
+		{cl_base.template get<0>(i) = cl_base.template get<0>(i+1);}
+
+		for (size_t i = cell + 1 ; i < cl_off.size() ; i++)
+		{cl_off.template get<0>(i)--;}
+
+		n_ele--;
+		cl_base.resize(n_ele + 1);
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		flush();
+		return cl_off.template get<0>(cell_id+1) - cl_off.template get<0>(cell_id);
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> & mem)
+	{
+		cl_off.swap(mem.cl_off);
+		cl_base.swap(mem.cl_base);
+		st_cell.swap(mem.st_cell);
+		st_ele.swap(mem.st_ele);
+
+		std::swap(n_ele,mem.n_ele);
+		std::swap(open_cell,mem.open_cell);
+		std::swap(dirty,mem.dirty);
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief Delete all the elements
+	 *
+	 *
+	 */
+	inline void clear()
+	{
+		n_ele = 0;
+		open_cell = 0;
+
+		cl_off.template get<0>(0) = 0;
+		cl_base.resize(1);
+		st_cell.clear();
+		st_ele.clear();
+
+		dirty = true;
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		flush();
+		return cl_base.template get<0>(cl_off.template get<0>(cell_id));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		flush();
+		return cl_base.template get<0>(cl_off.template get<0>(cell_id+1));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+	/*! \brief Constructor
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline Mem_csr(size_t slot)
+	:n_ele(0),open_cell(0),dirty(false)
+	{
+		cl_off.resize(1);
+		cl_off.template get<0>(0) = 0;
+		cl_base.resize(1);
+	}
+
+	/*! \brief Set the number of slot for each cell (unused)
+	 *
+	 * \param number of slot
+	 *
+	 */
+	inline void set_slot(size_t slot)
+	{}
+
+	/*! \brief Return the private data-structure cl_off
+	 *
+	 * \return cl_off
+	 *
+	 */
+	const base & private_get_cl_off() const
+	{
+		flush();
+		return cl_off;
+	}
+
+	/*! \brief Return the private data-structure cl_base
+	 *
+	 * \return cl_base
+	 *
+	 */
+	const base & private_get_cl_base() const
+	{
+		flush();
+		return cl_base;
+	}
+};
+
+
+#endif /* MEMCSR_HPP_ */
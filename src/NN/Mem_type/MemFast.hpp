@@ -14,6 +14,7 @@
 #include "Space/Shape/HyperCube.hpp"
 #include "NN/CellList/CellListIterator.hpp"
 #include <unordered_map>
+#include <algorithm>
 #include "util/common.hpp"
 #include "Vector/map_vector.hpp"
 
@@ -131,6 +132,9 @@ public:
 
 	typedef local_index local_index_type;
 
+	//! It can be constructed in parallel with construct_host
+	typedef int yes_has_host_parallel_construct;
+
 	/*! \brief return the number of elements
 	 *
 	 * \return the number of elements
@@ -207,6 +211,135 @@ public:
 		cl_base = mem.private_get_cl_base();
 	}
 
+	/*! \brief Fill the structure in parallel from the cell id of each element
+	 *
+	 * It is the host counterpart of the GPU construction. A first pass count the
+	 * elements in each cell and set the number of slot, a second pass scatter the
+	 * element ids into the cells. Because the scatter is not ordered, each cell is
+	 * sorted at the end, this produce exactly the same layout (and the same slot)
+	 * of calling add(cell_ids.get(i),i) for each element
+	 *
+	 * \note all the elements previously stored are removed
+	 *
+	 * \param cell_ids for each element i the cell where it must be stored
+	 *
+	 */
+	template<typename vector_cid_type>
+	inline void construct_host(const vector_cid_type & cell_ids)
+	{
+		cl_n.template fill<0>(0);
+
+		// Count the elements in each cell
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			local_index & cnt = cl_n.template get<0>(cell_ids.template get<0>(i));
+
+			#pragma omp atomic
+			cnt++;
+		}
+
+		local_index max_n = 0;
+
+		#pragma omp parallel for reduction(max:max_n)
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+		{
+			local_index n = cl_n.template get<0>(i);
+			max_n = (n > max_n)?n:max_n;
+		}
+
+		// Same slot we would reach with add() doubling
+		if (max_n >= slot)
+		{
+			while (max_n >= slot)
+			{slot *= 2;}
+
+			// the content is rebuild, no need to copy
+			base cl_base_(slot * cl_n.size());
+			cl_base.swap(cl_base_);
+		}
+
+		cl_n.template fill<0>(0);
+
+		// scatter the elements in the cells
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			local_index cell = cell_ids.template get<0>(i);
+			local_index & cnt = cl_n.template get<0>(cell);
+			local_index pos;
+
+			#pragma omp atomic capture
+			pos = cnt++;
+
+			cl_base.template get<0>(slot * cell + pos) = i;
+		}
+
+		// restore the insertion order inside each cell
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+		{
+			local_index n = cl_n.template get<0>(i);
+
+			if (n <= 1)	{continue;}
+
+			local_index * start = &cl_base.template get<0>(slot * i);
+			std::sort(start,start + n);
+		}
+	}
+
+	/*! \brief Set the number of elements of each cell
+	 *
+	 * The number of slot is increased (doubling) until it can contain the largest
+	 * cell. The elements of the cells are not set, they must be written with
+	 * getCellPointer (different cells can be written from different threads)
+	 *
+	 * \param cnt for each cell the number of elements
+	 *
+	 */
+	template<typename vector_cnt_type>
+	inline void construct_host_count(const vector_cnt_type & cnt)
+	{
+		local_index max_n = 0;
+
+		#pragma omp parallel for reduction(max:max_n)
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+		{
+			local_index n = cnt.template get<0>(i);
+			max_n = (n > max_n)?n:max_n;
+		}
+
+		cl_n.resize(cnt.size());
+
+		if (max_n >= slot)
+		{
+			while (max_n >= slot)
+			{slot *= 2;}
+
+			// the content is rebuild, no need to copy
+			base cl_base_(slot * cl_n.size());
+			cl_base.swap(cl_base_);
+		}
+		else
+		{cl_base.resize(slot * cl_n.size());}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+		{cl_n.template get<0>(i) = cnt.template get<0>(i);}
+	}
+
+	/*! \brief Get the pointer to the first element of a cell
+	 *
+	 * \param cell cell id
+	 *
+	 * \return the pointer to the elements of the cell
+	 *
+	 */
+	inline local_index * getCellPointer(local_index cell)
+	{
+		return &cl_base.template get<0>(slot * cell);
+	}
+
 	/*! \brief Add an element to the cell
 	 *
 	 * \param cell_id id of the cell
@@ -431,7 +564,7 @@ public:
 	 * \return slot
 	 *
 	 */
-	const int & private_get_slot() const
+	const local_index & private_get_slot() const
 	{
 		return slot;
 	}
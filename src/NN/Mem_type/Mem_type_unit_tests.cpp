@@ -10,6 +10,7 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCsr.hpp"
 
 BOOST_AUTO_TEST_SUITE( Mem_type_test )
 
@@ -38,6 +39,91 @@ BOOST_AUTO_TEST_CASE ( Mem_type_check )
 	test_mem_type<Mem_fast<>>();
 	test_mem_type<Mem_bal<>>();
 	test_mem_type<Mem_mw<>>();
+	test_mem_type<Mem_csr<>>();
+}
+
+BOOST_AUTO_TEST_CASE ( Mem_type_csr_check )
+{
+	Mem_csr<> mem(1);
+	Mem_fast<> ref(16);
+
+	mem.init_to_zero(1,100);
+	ref.init_to_zero(16,100);
+
+	// add in random order, mixed with ordered insertion
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		size_t cell = (i % 3 == 0)?(i / 100):(rand() % 100);
+
+		mem.add(cell,i);
+		ref.add(cell,i);
+
+		// read in between, it force the construction
+		if (i % 1000 == 0)
+		{BOOST_REQUIRE_EQUAL(mem.getNelements(cell),ref.getNelements(cell));}
+	}
+
+	bool match = true;
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		match &= mem.getNelements(i) == ref.getNelements(i);
+		match &= (size_t)(&mem.getStopId(i) - &mem.getStartId(i)) == mem.getNelements(i);
+
+		for (size_t j = 0 ; j < mem.getNelements(i) && match == true ; j++)
+		{match &= mem.get(i,j) == ref.get(i,j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// remove an element
+
+	size_t n_c5 = mem.getNelements(5);
+	size_t n_c6 = mem.getNelements(6);
+	size_t e1 = mem.get(5,1);
+	mem.remove(5,0);
+
+	BOOST_REQUIRE_EQUAL(mem.getNelements(5),n_c5-1);
+	BOOST_REQUIRE_EQUAL(mem.getNelements(6),n_c6);
+	BOOST_REQUIRE_EQUAL(mem.get(5,0),e1);
+
+	// parallel construction
+
+	openfpm::vector<aggregate<size_t>> cell_ids;
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		cell_ids.add();
+		cell_ids.template get<0>(i) = rand() % 100;
+	}
+
+	Mem_csr<> mem2(1);
+	mem2.init_to_zero(1,100);
+	mem.init_to_zero(1,100);
+
+	for (size_t i = 0 ; i < cell_ids.size() ; i++)
+	{mem.add(cell_ids.template get<0>(i),i);}
+
+	mem2.construct_host(cell_ids);
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		match &= mem.getNelements(i) == mem2.getNelements(i);
+
+		for (size_t j = 0 ; j < mem.getNelements(i) && match == true ; j++)
+		{match &= mem.get(i,j) == mem2.get(i,j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// copy and clear
+
+	Mem_csr<> mem3(1);
+	mem3 = mem2;
+	mem2.clear();
+
+	BOOST_REQUIRE_EQUAL(mem2.getNelements(7),0ul);
+	BOOST_REQUIRE_EQUAL(mem3.getNelements(7),mem.getNelements(7));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
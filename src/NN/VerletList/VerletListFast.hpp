@@ -10,12 +10,23 @@
 
 #include "VerletNNIterator.hpp"
 #include "NN/CellList/CellList_util.hpp"
+#include "NN/CellList/NNdist_filter.hpp"
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
 
 #define VERLET_STARTING_NSLOT 128
 
+//! Under this number of particles the Verlet-list is constructed serially
+#ifndef VERLET_PAR_MIN_SIZE
+#define VERLET_PAR_MIN_SIZE 4096
+#endif
+
+//! Number of particles processed by a thread in one range during the parallel construction
+#define VERLET_PAR_CHUNK 256
 
 #define WITH_RADIUS 3
 
@@ -268,6 +279,146 @@ public:
 	}
 };
 
+/*! \brief Buffers retained across the parallel constructions of a Verlet-list
+ *
+ * \tparam local_index type of the local index
+ *
+ */
+template<typename local_index>
+struct verlet_host_buffers
+{
+	//! neighborhood gathered by each thread
+	openfpm::vector<openfpm::vector<local_index>> thr;
+
+	//! number of neighborhood particles for each particle
+	openfpm::vector<local_index> nn_cnt;
+
+	//! for each range of particles the thread that processed it
+	openfpm::vector<size_t> chunk_thr;
+
+	//! for each range of particles where it start in the buffer of the thread
+	openfpm::vector<size_t> chunk_start;
+};
+
+/*! \brief Construct the Verlet-list adding the neighborhood particle by particle
+ *
+ * \tparam is_parallel the memory can be constructed in parallel
+ *
+ */
+template<bool is_parallel>
+struct verlet_construct_host_impl
+{
+	/*! \brief Construct
+	 *
+	 * \param mem memory of the Verlet-list (already initialized with init_to_zero)
+	 * \param n number of particles
+	 * \param nn_f nn_f(i,add) call add(j) for each neighborhood particle j of i
+	 * \param buf buffers (unused)
+	 *
+	 */
+	template<typename Mem_type, typename nn_func>
+	static void construct(Mem_type & mem, size_t n, nn_func nn_f, verlet_host_buffers<typename Mem_type::local_index_type> & buf)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{nn_f(i,[&](typename Mem_type::local_index_type nnp){mem.addCell(i,nnp);});}
+	}
+};
+
+/*! \brief Construct the Verlet-list with multiple threads
+ *
+ * Each thread gather the neighborhood of ranges of particles in its own buffer and
+ * count the neighborhood particles of each particle. From the counts the memory is
+ * constructed (for Mem_csr a prefix sum) and in a second pass every range is copied
+ * from the buffer of the thread into its place
+ *
+ */
+template<>
+struct verlet_construct_host_impl<true>
+{
+	template<typename Mem_type, typename nn_func>
+	static void construct(Mem_type & mem, size_t n, nn_func nn_f, verlet_host_buffers<typename Mem_type::local_index_type> & buf)
+	{
+		typedef typename Mem_type::local_index_type local_index;
+
+		if (n < VERLET_PAR_MIN_SIZE)
+		{
+			verlet_construct_host_impl<false>::construct(mem,n,nn_f,buf);
+			return;
+		}
+
+		// The first neighborhood is visited serially, the cell-list can initialize
+		// lazy structures (like the neighborhood for a given radius) on the first access
+		nn_f(0,[](local_index nnp){});
+
+		size_t n_chunk = (n + VERLET_PAR_CHUNK - 1) / VERLET_PAR_CHUNK;
+
+		size_t n_thr = 1;
+#ifdef HAVE_OPENMP
+		n_thr = omp_get_max_threads();
+#endif
+
+		if (buf.thr.size() < n_thr)
+		{buf.thr.resize(n_thr);}
+
+		buf.nn_cnt.resize(n);
+		buf.chunk_thr.resize(n_chunk);
+		buf.chunk_start.resize(n_chunk);
+
+		#pragma omp parallel
+		{
+			size_t t = 0;
+#ifdef HAVE_OPENMP
+			t = omp_get_thread_num();
+#endif
+
+			openfpm::vector<local_index> & tb = buf.thr.get(t);
+			tb.clear();
+
+			// gather
+			#pragma omp for schedule(dynamic)
+			for (size_t c = 0 ; c < n_chunk ; c++)
+			{
+				size_t stop = std::min((c+1)*VERLET_PAR_CHUNK,n);
+
+				buf.chunk_thr.get(c) = t;
+				buf.chunk_start.get(c) = tb.size();
+
+				for (size_t i = c*VERLET_PAR_CHUNK ; i < stop ; i++)
+				{
+					size_t n_before = tb.size();
+
+					nn_f(i,[&](local_index nnp){tb.add(nnp);});
+
+					buf.nn_cnt.get(i) = tb.size() - n_before;
+				}
+			}
+
+			#pragma omp single
+			{mem.construct_host_count(buf.nn_cnt);}
+
+			// copy in place
+			#pragma omp for schedule(dynamic)
+			for (size_t c = 0 ; c < n_chunk ; c++)
+			{
+				size_t stop = std::min((c+1)*VERLET_PAR_CHUNK,n);
+
+				openfpm::vector<local_index> & src = buf.thr.get(buf.chunk_thr.get(c));
+				size_t s = buf.chunk_start.get(c);
+
+				for (size_t i = c*VERLET_PAR_CHUNK ; i < stop ; i++)
+				{
+					size_t n_nn = buf.nn_cnt.get(i);
+
+					if (n_nn == 0)	{continue;}
+
+					std::copy(&src.get(s),&src.get(s) + n_nn,mem.getCellPointer(i));
+					s += n_nn;
+				}
+			}
+		}
+	}
+};
+
 /*! \brief Class for Verlet list implementation
  *
  * * M = number of particles
@@ -311,6 +462,46 @@ private:
 	//! Interlal cell-list
 	CellListImpl cli;
 
+	//! Skin, the Verlet-list is constructed with r_cut + skin (0 = skin tracking disabled)
+	T skin = 0;
+
+	//! Cut-off radius (without skin)
+	T r_cut_skin = 0;
+
+	//! Positions of the particles when the reference was taken
+	vector_pos_type pos_ref;
+
+	//! For each particle, how much the skin is still available for its list
+	openfpm::vector<T> skin_p;
+
+	//! Displacement of each particle from the reference position
+	openfpm::vector<T> disp;
+
+	//! Maximum displacement of the particles in each cell
+	openfpm::vector<T> cell_disp;
+
+	//! Ghost marker when the reference was taken
+	size_t g_m_ref = 0;
+
+	//! Buffers for the parallel construction
+	verlet_host_buffers<typename Mem_type::local_index_type> par_buf;
+
+	/*! \brief Reset the reference positions and the skin of every particle
+	 *
+	 * \param pos vector of positions
+	 * \param g_m ghost marker
+	 *
+	 */
+	void resetSkinReference(const vector_pos_type & pos, size_t g_m)
+	{
+		pos_ref = pos;
+		g_m_ref = g_m;
+
+		skin_p.resize(g_m);
+		for (size_t i = 0 ; i < g_m ; i++)
+		{skin_p.get(i) = skin;}
+	}
+
 
 	/*! \brief Fill the cell-list with data
 	 *
@@ -384,6 +575,22 @@ private:
 		// square of the cutting radius
 		T r_cut2 = r_cut * r_cut;
 
+		if (type != VL_CRS_SYMMETRIC)
+		{
+			// the particles are 0 ... end-1 and each neighborhood is independent
+			auto nn_f = [&](size_t i, auto add)
+			{
+				Point<dim,T> xp = pos.template get<0>(i);
+
+				auto NN = NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::local_index_type>::get(it,pos,xp,i,cli,r_cut);
+
+				NN_filter_radius(NN,pos2,xp,r_cut2,add);
+			};
+
+			verlet_construct_host_impl<has_host_parallel_construct<Mem_type>::value>::construct(static_cast<Mem_type &>(*this),end,nn_f,par_buf);
+			return;
+		}
+
 		// iterate the particles
 		while (it.isNext())
 		{
@@ -429,26 +636,17 @@ private:
 		// square of the cutting radius
 		T r_cut2 = r_cut * r_cut;
 
-		// iterate the particles
-		for (size_t i = 0 ; i < g_m ; i++)
+		auto nn_f = [&](size_t i, auto add)
 		{
 			Point<dim,T> p = pos.template get<0>(i);
 
 			// Get the neighborhood of the particle
 			auto NN = cl.template getNNIteratorRadius<NO_CHECK>(cl.getCell(p),r_cut);
-			while (NN.isNext())
-			{
-				auto nnp = NN.get();
-
-				Point<dim,T> q = pos.template get<0>(nnp);
 
-				if (p.distance2(q) < r_cut2)
-					addPart(i,nnp);
+			NN_filter_radius(NN,pos,p,r_cut2,add);
+		};
 
-				// Next particle
-				++NN;
-			}
-		}
+		verlet_construct_host_impl<has_host_parallel_construct<Mem_type>::value>::construct(static_cast<Mem_type &>(*this),g_m,nn_f,par_buf);
 	}
 
 public:
@@ -635,6 +833,181 @@ public:
 		create(pos,pos,dom_c,anom_c,r_cut,g_m,cli,VL_CRS_SYMMETRIC);
 	}
 
+	/*! \brief Initialize a non-symmetric Verlet-list that track the displacement of the particles
+	 *
+	 * The Verlet-list is constructed with a radius r_cut + skin, and the positions are stored as
+	 * reference. updateSkin() rebuild the Verlet-list only when it is necessary.
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param dom Processor domain
+	 * \param r_cut cut-off radius
+	 * \param skin skin
+	 * \param pos vector of particle positions
+	 * \param g_m Indicate form which particles to construct the verlet list. For example
+	 * 			if we have 120 particles and g_m = 100, the Verlet list will be constructed only for the first
+	 * 			100 particles
+	 *
+	 */
+	void InitializeSkin(const Box<dim,T> & box, const Box<dim,T> & dom, T r_cut, T skin, vector_pos_type & pos, size_t g_m)
+	{
+		this->skin = skin;
+		r_cut_skin = r_cut;
+
+		Initialize(box,dom,r_cut + skin,pos,g_m,VL_NON_SYMMETRIC);
+
+		resetSkinReference(pos,g_m);
+	}
+
+	/*! \brief Update a Verlet-list initialized with InitializeSkin
+	 *
+	 * Each particle i has a remaining skin s_i (initially the full skin). The list of i is valid as
+	 * long as d_i + d_j <= s_i for every particle j, where d is the displacement from the reference
+	 * positions. When this does not hold (globally checked with the maximum displacement, so in
+	 * the common case when half of the skin is exceeded) the reference is moved to the current
+	 * positions. Only the particles whose skin would become smaller than half of the skin (considering
+	 * the displacements in the neighborhood cells) rebuild their list; the others keep it
+	 * with a reduced skin s_i - d_i - max_j(d_j).
+	 *
+	 * If the number of particles or the ghost marker changed, the Verlet-list is fully reconstructed
+	 *
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 *
+	 * \return the number of particles whose neighborhood has been reconstructed
+	 *
+	 */
+	size_t updateSkin(vector_pos_type & pos, size_t g_m)
+	{
+		T r_cut = r_cut_skin + skin;
+
+		if (pos.size() != pos_ref.size() || g_m != g_m_ref)
+		{
+			initCl(cli,pos,g_m,VL_NON_SYMMETRIC);
+
+			openfpm::vector<subsub_lin<dim>> anom_c;
+			openfpm::vector<size_t> dom_c;
+
+			create(pos,pos,dom_c,anom_c,r_cut,g_m,cli,VL_NON_SYMMETRIC);
+			resetSkinReference(pos,g_m);
+
+			return g_m;
+		}
+
+		// displacement of all the particles (ghost included)
+
+		disp.resize(pos.size());
+		T d_max = 0;
+
+		#pragma omp parallel for reduction(max:d_max)
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+			Point<dim,T> xr = pos_ref.template get<0>(i);
+
+			disp.get(i) = xp.distance(xr);
+			d_max = (disp.get(i) > d_max)?disp.get(i):d_max;
+		}
+
+		// check if any list is invalid
+
+		T excess = -1;
+
+		#pragma omp parallel for reduction(max:excess)
+		for (size_t i = 0 ; i < g_m ; i++)
+		{
+			T e = disp.get(i) + d_max - skin_p.get(i);
+			excess = (e > excess)?e:excess;
+		}
+
+		if (excess <= 0)
+		{return 0;}
+
+		// the lists must be updated, reconstruct the cell-list with the actual positions
+
+		initCl(cli,pos,g_m,VL_NON_SYMMETRIC);
+
+		cell_disp.resize(cli.getGrid().size());
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t c = 0 ; c < cli.getGrid().size() ; c++)
+		{
+			T dc = 0;
+			for (size_t k = 0 ; k < cli.getNelements(c) ; k++)
+			{
+				T d = disp.get(cli.get(c,k));
+				dc = (d > dc)?d:dc;
+			}
+
+			cell_disp.get(c) = dc;
+		}
+
+		const auto & NNc = cli.private_get_NNc_full();
+		T r_cut2 = r_cut * r_cut;
+		size_t n_rebuild = 0;
+
+		Mem_type mem(slot);
+		mem.init_to_zero(slot,g_m);
+
+		for (size_t i = 0 ; i < g_m ; i++)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+			size_t cell = cli.getCell(xp);
+
+			// maximum displacement of the particles that can interact with i
+			T d_nn = 0;
+			for (size_t k = 0 ; k < openfpm::math::pow(3,dim) ; k++)
+			{
+				T d = cell_disp.get(cell + NNc[k]);
+				d_nn = (d > d_nn)?d:d_nn;
+			}
+
+			T s_new = skin_p.get(i) - disp.get(i) - d_nn;
+
+			if (s_new < skin / 2)
+			{
+				auto NN = cli.template getNNIterator<NO_CHECK>(cell);
+
+				while (NN.isNext())
+				{
+					auto nnp = NN.get();
+
+					Point<dim,T> xq = pos.template get<0>(nnp);
+
+					if (xp.distance2(xq) < r_cut2)
+					{mem.addCell(i,nnp);}
+
+					++NN;
+				}
+
+				skin_p.get(i) = skin;
+				n_rebuild++;
+			}
+			else
+			{
+				for (size_t j = 0 ; j < Mem_type::getNelements(i) ; j++)
+				{mem.addCell(i,Mem_type::get(i,j));}
+
+				skin_p.get(i) = s_new;
+			}
+		}
+
+		Mem_type::swap(mem);
+
+		pos_ref = pos;
+
+		return n_rebuild;
+	}
+
+	/*! \brief Return the skin of the Verlet-list
+	 *
+	 * \return the skin (0 if the Verlet-list has not been initialized with InitializeSkin)
+	 *
+	 */
+	T getSkin() const
+	{
+		return skin;
+	}
+
 	/*! Initialize the verlet list from an already filled cell-list
 	 *
 	 * \param cli external Cell-list
@@ -777,6 +1150,12 @@ public:
 
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		r_cut_skin = vl.r_cut_skin;
+		pos_ref.swap(vl.pos_ref);
+		skin_p.swap(vl.skin_p);
+		g_m_ref = vl.g_m_ref;
+
 		return *this;
 	}
 
@@ -799,6 +1178,12 @@ public:
 		dp = vl.dp;
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		r_cut_skin = vl.r_cut_skin;
+		pos_ref = vl.pos_ref;
+		skin_p = vl.skin_p;
+		g_m_ref = vl.g_m_ref;
+
 		return *this;
 	}
 
@@ -846,6 +1231,12 @@ public:
 		size_t n_dec_tmp = vl.n_dec;
 		vl.n_dec = n_dec;
 		n_dec = n_dec_tmp;
+
+		std::swap(skin,vl.skin);
+		std::swap(r_cut_skin,vl.r_cut_skin);
+		pos_ref.swap(vl.pos_ref);
+		skin_p.swap(vl.skin_p);
+		std::swap(g_m_ref,vl.g_m_ref);
 	}
 
 	/*! \brief Get the Neighborhood iterator
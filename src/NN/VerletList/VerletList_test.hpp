@@ -473,6 +473,176 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_sM(SpaceB
 }
 
 
+/*! \brief Test the Verlet-list update with skin
+ *
+ * Half of the domain move and half is static, the Verlet-list must always contain
+ * all the particles inside r_cut
+ *
+ */
+template<typename VerS> void Verlet_list_skin()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	double r_cut = 0.1;
+	double skin = 0.03;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		Point<3,double> p;
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{p.get(k) = 0.05 + 0.9 * (double)rand() / RAND_MAX;}
+
+		pos.add(p);
+	}
+
+	VerS vl;
+	vl.InitializeSkin(box,box,r_cut,skin,pos,pos.size());
+
+	BOOST_REQUIRE_EQUAL(vl.getSkin(),skin);
+
+	size_t n_skip = 0;
+	size_t n_partial = 0;
+	bool match = true;
+
+	for (size_t s = 0 ; s < 30 ; s++)
+	{
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			if (pos.template get<0>(i)[0] > 0.5)	{continue;}
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{
+				double x = pos.template get<0>(i)[k] + 0.008 * ((double)rand() / RAND_MAX - 0.5);
+				pos.template get<0>(i)[k] = std::min(std::max(x,0.05),0.95);
+			}
+		}
+
+		size_t n_rebuild = vl.updateSkin(pos,pos.size());
+
+		n_skip += (n_rebuild == 0);
+		n_partial += (n_rebuild != 0 && n_rebuild < pos.size());
+
+		// all the particles inside r_cut must be in the list
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			openfpm::vector<size_t> nn;
+
+			for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+			{nn.add(vl.get(i,j));}
+
+			nn.sort();
+
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{
+				Point<3,double> xp = pos.get(i);
+
+				if (xp.distance(pos.get(j)) < r_cut)
+				{match &= std::binary_search(&nn.get(0),&nn.get(0) + nn.size(),j);}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(n_skip != 0);
+	BOOST_REQUIRE(n_partial != 0);
+}
+
+/*! \brief Check that two Verlet-lists contain the same neighborhoods in the same order
+ *
+ */
+template<typename VerS1, typename VerS2> bool Verlet_list_compare(VerS1 & vl1, VerS2 & vl2, size_t n)
+{
+	bool match = true;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		match &= vl1.getNNPart(i) == vl2.getNNPart(i);
+
+		if (match == false)	{break;}
+
+		for (size_t j = 0 ; j < vl1.getNNPart(i) ; j++)
+		{match &= vl1.get(i,j) == vl2.get(i,j);}
+	}
+
+	return match;
+}
+
+/*! \brief The Verlet-lists constructed in parallel must be equal to the one constructed serially
+ *
+ */
+template<typename VerS, typename VerS_s> void Verlet_list_parallel_construct()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	// enough particles to use the parallel construction
+	size_t n_part = 4*VERLET_PAR_MIN_SIZE;
+	double r_cut = 0.06;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	srand(0);
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		Point<3,double> p;
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{p.get(k) = 0.05 + 0.9 * (double)rand() / RAND_MAX;}
+
+		pos.add(p);
+	}
+
+	size_t g_m = n_part - 100;
+
+	// constructed serially
+	VerS_s vl_s;
+	VerS vl;
+
+	vl_s.Initialize(box,box,r_cut,pos,g_m);
+	vl.Initialize(box,box,r_cut,pos,g_m);
+
+	BOOST_REQUIRE_EQUAL(vl.size(),g_m);
+	BOOST_REQUIRE_EQUAL(Verlet_list_compare(vl,vl_s,g_m),true);
+
+	// reconstruction on the same object (retained buffers)
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{pos.template get<0>(i)[0] = 1.0 - pos.template get<0>(i)[0];}
+
+	vl_s.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+	vl.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+
+	BOOST_REQUIRE_EQUAL(Verlet_list_compare(vl,vl_s,g_m),true);
+
+	// symmetric
+	Ghost<3,double> ghost(r_cut);
+
+	vl_s.InitializeSym(box,box,ghost,r_cut,pos,g_m);
+	vl.InitializeSym(box,box,ghost,r_cut,pos,g_m);
+
+	BOOST_REQUIRE_EQUAL(Verlet_list_compare(vl,vl_s,g_m),true);
+
+	// with a radius bigger than the cell (the neighborhood is calculated lazily)
+	size_t div[3] = {10,10,10};
+	typename VerS::CellListImpl_ cl;
+	typename VerS_s::CellListImpl_ cl_s;
+	cl.Initialize(box,div,2);
+	cl_s.Initialize(box,div,2);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		cl.add(pos.get(i),i);
+		cl_s.add(pos.get(i),i);
+	}
+
+	vl_s.Initialize(cl_s,2*r_cut,pos,pos,g_m);
+	vl.Initialize(cl,2*r_cut,pos,pos,g_m);
+
+	BOOST_REQUIRE_EQUAL(Verlet_list_compare(vl,vl_s,g_m),true);
+}
+
 BOOST_AUTO_TEST_SUITE( VerletList_test )
 
 BOOST_AUTO_TEST_CASE( VerletList_use)
@@ -491,6 +661,28 @@ BOOST_AUTO_TEST_CASE( VerletList_use)
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( VerletList_skin_update)
+{
+	Verlet_list_skin<VerletList<3,double>>();
+	Verlet_list_skin<VerletList<3,double,Mem_csr<>>>();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_csr_use)
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+
+	Verlet_list_s<3,double,VerletList<3,double,Mem_csr<>,shift<3,double>>>(box);
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_parallel_construct)
+{
+	// Mem_bal does not have a parallel construction
+	typedef VerletList<3,double,Mem_bal<>,shift<3,double>> VerS_s;
+
+	Verlet_list_parallel_construct<VerletList<3,double,Mem_fast<>,shift<3,double>>,VerS_s>();
+	Verlet_list_parallel_construct<VerletList<3,double,Mem_csr<>,shift<3,double>>,VerS_s>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,200 @@
+/*
+ * VerletList_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_PERFORMANCE_VERLETLIST_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_PERFORMANCE_VERLETLIST_PERFORMANCE_TESTS_HPP_
+
+#include "NN/VerletList/VerletList.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Move the particles randomly, like in a molecular dynamic step
+ *
+ * \param pos particles
+ * \param dx maximum displacement in each direction
+ *
+ */
+static inline void vl_performance_move(openfpm::vector<Point<3,float>> & pos, float dx)
+{
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		for (size_t k = 0 ; k < 3 ; k++)
+		{
+			float x = pos.template get<0>(i)[k] + dx * ((float)rand() / RAND_MAX - 0.5f);
+			pos.template get<0>(i)[k] = std::min(std::max(x,0.05f),0.95f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( verletlist_performance )
+
+BOOST_AUTO_TEST_CASE(verletlist_performance_skin_update)
+{
+	size_t n_part = 256*1024;
+	size_t n_step = 50;
+	float r_cut = 0.02;
+	float skin = 0.004;
+
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	openfpm::vector<Point<3,float>> pos_start;
+	pos_start.resize(n_part);
+
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		for (size_t k = 0 ; k < 3 ; k++)
+		{pos_start.template get<0>(i)[k] = 0.05 + 0.9 * (float)rand() / RAND_MAX;}
+	}
+
+	// full reconstruction at every step
+
+	openfpm::vector<Point<3,float>> pos = pos_start;
+	size_t g_m = pos.size();
+
+	VerletList<3,float> vl;
+	vl.Initialize(box,box,r_cut,pos,g_m);
+
+	srand(0);
+	double t_full = 0.0;
+	for (size_t s = 0 ; s < n_step ; s++)
+	{
+		vl_performance_move(pos,0.0005);
+
+		timer t;
+		t.start();
+		vl.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+		t.stop();
+
+		t_full += t.getwct();
+	}
+
+	// update with skin
+
+	pos = pos_start;
+
+	VerletList<3,float> vl_s;
+	vl_s.InitializeSkin(box,box,r_cut,skin,pos,g_m);
+
+	srand(0);
+	double t_skin = 0.0;
+	size_t n_rebuild = 0;
+	for (size_t s = 0 ; s < n_step ; s++)
+	{
+		vl_performance_move(pos,0.0005);
+
+		timer t;
+		t.start();
+		n_rebuild += vl_s.updateSkin(pos,g_m);
+		t.stop();
+
+		t_skin += t.getwct();
+	}
+
+	std::cout << "Verlet-list update " << n_step << " steps, full: " << t_full << " s  skin: " << t_skin
+			  << " s  speedup: " << t_full / t_skin << "  lists rebuilt: " << (double)n_rebuild / g_m << " times" << std::endl;
+}
+
+/*! \brief Time the construction of a Verlet-list
+ *
+ * \tparam VerS Verlet-list
+ *
+ * \param pos particles
+ * \param r_cut cut-off radius
+ * \param mean output mean time
+ * \param dev output standard deviation
+ * \param n_nn output total number of neighborhood particles
+ *
+ */
+template<typename VerS>
+void vl_performance_construct(openfpm::vector<Point<3,float>> & pos, float r_cut, double & mean, double & dev, size_t & n_nn)
+{
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t g_m = pos.size();
+
+	VerS vl;
+	vl.Initialize(box,box,r_cut,pos,g_m);
+
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+		vl.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+		t.stop();
+
+		times.add(t.getwct());
+	}
+
+	standard_deviation(times,mean,dev);
+
+	n_nn = 0;
+	for (size_t i = 0 ; i < g_m ; i++)
+	{n_nn += vl.getNNPart(i);}
+}
+
+BOOST_AUTO_TEST_CASE(verletlist_performance_construct)
+{
+	size_t n_part = 256*1024;
+	float r_cut = 0.03;
+
+	openfpm::vector<Point<3,float>> pos;
+	pos.resize(n_part);
+
+	srand(0);
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		for (size_t k = 0 ; k < 3 ; k++)
+		{pos.template get<0>(i)[k] = 0.05 + 0.9 * (float)rand() / RAND_MAX;}
+	}
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	// the reference is serial and single thread
+	double mean_s, dev_s;
+	size_t n_nn_s;
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(1);
+#endif
+	vl_performance_construct<VerletList<3,float,Mem_bal<unsigned int>>>(pos,r_cut,mean_s,dev_s,n_nn_s);
+
+	std::cout << "Verlet-list construction " << n_part << " particles, " << (double)n_nn_s / n_part << " neighbors per particle" << std::endl;
+	std::cout << "    serial (Mem_bal): " << mean_s << " s (dev " << dev_s << ")  " << n_part / mean_s << " particles/s" << std::endl;
+
+	// 1,2,4 ... threads, the last one is always max_threads
+	for (size_t nt = 1 ; nt <= max_threads ; nt = (nt < max_threads && 2*nt > max_threads)?max_threads:2*nt)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		double mean_f, dev_f, mean_c, dev_c;
+		size_t n_nn_f, n_nn_c;
+
+		vl_performance_construct<VerletList<3,float,Mem_fast<HeapMemory,unsigned int>>>(pos,r_cut,mean_f,dev_f,n_nn_f);
+		vl_performance_construct<VerletList<3,float,Mem_csr<HeapMemory,unsigned int>>>(pos,r_cut,mean_c,dev_c,n_nn_c);
+
+		BOOST_REQUIRE_EQUAL(n_nn_f,n_nn_s);
+		BOOST_REQUIRE_EQUAL(n_nn_c,n_nn_s);
+
+		std::cout << "    threads: " << nt << "  Mem_fast: " << mean_f << " s (dev " << dev_f << ")  speedup: " << mean_s / mean_f
+				  << "  Mem_csr: " << mean_c << " s (dev " << dev_c << ")  speedup: " << mean_s / mean_c << std::endl;
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_PERFORMANCE_VERLETLIST_PERFORMANCE_TESTS_HPP_ */
@@ -0,0 +1,810 @@
+/*
+ * Pack_checkpoint.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_CHECKPOINT_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_CHECKPOINT_HPP_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Packer_Unpacker/Pack_segments.hpp"
+#include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+
+//! Version of the checkpoint format
+#define CHECKPOINT_VERSION 2
+
+//! Alignment of the objects and of the property sections in the checkpoint file
+#define CHECKPOINT_ALIGN 4096
+
+//! Maximum size of a single write
+#define CHECKPOINT_MAX_WRITE (1ul << 30)
+
+//! The segment is a header, its values are stored in the object descriptor
+#define CHECKPOINT_SEG_HEADER 1
+
+//! The segment is the next component of the array property of the previous segment
+#define CHECKPOINT_SEG_COMPONENT 2
+
+//! The data of the object are stored with the memory_traits_lin layout
+#define CHECKPOINT_LAYOUT_LIN 1
+
+//! The data of the object are stored with the memory_traits_inte layout (a section for each property)
+#define CHECKPOINT_LAYOUT_INTE 2
+
+/*! \brief Header of a checkpoint file
+ *
+ * A checkpoint file is a sequence of objects, each one starting at an offset multiple of
+ * CHECKPOINT_ALIGN. An object is an object descriptor (checkpoint_object_header), the
+ * table of its segments (checkpoint_segment), the values of its header segments and then
+ * the data segments. Every property section (the data of a property with memory_traits_inte,
+ * all the components of an array property are consecutive, or the full array of objects with
+ * memory_traits_lin) start at an offset multiple of CHECKPOINT_ALIGN, so a mapping of the file
+ * can be used directly as memory of the data-structures
+ *
+ */
+struct checkpoint_file_header
+{
+	//! "OFPMCKPT"
+	char magic[8];
+
+	//! version of the format
+	size_t version;
+
+	//! number of objects
+	size_t n_obj;
+
+	//! alignment of the sections
+	size_t align;
+};
+
+//! Descriptor of an object in a checkpoint file
+struct checkpoint_object_header
+{
+	//! "OFPMOBJ"
+	char magic[8];
+
+	//! 1 vector, 2 grid, 3 other (sparse grid)
+	size_t kind;
+
+	//! dimensionality
+	size_t dim;
+
+	//! number of properties
+	size_t max_prop;
+
+	//! size of an element
+	size_t size_obj;
+
+	//! CHECKPOINT_LAYOUT_LIN or CHECKPOINT_LAYOUT_INTE
+	size_t layout;
+
+	//! number of segments
+	size_t n_seg;
+
+	//! number of header values
+	size_t n_hdr;
+
+	//! offset of the next object
+	size_t next;
+};
+
+//! Segment of an object in a checkpoint file
+struct checkpoint_segment
+{
+	//! size in byte
+	size_t size;
+
+	//! offset in the file for data segments, position in the header values for header segments
+	size_t offset;
+
+	//! CHECKPOINT_SEG_HEADER and CHECKPOINT_SEG_COMPONENT
+	size_t flags;
+};
+
+/*! \brief Round to the alignment of the checkpoint sections
+ *
+ * \param n offset
+ *
+ * \return n rounded up
+ *
+ */
+static inline size_t checkpoint_align(size_t n)
+{
+	return (n + CHECKPOINT_ALIGN - 1) / CHECKPOINT_ALIGN * CHECKPOINT_ALIGN;
+}
+
+/*! \brief Kind and dimensionality of a data-structure stored in a checkpoint
+ *
+ * \tparam obj_type data-structure
+ * \tparam is_vec true if the data-structure is a vector
+ *
+ */
+template<typename obj_type, bool is_vec = is_vector<obj_type>::value>
+struct checkpoint_info
+{
+	//! kind of the data-structure
+	static const size_t kind = 1;
+
+	//! dimensionality
+	static const size_t dim = 1;
+};
+
+//! Grids and sparse grids
+template<typename obj_type>
+struct checkpoint_info<obj_type,false>
+{
+	//! kind of the data-structure
+	static const size_t kind = (is_grid<obj_type>::value)?2:3;
+
+	//! dimensionality
+	static const size_t dim = obj_type::dims;
+};
+
+/*! \brief Memory layout of a data-structure stored in a checkpoint
+ *
+ * \tparam obj_type openfpm::vector or grid_base
+ *
+ */
+template<typename obj_type>
+struct checkpoint_layout
+{
+	//! layout
+	static const size_t value = (is_layout_inte<typename obj_type::layout_base_>::value)?CHECKPOINT_LAYOUT_INTE:CHECKPOINT_LAYOUT_LIN;
+};
+
+template<unsigned int dim, typename T, typename S, typename grid_lin, typename layout, template<typename> class layout_base, typename chunking, typename chunk_index>
+class sgrid_cpu;
+
+//! Sparse grid, the layout is the one of the chunks
+template<unsigned int dim, typename T, typename S, typename grid_lin, typename layout, template<typename> class layout_base, typename chunking, typename chunk_index>
+struct checkpoint_layout<sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking,chunk_index>>
+{
+	//! layout
+	static const size_t value = (is_layout_inte<layout_base<T>>::value)?CHECKPOINT_LAYOUT_INTE:CHECKPOINT_LAYOUT_LIN;
+};
+
+/*! \brief Streaming writer of checkpoint files
+ *
+ * Every data-structure is written directly from its memory using the segments produced by
+ * packSegments, no pack buffer is allocated. Supported data-structures are openfpm::vector,
+ * grid_base and sgrid_cpu, the objects must be read back in the same order with Checkpoint_reader
+ *
+ * \snippet Packer_unit_tests.hpp Checkpoint write and restart
+ *
+ */
+class Checkpoint_writer
+{
+	//! file descriptor
+	int fd = -1;
+
+	//! current offset in the file
+	size_t pos = 0;
+
+	//! number of objects written
+	size_t n_obj = 0;
+
+	//! true if a write failed
+	bool failed = false;
+
+	/*! \brief Write a buffer
+	 *
+	 * \param ptr buffer
+	 * \param size size in byte
+	 *
+	 */
+	void write_all(const void * ptr, size_t size)
+	{
+		const char * p = (const char *)ptr;
+
+		while (size != 0 && failed == false)
+		{
+			ssize_t w = ::write(fd,p,(size < CHECKPOINT_MAX_WRITE)?size:CHECKPOINT_MAX_WRITE);
+
+			if (w <= 0)
+			{
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " writing the checkpoint failed" << std::endl;
+				failed = true;
+				return;
+			}
+
+			p += w;
+			size -= w;
+			pos += w;
+		}
+	}
+
+	/*! \brief Write zeros until the offset off
+	 *
+	 * \param off offset
+	 *
+	 */
+	void pad(size_t off)
+	{
+		static const char zero[CHECKPOINT_ALIGN] = {0};
+
+		while (pos < off && failed == false)
+		{write_all(zero,(off - pos < CHECKPOINT_ALIGN)?off - pos:CHECKPOINT_ALIGN);}
+	}
+
+public:
+
+	//! destructor
+	~Checkpoint_writer()
+	{
+		close();
+	}
+
+	/*! \brief Create the checkpoint file
+	 *
+	 * \param file file name
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool open(const std::string & file)
+	{
+		close();
+
+		fd = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+		if (fd == -1)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " cannot create the checkpoint " << file << std::endl;
+			return false;
+		}
+
+		pos = 0;
+		n_obj = 0;
+		failed = false;
+
+		checkpoint_file_header fh;
+		memset(&fh,0,sizeof(fh));
+		memcpy(fh.magic,"OFPMCKPT",8);
+		fh.version = CHECKPOINT_VERSION;
+		fh.align = CHECKPOINT_ALIGN;
+
+		write_all(&fh,sizeof(fh));
+		pad(CHECKPOINT_ALIGN);
+
+		return failed == false;
+	}
+
+	/*! \brief Append a data-structure to the checkpoint
+	 *
+	 * \param obj data-structure (all the properties are written)
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	template<typename obj_type>
+	bool write(const obj_type & obj)
+	{
+		if (fd == -1)
+		{return false;}
+
+		Pack_segments segs;
+		obj.packSegments(segs);
+
+		std::vector<checkpoint_segment> tab(segs.size());
+		std::vector<size_t> hdr;
+
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			if (segs.isHeader(i) == true)
+			{
+				const size_t * h = (const size_t *)segs.getPointer(i);
+				hdr.insert(hdr.end(),h,h + segs.getSize(i) / sizeof(size_t));
+			}
+		}
+
+		checkpoint_object_header oh;
+		memset(&oh,0,sizeof(oh));
+		memcpy(oh.magic,"OFPMOBJ",8);
+		oh.kind = checkpoint_info<obj_type>::kind;
+		oh.dim = checkpoint_info<obj_type>::dim;
+		oh.max_prop = obj_type::value_type::max_prop;
+		oh.size_obj = sizeof(typename obj_type::value_type::type);
+		oh.layout = checkpoint_layout<obj_type>::value;
+		oh.n_seg = segs.size();
+		oh.n_hdr = hdr.size();
+
+		// place the segments, every property section start aligned
+
+		size_t off = pos + sizeof(oh) + tab.size()*sizeof(checkpoint_segment) + hdr.size()*sizeof(size_t);
+		size_t n_hdr = 0;
+
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			tab[i].size = segs.getSize(i);
+
+			if (segs.isHeader(i) == true)
+			{
+				tab[i].offset = n_hdr;
+				tab[i].flags = CHECKPOINT_SEG_HEADER;
+				n_hdr += segs.getSize(i) / sizeof(size_t);
+			}
+			else
+			{
+				off = (segs.isComponent(i) == true)?off:checkpoint_align(off);
+
+				tab[i].offset = off;
+				tab[i].flags = (segs.isComponent(i) == true)?CHECKPOINT_SEG_COMPONENT:0;
+				off += segs.getSize(i);
+			}
+		}
+
+		oh.next = checkpoint_align(off);
+
+		write_all(&oh,sizeof(oh));
+		write_all(tab.data(),tab.size()*sizeof(checkpoint_segment));
+		write_all(hdr.data(),hdr.size()*sizeof(size_t));
+
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			if (segs.isHeader(i) == true)
+			{continue;}
+
+			pad(tab[i].offset);
+			write_all(segs.getPointer(i),segs.getSize(i));
+		}
+
+		pad(oh.next);
+
+		n_obj++;
+
+		return failed == false;
+	}
+
+	/*! \brief Complete the checkpoint and close the file
+	 *
+	 * \return true if all the writes succeed
+	 *
+	 */
+	bool close()
+	{
+		if (fd == -1)
+		{return false;}
+
+		// the number of objects is written at the end
+		if (failed == false && pwrite(fd,&n_obj,sizeof(size_t),offsetof(checkpoint_file_header,n_obj)) != sizeof(size_t))
+		{failed = true;}
+
+		::close(fd);
+		fd = -1;
+
+		return failed == false;
+	}
+};
+
+/*! \brief For each property set the memory of a data-structure with memory_traits_inte layout
+ *         to its section in a mapped checkpoint
+ *
+ * \tparam obj_type data-structure
+ *
+ */
+template<typename obj_type>
+struct checkpoint_adopt_inte
+{
+	//! data-structure
+	obj_type & obj;
+
+	//! segments in the mapping
+	const Pack_segments & segs;
+
+	//! segment of the property
+	size_t id;
+
+	//! number of elements
+	size_t n;
+
+	/*! \brief constructor
+	 *
+	 * \param obj data-structure
+	 * \param segs segments in the mapping
+	 * \param id first data segment
+	 * \param n number of elements
+	 *
+	 */
+	checkpoint_adopt_inte(obj_type & obj, const Pack_segments & segs, size_t id, size_t n)
+	:obj(obj),segs(segs),id(id),n(n)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename obj_type::value_type T;
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef typename std::remove_all_extents<prop>::type base;
+
+		obj.template setMemory<tprp::value>(*new PtrMemory(const_cast<void *>(segs.getPointer(id)),n*sizeof(prop)));
+
+		id += sizeof(prop) / sizeof(base);
+	}
+};
+
+/*! \brief Check that the data segments of a mapped object match the expected ones
+ *
+ * The components of an array property must also be consecutive in the mapping, because they
+ * are used as a single section
+ *
+ * \param segs segments in the mapping
+ * \param id first data segment
+ * \param exp expected segments
+ *
+ * \return true if the segments match
+ *
+ */
+static inline bool checkpoint_check_segments(const Pack_segments & segs, size_t id, const Pack_segments & exp)
+{
+	bool match = (id + exp.size() == segs.size()) && pack_segments_check(segs,id,exp);
+
+	for (size_t i = 0 ; i < exp.size() && match == true ; i++)
+	{
+		if (exp.isComponent(i) == true)
+		{match &= (const char *)segs.getPointer(id + i) == (const char *)segs.getPointer(id + i - 1) + segs.getSize(id + i - 1);}
+	}
+
+	if (match == false)
+	{std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the segments in the checkpoint do not match the data-structure" << std::endl;}
+
+	return match;
+}
+
+/*! \brief Set the memory of a data-structure to its sections in a mapped checkpoint
+ *
+ * \tparam is_inte true if the layout is memory_traits_inte
+ *
+ */
+template<bool is_inte>
+struct checkpoint_adopt_impl
+{
+	/*! \brief Expected data segments
+	 *
+	 * \param exp expected segments
+	 * \param n number of elements
+	 *
+	 */
+	template<typename obj_type>
+	static void expected(Pack_segments & exp, size_t n)
+	{
+		pack_segments_impl<true,typename obj_type::value_type>::expected(exp,n);
+	}
+
+	/*! \brief Set the memory
+	 *
+	 * \param obj data-structure
+	 * \param segs segments in the mapping
+	 * \param id first data segment
+	 * \param n number of elements
+	 *
+	 */
+	template<typename obj_type>
+	static void set(obj_type & obj, const Pack_segments & segs, size_t id, size_t n)
+	{
+		checkpoint_adopt_inte<obj_type> ca(obj,segs,id,n);
+
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,obj_type::value_type::max_prop>>(ca);
+	}
+};
+
+//! With memory_traits_lin the data-structure is a single section
+template<>
+struct checkpoint_adopt_impl<false>
+{
+	/*! \brief Expected data segments
+	 *
+	 * \param exp expected segments
+	 * \param n number of elements
+	 *
+	 */
+	template<typename obj_type>
+	static void expected(Pack_segments & exp, size_t n)
+	{
+		pack_segments_impl<false,typename obj_type::value_type>::expected(exp,n);
+	}
+
+	/*! \brief Set the memory
+	 *
+	 * \param obj data-structure
+	 * \param segs segments in the mapping
+	 * \param id first data segment
+	 * \param n number of elements
+	 *
+	 */
+	template<typename obj_type>
+	static void set(obj_type & obj, const Pack_segments & segs, size_t id, size_t n)
+	{
+		obj.setMemory(*new PtrMemory(const_cast<void *>(segs.getPointer(id)),n*sizeof(typename obj_type::value_type::type)));
+	}
+};
+
+/*! \brief Reader of checkpoint files
+ *
+ * The file is mapped in memory (private mapping, modifications are not written back to the file).
+ * load() copy the next object into a data-structure, while adopt() set the memory of an
+ * openfpm::vector or a grid with PtrMemory to the sections of the mapping without copying.
+ * The reader must not be closed or destroyed while adopted data-structures are in use
+ *
+ */
+class Checkpoint_reader
+{
+	//! mapping of the file
+	char * map = NULL;
+
+	//! size of the file
+	size_t size = 0;
+
+	//! number of objects
+	size_t n_obj = 0;
+
+	//! offset of the next object
+	size_t pos = 0;
+
+	//! number of objects read
+	size_t n_read = 0;
+
+	/*! \brief Read the descriptor of the next object and build the segments that point to the mapping
+	 *
+	 * \tparam obj_type data-structure expected
+	 *
+	 * \param segs segments
+	 *
+	 * \return true if the next object is of the expected type
+	 *
+	 */
+	template<typename obj_type>
+	bool next(Pack_segments & segs)
+	{
+		if (map == NULL || n_read >= n_obj || pos + sizeof(checkpoint_object_header) > size)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " no more objects in the checkpoint" << std::endl;
+			return false;
+		}
+
+		checkpoint_object_header oh;
+		memcpy(&oh,map + pos,sizeof(oh));
+
+		if (memcmp(oh.magic,"OFPMOBJ",8) != 0 ||
+			oh.kind != checkpoint_info<obj_type>::kind ||
+			oh.dim != checkpoint_info<obj_type>::dim ||
+			oh.max_prop != obj_type::value_type::max_prop ||
+			oh.size_obj != sizeof(typename obj_type::value_type::type) ||
+			oh.layout != checkpoint_layout<obj_type>::value)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the object " << n_read << " in the checkpoint does not match the data-structure" << std::endl;
+			return false;
+		}
+
+		// the table and the header values must be inside the file
+		size_t left = size - pos - sizeof(oh);
+
+		if (oh.n_seg > left / sizeof(checkpoint_segment) ||
+			oh.n_hdr > (left - oh.n_seg*sizeof(checkpoint_segment)) / sizeof(size_t) ||
+			oh.next > size)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " truncated checkpoint" << std::endl;
+			return false;
+		}
+
+		const checkpoint_segment * tab = (const checkpoint_segment *)(map + pos + sizeof(oh));
+		const size_t * hdr = (const size_t *)(tab + oh.n_seg);
+
+		for (size_t i = 0 ; i < oh.n_seg ; i++)
+		{
+			bool inside;
+
+			if (tab[i].flags & CHECKPOINT_SEG_HEADER)
+			{inside = tab[i].offset <= oh.n_hdr && tab[i].size / sizeof(size_t) <= oh.n_hdr - tab[i].offset;}
+			else
+			{inside = tab[i].offset <= size && tab[i].size <= size - tab[i].offset;}
+
+			if (inside == false)
+			{
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " truncated checkpoint" << std::endl;
+				segs.clear();
+				return false;
+			}
+
+			if (tab[i].flags & CHECKPOINT_SEG_HEADER)
+			{segs.addHeader(hdr + tab[i].offset,tab[i].size / sizeof(size_t));}
+			else
+			{segs.add(map + tab[i].offset,tab[i].size,(tab[i].flags & CHECKPOINT_SEG_COMPONENT) != 0);}
+		}
+
+		pos = oh.next;
+		n_read++;
+
+		return true;
+	}
+
+public:
+
+	//! destructor
+	~Checkpoint_reader()
+	{
+		close();
+	}
+
+	/*! \brief Open and map a checkpoint file
+	 *
+	 * \param file file name
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool open(const std::string & file)
+	{
+		close();
+
+		int fd = ::open(file.c_str(),O_RDONLY);
+		if (fd == -1)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " cannot open the checkpoint " << file << std::endl;
+			return false;
+		}
+
+		struct stat st;
+		fstat(fd,&st);
+		size = st.st_size;
+
+		void * m = (size >= sizeof(checkpoint_file_header))?mmap(NULL,size,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0):MAP_FAILED;
+		::close(fd);
+
+		if (m == MAP_FAILED)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " cannot map the checkpoint " << file << std::endl;
+			size = 0;
+			return false;
+		}
+
+		map = (char *)m;
+
+		checkpoint_file_header fh;
+		memcpy(&fh,map,sizeof(fh));
+
+		if (memcmp(fh.magic,"OFPMCKPT",8) != 0 || fh.version != CHECKPOINT_VERSION || fh.align != CHECKPOINT_ALIGN)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " " << file << " is not a checkpoint of version " << CHECKPOINT_VERSION << std::endl;
+			close();
+			return false;
+		}
+
+		n_obj = fh.n_obj;
+		pos = CHECKPOINT_ALIGN;
+		n_read = 0;
+
+		return true;
+	}
+
+	//! Unmap the file
+	void close()
+	{
+		if (map != NULL)
+		{munmap(map,size);}
+
+		map = NULL;
+		size = 0;
+		n_obj = 0;
+	}
+
+	/*! \brief Return the number of objects in the checkpoint
+	 *
+	 * \return the number of objects
+	 *
+	 */
+	size_t getNObjects() const
+	{
+		return n_obj;
+	}
+
+	/*! \brief Copy the next object of the checkpoint into a data-structure
+	 *
+	 * \param obj openfpm::vector, grid_base or sgrid_cpu
+	 *
+	 * \return true if succeed, false if the object does not match the data-structure
+	 *
+	 */
+	template<typename obj_type>
+	bool load(obj_type & obj)
+	{
+		Pack_segments segs;
+		if (next<obj_type>(segs) == false)
+		{return false;}
+
+		size_t id = 0;
+		if (obj.unpackSegments(segs,id) == false)
+		{return false;}
+
+		return id == segs.size();
+	}
+
+	/*! \brief Use the memory of the checkpoint for the next object without copying
+	 *
+	 * The vector cannot grow over the restarted size
+	 *
+	 * \param v vector
+	 *
+	 * \return true if succeed, false if the object does not match the vector (v is not modified)
+	 *
+	 */
+	template<typename T, template<typename> class layout_base, typename grow_p>
+	bool adopt(openfpm::vector<T,PtrMemory,layout_base,grow_p,OPENFPM_NATIVE> & v)
+	{
+		typedef openfpm::vector<T,PtrMemory,layout_base,grow_p,OPENFPM_NATIVE> vtype;
+
+		Pack_segments segs;
+		if (next<vtype>(segs) == false)
+		{return false;}
+
+		const size_t * hdr = pack_segments_header(segs,0,1);
+		if (hdr == NULL)
+		{return false;}
+
+		size_t n = hdr[0];
+
+		Pack_segments exp;
+		checkpoint_adopt_impl<is_layout_inte<layout_base<T>>::value>::template expected<vtype>(exp,n);
+
+		if (checkpoint_check_segments(segs,1,exp) == false)
+		{return false;}
+
+		checkpoint_adopt_impl<is_layout_inte<layout_base<T>>::value>::set(v,segs,1,n);
+
+		// the vector use the external memory for the new size
+		v.resize(n,EXACT_RESIZE);
+
+		return true;
+	}
+
+	/*! \brief Use the memory of the checkpoint for the next object without copying
+	 *
+	 * \param g grid
+	 *
+	 * \return true if succeed, false if the object does not match the grid (g is not modified)
+	 *
+	 */
+	template<unsigned int dim, typename T, template<typename> class layout_base, typename ord_type>
+	bool adopt(grid_base_impl<dim,T,PtrMemory,layout_base,ord_type> & g)
+	{
+		typedef grid_base_impl<dim,T,PtrMemory,layout_base,ord_type> gtype;
+
+		Pack_segments segs;
+		if (next<gtype>(segs) == false)
+		{return false;}
+
+		size_t sz[dim];
+		const size_t * hdr = pack_segments_header(segs,0,dim);
+		if (hdr == NULL)
+		{return false;}
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = hdr[i];}
+
+		gtype tmp(sz);
+
+		Pack_segments exp;
+		checkpoint_adopt_impl<is_layout_inte<layout_base<T>>::value>::template expected<gtype>(exp,tmp.size());
+
+		if (checkpoint_check_segments(segs,1,exp) == false)
+		{return false;}
+
+		checkpoint_adopt_impl<is_layout_inte<layout_base<T>>::value>::set(tmp,segs,1,tmp.size());
+
+		g.swap(tmp);
+
+		return true;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_CHECKPOINT_HPP_ */
@@ -0,0 +1,663 @@
+/*
+ * Pack_compress.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_COMPRESS_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_COMPRESS_HPP_
+
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/int.hpp>
+#include "memory/ExtPreAlloc.hpp"
+#include "util/Pack_stat.hpp"
+
+//! The blocks are stored as they are
+#define PACK_COMPRESS_NONE 0
+
+//! The blocks are byte-shuffled and compressed with the built-in LZ compressor
+#define PACK_COMPRESS_SHUFFLE_LZ 1
+
+//! Bits of the hash table of the LZ compressor
+#define PACK_LZ_HASH_BITS 14
+
+//! Minimum length of a match of the LZ compressor
+#define PACK_LZ_MIN_MATCH 4
+
+//! Maximum distance of a match of the LZ compressor
+#define PACK_LZ_MAX_OFFSET 65535
+
+/*! \brief Size of a block rounded to a multiple of 8 byte (the blocks are aligned)
+ *
+ * \param n size
+ *
+ * \return n rounded
+ *
+ */
+static inline size_t pack_compress_pad(size_t n)
+{
+	return (n + 7) & ~((size_t)7);
+}
+
+/*! \brief Byte shuffle, byte b of the element e is moved at b*n_ele + e
+ *
+ * The bytes that does not form a complete element are copied at the end
+ *
+ * \param src source
+ * \param n size in byte
+ * \param elem size of the element
+ * \param dst destination
+ *
+ */
+static inline void pack_byte_shuffle(const unsigned char * src, size_t n, size_t elem, unsigned char * dst)
+{
+	size_t n_ele = n / elem;
+
+	for (size_t b = 0 ; b < elem ; b++)
+	{
+		for (size_t e = 0 ; e < n_ele ; e++)
+		{dst[b*n_ele + e] = src[e*elem + b];}
+	}
+
+	memcpy(dst + n_ele*elem,src + n_ele*elem,n - n_ele*elem);
+}
+
+/*! \brief Inverse of pack_byte_shuffle
+ *
+ * \param src source
+ * \param n size in byte
+ * \param elem size of the element
+ * \param dst destination
+ *
+ */
+static inline void pack_byte_unshuffle(const unsigned char * src, size_t n, size_t elem, unsigned char * dst)
+{
+	size_t n_ele = n / elem;
+
+	for (size_t b = 0 ; b < elem ; b++)
+	{
+		for (size_t e = 0 ; e < n_ele ; e++)
+		{dst[e*elem + b] = src[b*n_ele + e];}
+	}
+
+	memcpy(dst + n_ele*elem,src + n_ele*elem,n - n_ele*elem);
+}
+
+/*! \brief Maximum size of the output of pack_lz_compress
+ *
+ * \param n size of the input
+ *
+ * \return the maximum size of the compressed data
+ *
+ */
+static inline size_t pack_lz_bound(size_t n)
+{
+	return n + n / 255 + 16;
+}
+
+/*! \brief Write a length that does not fit the 4 bits of the token
+ *
+ * \param dst output
+ * \param op position in the output
+ * \param len length minus 15
+ *
+ */
+static inline void pack_lz_write_len(unsigned char * dst, size_t & op, size_t len)
+{
+	while (len >= 255)
+	{
+		dst[op++] = 255;
+		len -= 255;
+	}
+
+	dst[op++] = len;
+}
+
+/*! \brief Write a sequence (literals followed by a match)
+ *
+ * \param src input
+ * \param lit first literal
+ * \param n_lit number of literals
+ * \param offset distance of the match
+ * \param m_len length of the match (0 for the last sequence that has only literals)
+ * \param dst output
+ * \param op position in the output
+ *
+ */
+static inline void pack_lz_write_seq(const unsigned char * src, size_t lit, size_t n_lit, size_t offset, size_t m_len, unsigned char * dst, size_t & op)
+{
+	size_t m_tok = (m_len == 0)?0:m_len - PACK_LZ_MIN_MATCH;
+
+	dst[op++] = ((n_lit < 15)?n_lit:15) << 4 | ((m_tok < 15)?m_tok:15);
+
+	if (n_lit >= 15)
+	{pack_lz_write_len(dst,op,n_lit - 15);}
+
+	memcpy(dst + op,src + lit,n_lit);
+	op += n_lit;
+
+	if (m_len == 0)
+	{return;}
+
+	dst[op++] = offset & 0xFF;
+	dst[op++] = offset >> 8;
+
+	if (m_tok >= 15)
+	{pack_lz_write_len(dst,op,m_tok - 15);}
+}
+
+/*! \brief Compress with a simple LZ77 (LZ4-like block format)
+ *
+ * The output is a list of sequences, each sequence is a token (4 bits number of literals, 4 bits
+ * length of the match), the literals, the distance of the match (2 byte) and the extensions of the
+ * lengths. The last sequence has only literals
+ *
+ * \param src input
+ * \param n size of the input
+ * \param dst output, it must have pack_lz_bound(n) byte
+ *
+ * \return the size of the compressed data
+ *
+ */
+static inline size_t pack_lz_compress(const unsigned char * src, size_t n, unsigned char * dst)
+{
+	std::vector<size_t> table(1 << PACK_LZ_HASH_BITS,(size_t)-1);
+
+	size_t ip = 0;
+	size_t anchor = 0;
+	size_t op = 0;
+
+	while (ip + PACK_LZ_MIN_MATCH <= n)
+	{
+		uint32_t seq;
+		memcpy(&seq,src + ip,sizeof(seq));
+
+		size_t h = (seq * 2654435761u) >> (32 - PACK_LZ_HASH_BITS);
+		size_t ref = table[h];
+		table[h] = ip;
+
+		if (ref != (size_t)-1 && ip - ref <= PACK_LZ_MAX_OFFSET && memcmp(src + ref,src + ip,PACK_LZ_MIN_MATCH) == 0)
+		{
+			size_t len = PACK_LZ_MIN_MATCH;
+			while (ip + len < n && src[ref + len] == src[ip + len])
+			{len++;}
+
+			pack_lz_write_seq(src,anchor,ip - anchor,ip - ref,len,dst,op);
+
+			ip += len;
+			anchor = ip;
+		}
+		else
+		{
+			// skip faster on data that does not compress
+			ip += 1 + ((ip - anchor) >> 6);
+		}
+	}
+
+	pack_lz_write_seq(src,anchor,n - anchor,0,0,dst,op);
+
+	return op;
+}
+
+/*! \brief Read a length extension
+ *
+ * \param src input
+ * \param n_c size of the input
+ * \param ip position in the input
+ * \param len length to extend
+ *
+ * \return false if the input is truncated
+ *
+ */
+static inline bool pack_lz_read_len(const unsigned char * src, size_t n_c, size_t & ip, size_t & len)
+{
+	unsigned char b;
+
+	do
+	{
+		if (ip >= n_c)
+		{return false;}
+
+		b = src[ip++];
+		len += b;
+	} while (b == 255);
+
+	return true;
+}
+
+/*! \brief Decompress the output of pack_lz_compress
+ *
+ * \param src compressed data
+ * \param n_c size of the compressed data
+ * \param dst output
+ * \param n size of the output
+ *
+ * \return false if the compressed data are corrupted
+ *
+ */
+static inline bool pack_lz_decompress(const unsigned char * src, size_t n_c, unsigned char * dst, size_t n)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < n_c)
+	{
+		unsigned char token = src[ip++];
+
+		size_t n_lit = token >> 4;
+		if (n_lit == 15 && pack_lz_read_len(src,n_c,ip,n_lit) == false)
+		{return false;}
+
+		if (ip + n_lit > n_c || op + n_lit > n)
+		{return false;}
+
+		memcpy(dst + op,src + ip,n_lit);
+		ip += n_lit;
+		op += n_lit;
+
+		// last sequence
+		if (ip == n_c)
+		{break;}
+
+		if (ip + 2 > n_c)
+		{return false;}
+
+		size_t offset = src[ip] | (src[ip+1] << 8);
+		ip += 2;
+
+		size_t m_len = token & 0xF;
+		if (m_len == 15 && pack_lz_read_len(src,n_c,ip,m_len) == false)
+		{return false;}
+
+		m_len += PACK_LZ_MIN_MATCH;
+
+		if (offset == 0 || offset > op || op + m_len > n)
+		{return false;}
+
+		// the match can overlap the output
+		for (size_t i = 0 ; i < m_len ; i++, op++)
+		{dst[op] = dst[op - offset];}
+	}
+
+	return op == n;
+}
+
+/*! \brief Size required to pack a block of n byte with pack_compress_block
+ *
+ * The compressed block is never bigger than the raw one, so the request is exact when compression is off
+ * and an upper bound otherwise
+ *
+ * \param n size of the block
+ *
+ * \return the size to request
+ *
+ */
+static inline size_t pack_compress_block_request(size_t n)
+{
+	return 3*sizeof(size_t) + pack_compress_pad(n);
+}
+
+/*! \brief Pack a block of data, optionally compressed
+ *
+ * The block is stored as (raw size, stored size, method) followed by the stored data padded to 8 byte.
+ * With PACK_COMPRESS_SHUFFLE_LZ the data are byte-shuffled (elem is the size of the element, the bytes
+ * of the same significance are grouped together) and compressed, if the compression does not reduce
+ * the size the block is stored raw
+ *
+ * \param mem preallocated memory where to pack
+ * \param src data
+ * \param n size of the data in byte
+ * \param elem size of the element used by the byte-shuffle
+ * \param opt PACK_COMPRESS_NONE or PACK_COMPRESS_SHUFFLE_LZ
+ * \param sts pack statistic
+ *
+ */
+template<typename Mem>
+void pack_compress_block(ExtPreAlloc<Mem> & mem, const void * src, size_t n, size_t elem, int opt, Pack_stat & sts)
+{
+	const unsigned char * data = (const unsigned char *)src;
+	size_t hdr[3] = {n,n,PACK_COMPRESS_NONE};
+
+	std::vector<unsigned char> shf;
+	std::vector<unsigned char> cmp;
+
+	if (opt == PACK_COMPRESS_SHUFFLE_LZ && n != 0)
+	{
+		shf.resize(n);
+		cmp.resize(pack_lz_bound(n));
+
+		pack_byte_shuffle(data,n,elem,&shf[0]);
+		size_t n_c = pack_lz_compress(&shf[0],n,&cmp[0]);
+
+		if (n_c < n)
+		{
+			data = &cmp[0];
+			hdr[1] = n_c;
+			hdr[2] = PACK_COMPRESS_SHUFFLE_LZ;
+		}
+	}
+
+	mem.allocate(sizeof(hdr) + pack_compress_pad(hdr[1]));
+	unsigned char * ptr = (unsigned char *)mem.getPointer();
+
+	memcpy(ptr,hdr,sizeof(hdr));
+	if (hdr[1] != 0)
+	{memcpy(ptr + sizeof(hdr),data,hdr[1]);}
+
+	sts.incReq();
+}
+
+/*! \brief Return the raw size of the next block without unpacking it
+ *
+ * \param mem memory from where to unpack
+ * \param ps unpack statistic
+ *
+ * \return the size of the data of the block, 0 if the buffer does not contain the block
+ *
+ */
+template<typename Mem>
+size_t unpack_compress_block_size(ExtPreAlloc<Mem> & mem, Unpack_stat & ps)
+{
+	if (ps.getOffset() > mem.size() || mem.size() - ps.getOffset() < 3*sizeof(size_t))
+	{return 0;}
+
+	size_t n;
+	memcpy(&n,mem.getPointerOffset(ps.getOffset()),sizeof(size_t));
+
+	return n;
+}
+
+/*! \brief Unpack a block packed with pack_compress_block
+ *
+ * \param mem memory from where to unpack
+ * \param ps unpack statistic
+ * \param dst where to unpack the data
+ * \param n expected size of the data
+ * \param elem size of the element used by the byte-shuffle
+ *
+ * \return false if the block does not match or is corrupted
+ *
+ */
+template<typename Mem>
+bool unpack_compress_block(ExtPreAlloc<Mem> & mem, Unpack_stat & ps, void * dst, size_t n, size_t elem)
+{
+	size_t hdr[3];
+
+	if (ps.getOffset() > mem.size() || mem.size() - ps.getOffset() < sizeof(hdr))
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the packed block is outside of the buffer" << std::endl;
+		return false;
+	}
+
+	const unsigned char * ptr = (const unsigned char *)mem.getPointerOffset(ps.getOffset());
+	memcpy(hdr,ptr,sizeof(hdr));
+
+	if (hdr[1] > mem.size() - ps.getOffset() - sizeof(hdr))
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the packed block has " << hdr[1] << " byte of data but the buffer end before" << std::endl;
+		return false;
+	}
+
+	ps.addOffset(sizeof(hdr) + pack_compress_pad(hdr[1]));
+
+	if (hdr[0] != n)
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the packed block has size " << hdr[0] << " but " << n << " is expected" << std::endl;
+		return false;
+	}
+
+	if (n == 0)
+	{return true;}
+
+	if (hdr[2] == PACK_COMPRESS_NONE)
+	{
+		if (hdr[1] != n)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the uncompressed block has " << hdr[1] << " byte of data but " << n << " are expected" << std::endl;
+			return false;
+		}
+
+		memcpy(dst,ptr + sizeof(hdr),n);
+		return true;
+	}
+
+	std::vector<unsigned char> shf(n);
+
+	if (pack_lz_decompress(ptr + sizeof(hdr),hdr[1],&shf[0],n) == false)
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " corrupted compressed block" << std::endl;
+		return false;
+	}
+
+	pack_byte_unshuffle(&shf[0],n,elem,(unsigned char *)dst);
+
+	return true;
+}
+
+/*! \brief Access to the components of a property for the compressed pack
+ *
+ * Array properties are packed one component after the other, each component is byte-shuffled
+ * with the size of the base type
+ *
+ * \tparam prop property type
+ *
+ */
+template<typename prop>
+struct pack_compress_prp
+{
+	//! base type
+	typedef prop base;
+
+	//! number of components
+	static const size_t n_comp = 1;
+
+	/*! \brief Return the component c
+	 *
+	 * \param v property
+	 * \param c component
+	 *
+	 * \return the component
+	 *
+	 */
+	template<typename vtype>
+	static inline vtype & comp(vtype & v, size_t c)
+	{
+		return v;
+	}
+};
+
+//! Array property
+template<typename prop, size_t N1>
+struct pack_compress_prp<prop[N1]>
+{
+	//! base type
+	typedef prop base;
+
+	//! number of components
+	static const size_t n_comp = N1;
+
+	/*! \brief Return the component c
+	 *
+	 * \param v property
+	 * \param c component
+	 *
+	 * \return the component
+	 *
+	 */
+	template<typename vtype>
+	static inline auto comp(vtype && v, size_t c) -> decltype(v[c])
+	{
+		return v[c];
+	}
+};
+
+/*! \brief For each property add the request of a compressed block of n elements
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct pack_compress_request_prp
+{
+	//! number of elements
+	size_t n;
+
+	//! request
+	size_t & req;
+
+	/*! \brief constructor
+	 *
+	 * \param n number of elements
+	 * \param req request
+	 *
+	 */
+	pack_compress_request_prp(size_t n, size_t & req)
+	:n(n),req(req)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+
+		req += pack_compress_block_request(n*sizeof(prop));
+	}
+};
+
+/*! \brief For each property gather all the points of a dense grid and pack them as a compressed block
+ *
+ * \tparam grid_type grid
+ * \tparam Mem memory
+ *
+ */
+template<typename grid_type, typename Mem>
+struct pack_compress_grid_prp
+{
+	//! grid
+	const grid_type & grid;
+
+	//! memory where to pack
+	ExtPreAlloc<Mem> & mem;
+
+	//! compression option
+	int opt;
+
+	//! pack statistic
+	Pack_stat & sts;
+
+	/*! \brief constructor
+	 *
+	 * \param grid grid
+	 * \param mem memory where to pack
+	 * \param opt compression option
+	 * \param sts pack statistic
+	 *
+	 */
+	pack_compress_grid_prp(const grid_type & grid, ExtPreAlloc<Mem> & mem, int opt, Pack_stat & sts)
+	:grid(grid),mem(mem),opt(opt),sts(sts)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename grid_type::value_type T;
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef pack_compress_prp<prop> sel;
+		typedef typename sel::base base;
+
+		std::vector<base> buf(grid.size()*sel::n_comp);
+
+		size_t k = 0;
+		for (size_t c = 0 ; c < sel::n_comp ; c++)
+		{
+			auto it = grid.getIterator();
+
+			while (it.isNext())
+			{
+				buf[k] = sel::comp(grid.template get<tprp::value>(it.get()),c);
+
+				++k;
+				++it;
+			}
+		}
+
+		pack_compress_block(mem,buf.data(),buf.size()*sizeof(base),sizeof(base),opt,sts);
+	}
+};
+
+/*! \brief For each property unpack a compressed block into all the points of a dense grid
+ *
+ * \tparam grid_type grid
+ * \tparam Mem memory
+ *
+ */
+template<typename grid_type, typename Mem>
+struct unpack_compress_grid_prp
+{
+	//! grid
+	grid_type & grid;
+
+	//! memory from where to unpack
+	ExtPreAlloc<Mem> & mem;
+
+	//! unpack statistic
+	Unpack_stat & ps;
+
+	//! false if a block does not match or is corrupted, the following blocks are skipped
+	bool ok = true;
+
+	/*! \brief constructor
+	 *
+	 * \param grid grid
+	 * \param mem memory from where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	unpack_compress_grid_prp(grid_type & grid, ExtPreAlloc<Mem> & mem, Unpack_stat & ps)
+	:grid(grid),mem(mem),ps(ps)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		if (ok == false)
+		{return;}
+
+		typedef typename grid_type::value_type T;
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef pack_compress_prp<prop> sel;
+		typedef typename sel::base base;
+
+		std::vector<base> buf(grid.size()*sel::n_comp);
+
+		if (unpack_compress_block(mem,ps,buf.data(),buf.size()*sizeof(base),sizeof(base)) == false)
+		{
+			ok = false;
+			return;
+		}
+
+		size_t k = 0;
+		for (size_t c = 0 ; c < sel::n_comp ; c++)
+		{
+			auto it = grid.getIterator();
+
+			while (it.isNext())
+			{
+				sel::comp(grid.template get<tprp::value>(it.get()),c) = buf[k];
+
+				++k;
+				++it;
+			}
+		}
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_COMPRESS_HPP_ */
@@ -0,0 +1,450 @@
+/*
+ * Pack_segments.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_
+
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/at.hpp>
+#include "util/variadic_to_vmpl.hpp"
+#include "util/for_each_ref.hpp"
+
+/*! \brief Segment of a scatter/gather pack
+ *
+ * Like an iovec it is a pointer and a size in byte
+ *
+ */
+struct pack_segment
+{
+	//! pointer to the data (unused for the header segments)
+	void * ptr;
+
+	//! size in byte
+	size_t size;
+
+	//! -1 for a data segment, otherwise position of the segment in the header buffer
+	long int hdr;
+
+	//! true if the segment is a component of the same array property of the previous segment
+	bool comp;
+};
+
+/*! \brief List of segments produced by a scatter/gather pack
+ *
+ * Instead of copying the properties into an ExtPreAlloc buffer, packSegments of openfpm::vector and
+ * grid_base append to this list a small header segment (the sizes of the data-structure) followed by
+ * one segment for each property (one for each component of array properties) pointing directly to the
+ * memory of the data-structure. The list can be given to writev, MPI_Type_create_hindexed ...
+ * On the receiving side unpackSegments read the same list, while placeSegments produce the list of
+ * the destinations so that the data can be received in place
+ *
+ * The header values are stored inside this object, the data segments are only valid until the
+ * data-structure that produced them is modified or resized
+ *
+ */
+class Pack_segments
+{
+	//! segments
+	std::vector<pack_segment> seg;
+
+	//! storage of the headers
+	std::vector<size_t> hdr;
+
+public:
+
+	/*! \brief Add a header segment, the values are copied
+	 *
+	 * \param h header values
+	 * \param n number of values
+	 *
+	 */
+	void addHeader(const size_t * h, size_t n)
+	{
+		pack_segment s;
+		s.ptr = NULL;
+		s.size = n*sizeof(size_t);
+		s.hdr = hdr.size();
+		s.comp = false;
+
+		hdr.insert(hdr.end(),h,h+n);
+		seg.push_back(s);
+	}
+
+	/*! \brief Add a data segment
+	 *
+	 * \param ptr pointer to the data
+	 * \param size size in byte
+	 * \param comp true if the segment is the next component of the array property of the previous segment
+	 *
+	 */
+	void add(void * ptr, size_t size, bool comp = false)
+	{
+		pack_segment s;
+		s.ptr = ptr;
+		s.size = size;
+		s.hdr = -1;
+		s.comp = comp;
+
+		seg.push_back(s);
+	}
+
+	/*! \brief Number of segments
+	 *
+	 * \return the number of segments
+	 *
+	 */
+	size_t size() const
+	{
+		return seg.size();
+	}
+
+	/*! \brief Pointer to the data of a segment
+	 *
+	 * \param i segment
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getPointer(size_t i)
+	{
+		return (seg[i].hdr == -1)?seg[i].ptr:(void *)&hdr[seg[i].hdr];
+	}
+
+	/*! \brief Pointer to the data of a segment
+	 *
+	 * \param i segment
+	 *
+	 * \return the pointer
+	 *
+	 */
+	const void * getPointer(size_t i) const
+	{
+		return (seg[i].hdr == -1)?seg[i].ptr:(const void *)&hdr[seg[i].hdr];
+	}
+
+	/*! \brief Size of a segment
+	 *
+	 * \param i segment
+	 *
+	 * \return the size in byte
+	 *
+	 */
+	size_t getSize(size_t i) const
+	{
+		return seg[i].size;
+	}
+
+	/*! \brief Return true if the segment is an header
+	 *
+	 * \param i segment
+	 *
+	 * \return true if the segment is an header
+	 *
+	 */
+	bool isHeader(size_t i) const
+	{
+		return seg[i].hdr != -1;
+	}
+
+	/*! \brief Return true if the segment is the next component of the array property of the previous segment
+	 *
+	 * \param i segment
+	 *
+	 * \return true if the segment continue the property of the previous segment
+	 *
+	 */
+	bool isComponent(size_t i) const
+	{
+		return seg[i].comp;
+	}
+
+	/*! \brief Total size of the segments
+	 *
+	 * \return the sum of the sizes in byte
+	 *
+	 */
+	size_t totalSize() const
+	{
+		size_t tot = 0;
+		for (size_t i = 0 ; i < seg.size() ; i++)
+		{tot += seg[i].size;}
+
+		return tot;
+	}
+
+	//! Remove all the segments
+	void clear()
+	{
+		seg.clear();
+		hdr.clear();
+	}
+};
+
+/*! \brief Sequence of the properties to pack in segments (all the properties if prp is empty)
+ *
+ * \tparam T aggregate
+ * \tparam prp properties
+ *
+ */
+template<typename T, int ... prp>
+struct pack_segments_prp
+{
+	//! properties
+	typedef typename to_boost_vmpl<prp...>::type type;
+
+	//! true if all the properties are selected in order
+	typedef boost::mpl::bool_<sizeof...(prp) == T::max_prop && is_contiguos<prp...>::type::value> all;
+};
+
+//! All the properties
+template<typename T>
+struct pack_segments_prp<T>
+{
+	//! properties
+	typedef boost::mpl::range_c<int,0,T::max_prop> type;
+
+	//! all the properties are selected
+	typedef boost::mpl::bool_<true> all;
+};
+
+/*! \brief For each property add the segments of a data-structure with memory_traits_inte layout
+ *
+ * Every component of an array property is stored as a separated array of the allocated size
+ * of the data-structure, so each component is a segment
+ *
+ * \tparam obj_type data-structure
+ * \tparam T aggregate
+ *
+ */
+template<typename obj_type, typename T>
+struct pack_segments_inte
+{
+	//! data-structure
+	obj_type & obj;
+
+	//! segments
+	Pack_segments & segs;
+
+	//! number of elements
+	size_t n;
+
+	//! number of allocated elements (distance between the components of an array property)
+	size_t cap;
+
+	/*! \brief constructor
+	 *
+	 * \param obj data-structure
+	 * \param segs segments
+	 * \param n number of elements
+	 * \param cap number of allocated elements
+	 *
+	 */
+	pack_segments_inte(obj_type & obj, Pack_segments & segs, size_t n, size_t cap)
+	:obj(obj),segs(segs),n(n),cap(cap)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef typename std::remove_all_extents<prop>::type base;
+
+		base * ptr = (base *)obj.template getPointer<tprp::value>();
+
+		for (size_t c = 0 ; c < sizeof(prop) / sizeof(base) ; c++)
+		{segs.add(ptr + c*cap,n*sizeof(base),c != 0);}
+	}
+};
+
+/*! \brief For each property add the segments (without data) that a data-structure with memory_traits_inte
+ *         layout and n elements produce
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct pack_segments_inte_expected
+{
+	//! segments
+	Pack_segments & segs;
+
+	//! number of elements
+	size_t n;
+
+	/*! \brief constructor
+	 *
+	 * \param segs segments
+	 * \param n number of elements
+	 *
+	 */
+	pack_segments_inte_expected(Pack_segments & segs, size_t n)
+	:segs(segs),n(n)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef typename std::remove_all_extents<prop>::type base;
+
+		for (size_t c = 0 ; c < sizeof(prop) / sizeof(base) ; c++)
+		{segs.add(NULL,n*sizeof(base),c != 0);}
+	}
+};
+
+/*! \brief Add the data segments of a data-structure
+ *
+ * \tparam is_inte true if the layout is memory_traits_inte
+ * \tparam T aggregate
+ * \tparam prp properties
+ *
+ */
+template<bool is_inte, typename T, int ... prp>
+struct pack_segments_impl
+{
+	/*! \brief Add the segments
+	 *
+	 * \param obj data-structure
+	 * \param segs segments
+	 * \param n number of elements
+	 * \param cap number of allocated elements
+	 *
+	 */
+	template<typename obj_type>
+	static void add(obj_type & obj, Pack_segments & segs, size_t n, size_t cap)
+	{
+		pack_segments_inte<obj_type,T> ps(obj,segs,n,cap);
+
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(ps);
+	}
+
+	/*! \brief Add the segments (without data) that a data-structure with n elements produce
+	 *
+	 * \param segs segments
+	 * \param n number of elements
+	 *
+	 */
+	static void expected(Pack_segments & segs, size_t n)
+	{
+		pack_segments_inte_expected<T> ps(segs,n);
+
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(ps);
+	}
+};
+
+//! With memory_traits_lin the data-structure is a single segment
+template<typename T, int ... prp>
+struct pack_segments_impl<false,T,prp...>
+{
+	static_assert(pack_segments_prp<T,prp...>::all::value,"With memory_traits_lin only all the properties can be packed in segments");
+
+	/*! \brief Add the segments
+	 *
+	 * \param obj data-structure
+	 * \param segs segments
+	 * \param n number of elements
+	 * \param cap number of allocated elements
+	 *
+	 */
+	template<typename obj_type>
+	static void add(obj_type & obj, Pack_segments & segs, size_t n, size_t cap)
+	{
+		segs.add((void *)obj.getPointer(),n*sizeof(typename T::type));
+	}
+
+	/*! \brief Add the segment (without data) that a data-structure with n elements produce
+	 *
+	 * \param segs segments
+	 * \param n number of elements
+	 *
+	 */
+	static void expected(Pack_segments & segs, size_t n)
+	{
+		segs.add(NULL,n*sizeof(typename T::type));
+	}
+};
+
+/*! \brief Return the header segment of a received list
+ *
+ * \param src received segments
+ * \param id header segment
+ * \param n number of values expected in the header
+ *
+ * \return the header values, NULL if the segment is missing or is not an header of n values
+ *
+ */
+static inline const size_t * pack_segments_header(const Pack_segments & src, size_t id, size_t n)
+{
+	if (id >= src.size() || src.isHeader(id) == false || src.getSize(id) != n*sizeof(size_t))
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the segment " << id << " is not an header of " << n << " values" << std::endl;
+		return NULL;
+	}
+
+	return (const size_t *)src.getPointer(id);
+}
+
+/*! \brief Check that a received list contains data segments with the sizes of the expected ones
+ *
+ * \param src received segments
+ * \param id first data segment in src
+ * \param exp expected segments
+ *
+ * \return false if the segments of src are missing or do not match the sizes of exp
+ *
+ */
+static inline bool pack_segments_check(const Pack_segments & src, size_t id, const Pack_segments & exp)
+{
+	if (id > src.size() || exp.size() > src.size() - id)
+	{
+		std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " " << exp.size() << " segments are expected from " << id << " but the list has " << src.size() << std::endl;
+		return false;
+	}
+
+	for (size_t i = 0 ; i < exp.size() ; i++)
+	{
+		if (src.isHeader(id + i) == true || src.getSize(id + i) != exp.getSize(i))
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the segment " << id + i << " has size " << src.getSize(id + i) << " but " << exp.getSize(i) << " is expected" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*! \brief Copy the data segments of a received list into the segments of the destination
+ *
+ * \param src received segments
+ * \param id first data segment in src, at the end the segment after the last copied
+ * \param dst destination segments
+ *
+ * \return false if the segments of src are missing or do not match the sizes of dst, in this
+ *         case nothing is copied
+ *
+ */
+static inline bool pack_segments_copy(const Pack_segments & src, size_t & id, Pack_segments & dst)
+{
+	if (pack_segments_check(src,id,dst) == false)
+	{return false;}
+
+	for (size_t i = 0 ; i < dst.size() ; i++, id++)
+	{
+		if (dst.getSize(i) != 0)
+		{memcpy(dst.getPointer(i),src.getPointer(id),dst.getSize(i));}
+	}
+
+	return true;
+}
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_ */
@@ -16,6 +16,7 @@
 #include <iostream>
 #include "Vector/vector_test_util.hpp"
 #include "data_type/aggregate.hpp"
+#include "Packer_Unpacker/Pack_checkpoint.hpp"
 
 BOOST_AUTO_TEST_SUITE( packer_unpacker )
 
@@ -361,6 +362,511 @@ BOOST_AUTO_TEST_CASE ( packer_memory_traits_inte )
 
 }
 
+BOOST_AUTO_TEST_CASE ( packer_segments_vector_grid )
+{
+	typedef aggregate<float,float[3],int> aggr;
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v;
+	openfpm::vector<aggr> v_lin;
+
+	// add grow the vector, so the capacity is bigger than the size
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i + 1;
+		v.template get<1>(i)[1] = i + 2;
+		v.template get<1>(i)[2] = i + 3;
+		v.template get<2>(i) = 5*i;
+
+		v_lin.add();
+		v_lin.template get<0>(i) = i;
+		v_lin.template get<2>(i) = 7*i;
+	}
+
+	size_t sz[3] = {16,17,18};
+	grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0);
+		g.template get<1>(key)[2] = key.get(1);
+		g.template get<2>(key) = key.get(2);
+
+		++it;
+	}
+
+	// three data-structures in the same list of segments
+	Pack_segments segs;
+	v.template packSegments<0,1>(segs);
+	v_lin.packSegments(segs);
+	g.template packSegments<1,2>(segs);
+
+	// vector: header + 1 + 3 components, vector lin: header + 1, grid: header + 3 components + 1
+	BOOST_REQUIRE_EQUAL(segs.size(),12ul);
+	BOOST_REQUIRE_EQUAL(segs.isHeader(0),true);
+	BOOST_REQUIRE_EQUAL(segs.isHeader(1),false);
+	BOOST_REQUIRE_EQUAL(segs.isHeader(5),true);
+	BOOST_REQUIRE_EQUAL(segs.isHeader(7),true);
+	BOOST_REQUIRE_EQUAL(segs.getSize(2),1000*sizeof(float));
+	BOOST_REQUIRE_EQUAL(segs.getSize(6),1000*sizeof(aggr::type));
+	BOOST_REQUIRE_EQUAL(segs.getSize(7),3*sizeof(size_t));
+	BOOST_REQUIRE_EQUAL(segs.totalSize(),sizeof(size_t) + 1000*4*sizeof(float) + sizeof(size_t) + 1000*sizeof(aggr::type)
+	                                     + 3*sizeof(size_t) + g.size()*(3*sizeof(float) + sizeof(int)));
+
+	// segments point to the data
+	BOOST_REQUIRE_EQUAL(segs.getPointer(1),&v.template get<0>(0));
+	BOOST_REQUIRE_EQUAL(segs.getPointer(3),&v.template get<1>(0)[1]);
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v2;
+	openfpm::vector<aggr> v2_lin;
+	grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type> g2;
+
+	size_t id = 0;
+	BOOST_REQUIRE_EQUAL((v2.template unpackSegments<0,1>(segs,id)),true);
+	BOOST_REQUIRE_EQUAL(v2_lin.unpackSegments(segs,id),true);
+	BOOST_REQUIRE_EQUAL((g2.template unpackSegments<1,2>(segs,id)),true);
+
+	BOOST_REQUIRE_EQUAL(id,segs.size());
+	BOOST_REQUIRE_EQUAL(v2.size(),1000ul);
+	BOOST_REQUIRE_EQUAL(v2_lin.size(),1000ul);
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),18ul);
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[1] == v.template get<1>(i)[1];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+
+		match &= v2_lin.template get<0>(i) == v_lin.template get<0>(i);
+		match &= v2_lin.template get<2>(i) == v_lin.template get<2>(i);
+	}
+
+	auto it2 = g.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+		match &= g2.template get<2>(key) == g.template get<2>(key);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// segments that do not match are rejected
+
+	grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type> g_err;
+	size_t id_err = 0;
+	BOOST_REQUIRE_EQUAL((g_err.template unpackSegments<1,2>(segs,id_err)),false);
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v_err;
+	id_err = 5;
+	BOOST_REQUIRE_EQUAL((v_err.template unpackSegments<0,1>(segs,id_err)),false);
+
+	// a failed unpack does not modify the destination
+	v_err.resize(10);
+	v_err.template get<0>(3) = 7.0;
+
+	Pack_segments segs_short;
+	v_lin.packSegments(segs_short);
+	id_err = 0;
+	BOOST_REQUIRE_EQUAL((v_err.template unpackSegments<0,1>(segs_short,id_err)),false);
+	BOOST_REQUIRE_EQUAL(v_err.size(),10ul);
+	BOOST_REQUIRE_EQUAL(v_err.template get<0>(3),7.0f);
+	BOOST_REQUIRE_EQUAL(id_err,0ul);
+
+	id_err = 2;
+	BOOST_REQUIRE_EQUAL((v_err.template unpackSegments<0,1>(segs_short,id_err)),false);
+
+	// receive in place, the data segments are copied directly into the destination
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v3;
+	Pack_segments dst;
+	v3.template placeSegments<0,1>(*(size_t *)segs.getPointer(0),dst);
+
+	BOOST_REQUIRE_EQUAL(dst.size(),4ul);
+
+	for (size_t i = 0 ; i < dst.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(dst.getSize(i),segs.getSize(i+1));
+		memcpy(dst.getPointer(i),segs.getPointer(i+1),dst.getSize(i));
+	}
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v3.template get<0>(i) == v.template get<0>(i);
+		match &= v3.template get<1>(i)[2] == v.template get<1>(i)[2];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE ( packer_compress_codec )
+{
+	// random data (not compressible), repetitive data and small sizes
+	std::vector<unsigned char> src(100000);
+	std::vector<unsigned char> cmp(pack_lz_bound(src.size()));
+	std::vector<unsigned char> dst(src.size());
+
+	for (size_t i = 0 ; i < src.size() ; i++)
+	{src[i] = rand();}
+
+	size_t n_c = pack_lz_compress(&src[0],src.size(),&cmp[0]);
+	BOOST_REQUIRE(n_c <= pack_lz_bound(src.size()));
+	BOOST_REQUIRE_EQUAL(pack_lz_decompress(&cmp[0],n_c,&dst[0],src.size()),true);
+	BOOST_REQUIRE(src == dst);
+
+	for (size_t i = 0 ; i < src.size() ; i++)
+	{src[i] = (i / 7) % 13;}
+
+	n_c = pack_lz_compress(&src[0],src.size(),&cmp[0]);
+	BOOST_REQUIRE(n_c < src.size() / 10);
+	BOOST_REQUIRE_EQUAL(pack_lz_decompress(&cmp[0],n_c,&dst[0],src.size()),true);
+	BOOST_REQUIRE(src == dst);
+
+	// a truncated stream is detected
+	BOOST_REQUIRE_EQUAL(pack_lz_decompress(&cmp[0],n_c / 2,&dst[0],src.size()),false);
+
+	for (size_t n = 1 ; n <= 20 ; n++)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{src[i] = (i % 3 == 0)?0:i;}
+
+		n_c = pack_lz_compress(&src[0],n,&cmp[0]);
+		BOOST_REQUIRE_EQUAL(pack_lz_decompress(&cmp[0],n_c,&dst[0],n),true);
+		BOOST_REQUIRE(std::equal(&src[0],&src[0] + n,&dst[0]));
+	}
+
+	// byte-shuffle of 8 byte elements with a tail
+	std::vector<unsigned char> shf(83);
+	pack_byte_shuffle(&src[0],83,8,&shf[0]);
+	pack_byte_unshuffle(&shf[0],83,8,&dst[0]);
+	BOOST_REQUIRE(std::equal(&src[0],&src[0] + 83,&dst[0]));
+}
+
+BOOST_AUTO_TEST_CASE ( packer_compress_grid )
+{
+	typedef aggregate<double,float[3],int> aggr;
+
+	size_t sz[3] = {32,33,34};
+	grid_cpu<3,aggr> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = 1.0 + 0.5*key.get(0);
+		g.template get<1>(key)[0] = key.get(1);
+		g.template get<1>(key)[1] = 0.0;
+		g.template get<1>(key)[2] = 2.0;
+		g.template get<2>(key) = key.get(2) / 4;
+
+		++it;
+	}
+
+	for (int opt = PACK_COMPRESS_NONE ; opt <= PACK_COMPRESS_SHUFFLE_LZ ; opt++)
+	{
+		size_t req = 0;
+		g.packRequestCompressed(req);
+
+		HeapMemory pmem;
+		ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+		mem.incRef();
+
+		Pack_stat sts;
+		g.packCompressed(mem,sts,opt);
+
+		if (opt == PACK_COMPRESS_SHUFFLE_LZ)
+		{BOOST_REQUIRE(mem.size() < g.size()*sizeof(aggr::type) / 4);}
+		else
+		{BOOST_REQUIRE_EQUAL(mem.size(),req);}
+
+		grid_cpu<3,aggr> g2;
+		Unpack_stat ps;
+		BOOST_REQUIRE_EQUAL(g2.unpackCompressed(mem,ps),true);
+
+		BOOST_REQUIRE_EQUAL(ps.getOffset(),mem.size());
+		BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),34ul);
+
+		bool match = true;
+		auto it2 = g.getIterator();
+		while (it2.isNext())
+		{
+			auto key = it2.get();
+
+			match &= g2.template get<0>(key) == g.template get<0>(key);
+			match &= g2.template get<1>(key)[0] == g.template get<1>(key)[0];
+			match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+			match &= g2.template get<2>(key) == g.template get<2>(key);
+
+			++it2;
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+
+		// the first block is the property 0, it does not match the property 1
+		Unpack_stat ps2;
+		BOOST_REQUIRE_EQUAL(g2.template unpackCompressed<1>(mem,ps2),false);
+
+		mem.decRef();
+		delete &mem;
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( packer_checkpoint_vector_grid )
+{
+	typedef aggregate<float,float[3],int> aggr;
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v;
+	openfpm::vector<aggr> v_lin;
+
+	// add grow the vector, so the capacity is bigger than the size
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i + 1;
+		v.template get<1>(i)[1] = i + 2;
+		v.template get<1>(i)[2] = i + 3;
+		v.template get<2>(i) = 5*i;
+
+		v_lin.add();
+		v_lin.template get<0>(i) = i;
+		v_lin.template get<1>(i)[1] = 3*i;
+		v_lin.template get<2>(i) = 7*i;
+	}
+
+	size_t sz[3] = {16,17,18};
+	grid_base<3,aggr,HeapMemory,typename memory_traits_inte<aggr>::type> g(sz);
+	grid_cpu<3,aggr> g_lin(sz);
+	g.setMemory();
+	g_lin.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0);
+		g.template get<1>(key)[2] = key.get(1);
+		g.template get<2>(key) = key.get(2);
+
+		g_lin.template get<1>(key)[0] = key.get(0) + key.get(1);
+
+		++it;
+	}
+
+	//! [Checkpoint write and restart]
+
+	Checkpoint_writer cw;
+	BOOST_REQUIRE_EQUAL(cw.open("packer_checkpoint_test.ckp"),true);
+	cw.write(v);
+	cw.write(v_lin);
+	cw.write(g);
+	cw.write(g_lin);
+	BOOST_REQUIRE_EQUAL(cw.close(),true);
+
+	// restart copying the data
+	Checkpoint_reader cr;
+	BOOST_REQUIRE_EQUAL(cr.open("packer_checkpoint_test.ckp"),true);
+	BOOST_REQUIRE_EQUAL(cr.getNObjects(),4ul);
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v2;
+	BOOST_REQUIRE_EQUAL(cr.load(v2),true);
+
+	// restart using the mapped memory of the checkpoint
+	openfpm::vector<aggr,PtrMemory,memory_traits_lin,openfpm::grow_policy_identity> v2_lin;
+	grid_base<3,aggr,PtrMemory,typename memory_traits_inte<aggr>::type> g2;
+	grid_base<3,aggr,PtrMemory,typename memory_traits_lin<aggr>::type> g2_lin;
+
+	cr.adopt(v2_lin);
+	cr.adopt(g2);
+	cr.adopt(g2_lin);
+
+	//! [Checkpoint write and restart]
+
+	// another object does not exist, a wrong type is rejected
+	openfpm::vector<aggr> v_err;
+	BOOST_REQUIRE_EQUAL(cr.load(v_err),false);
+
+	Checkpoint_reader cr2;
+	cr2.open("packer_checkpoint_test.ckp");
+	BOOST_REQUIRE_EQUAL(cr2.load(g),false);
+
+	BOOST_REQUIRE_EQUAL(v2.size(),1000ul);
+	BOOST_REQUIRE_EQUAL(v2_lin.size(),1000ul);
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),18ul);
+	BOOST_REQUIRE_EQUAL(g2_lin.getGrid().size(1),17ul);
+
+	// the sections are aligned
+	BOOST_REQUIRE_EQUAL((size_t)&v2_lin.template get<0>(0) % CHECKPOINT_ALIGN,0ul);
+	BOOST_REQUIRE_EQUAL((size_t)g2.template getPointer<1>() % CHECKPOINT_ALIGN,0ul);
+	BOOST_REQUIRE_EQUAL((size_t)g2.template getPointer<2>() % CHECKPOINT_ALIGN,0ul);
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(i) == v.template get<2>(i);
+
+		match &= v2_lin.template get<0>(i) == v_lin.template get<0>(i);
+		match &= v2_lin.template get<1>(i)[1] == v_lin.template get<1>(i)[1];
+		match &= v2_lin.template get<2>(i) == v_lin.template get<2>(i);
+	}
+
+	auto it2 = g.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<0>(key) == g.template get<0>(key);
+		match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+		match &= g2.template get<2>(key) == g.template get<2>(key);
+
+		match &= g2_lin.template get<1>(key)[0] == g_lin.template get<1>(key)[0];
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the mapping is private, the adopted data can be modified
+	g2.template get<0>(grid_key_dx<3>({1,1,1})) = -1.0;
+	BOOST_REQUIRE_EQUAL(g2.template get<0>(grid_key_dx<3>({1,1,1})),-1.0);
+
+	remove("packer_checkpoint_test.ckp");
+}
+
+/*! \brief Overwrite a value in a file
+ *
+ * \param file file name
+ * \param off offset
+ * \param val value to write
+ *
+ */
+static void packer_checkpoint_overwrite(const char * file, size_t off, size_t val)
+{
+	FILE * f = fopen(file,"r+b");
+	fseek(f,off,SEEK_SET);
+	fwrite(&val,sizeof(size_t),1,f);
+	fclose(f);
+}
+
+BOOST_AUTO_TEST_CASE ( packer_checkpoint_corrupted )
+{
+	typedef aggregate<float,float[3],int> aggr;
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v;
+	v.resize(5000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{v.template get<0>(i) = i;}
+
+	const char * file = "packer_checkpoint_corrupted.ckp";
+
+	// offset of the table of the segments of the first object, the segment 0 is the header
+	size_t tab = CHECKPOINT_ALIGN + sizeof(checkpoint_object_header);
+
+	for (size_t t = 0 ; t < 4 ; t++)
+	{
+		Checkpoint_writer cw;
+		cw.open(file);
+		cw.write(v);
+		cw.close();
+
+		if (t == 0)
+		{
+			// the file is truncated in the data of the last property
+			struct stat st;
+			stat(file,&st);
+			BOOST_REQUIRE_EQUAL(truncate(file,st.st_size - 1000),0);
+		}
+		else if (t == 1)
+		{
+			// the header point after the header values
+			packer_checkpoint_overwrite(file,tab + offsetof(checkpoint_segment,offset),3);
+		}
+		else if (t == 2)
+		{
+			// a data segment point outside of the file
+			packer_checkpoint_overwrite(file,tab + sizeof(checkpoint_segment) + offsetof(checkpoint_segment,offset),1ul << 40);
+		}
+		else
+		{
+			// a data segment is inside the file but smaller than the property
+			packer_checkpoint_overwrite(file,tab + sizeof(checkpoint_segment) + offsetof(checkpoint_segment,size),100);
+		}
+
+		Checkpoint_reader cr;
+		BOOST_REQUIRE_EQUAL(cr.open(file),true);
+
+		openfpm::vector<aggr,HeapMemory,memory_traits_inte> v2;
+		BOOST_REQUIRE_EQUAL(cr.load(v2),false);
+
+		Checkpoint_reader cr2;
+		cr2.open(file);
+
+		openfpm::vector<aggr,PtrMemory,memory_traits_inte,openfpm::grow_policy_identity> v3;
+		BOOST_REQUIRE_EQUAL(cr2.adopt(v3),false);
+	}
+
+	remove(file);
+}
+
+BOOST_AUTO_TEST_CASE ( packer_checkpoint_layout )
+{
+	typedef aggregate<float,float[3],int> aggr;
+
+	openfpm::vector<aggr> v;
+	v.resize(5000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{v.template get<0>(i) = i;}
+
+	const char * file = "packer_checkpoint_layout.ckp";
+
+	Checkpoint_writer cw;
+	cw.open(file);
+	cw.write(v);
+	cw.close();
+
+	// a memory_traits_lin checkpoint cannot be used with memory_traits_inte
+	Checkpoint_reader cr;
+	BOOST_REQUIRE_EQUAL(cr.open(file),true);
+
+	openfpm::vector<aggr,PtrMemory,memory_traits_inte,openfpm::grow_policy_identity> v_inte;
+	BOOST_REQUIRE_EQUAL(cr.adopt(v_inte),false);
+	BOOST_REQUIRE_EQUAL(v_inte.size(),0ul);
+
+	Checkpoint_reader cr2;
+	BOOST_REQUIRE_EQUAL(cr2.open(file),true);
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v2;
+	BOOST_REQUIRE_EQUAL(cr2.load(v2),false);
+
+	// with the same layout it work
+	Checkpoint_reader cr3;
+	BOOST_REQUIRE_EQUAL(cr3.open(file),true);
+
+	openfpm::vector<aggr,PtrMemory,memory_traits_lin,openfpm::grow_policy_identity> v_lin;
+	BOOST_REQUIRE_EQUAL(cr3.adopt(v_lin),true);
+	BOOST_REQUIRE_EQUAL(v_lin.size(),v.size());
+	BOOST_REQUIRE_EQUAL(v_lin.template get<0>(4999),4999.0f);
+
+	remove(file);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
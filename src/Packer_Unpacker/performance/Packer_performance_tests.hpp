@@ -0,0 +1,330 @@
+/*
+ * Packer_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PERFORMANCE_PACKER_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PERFORMANCE_PACKER_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
+#include "Packer_Unpacker/Pack_checkpoint.hpp"
+#include <fstream>
+#include "util/stat/common_statistics.hpp"
+
+/*! \brief Time of a pack into an ExtPreAlloc buffer followed by the unpack into another object
+ *
+ * \tparam prp properties to pack
+ *
+ * \param src object to pack
+ * \param dst object where to unpack
+ * \param mean output mean time
+ * \param dev output standard deviation
+ *
+ */
+template<int ... prp, typename obj_type>
+void packer_performance_copy(obj_type & src, obj_type & dst, double & mean, double & dev)
+{
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		size_t req = 0;
+		src.template packRequest<prp...>(req);
+
+		HeapMemory pmem;
+		ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+		mem.incRef();
+
+		Pack_stat sts;
+		src.template pack<prp...>(mem,sts);
+
+		Unpack_stat ps;
+		dst.template unpack<prp...>(mem,ps);
+
+		t.stop();
+		times.add(t.getwct());
+
+		mem.decRef();
+		delete &mem;
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+/*! \brief Time of a pack in segments followed by the unpack into another object
+ *
+ * \tparam prp properties to pack
+ *
+ * \param src object to pack
+ * \param dst object where to unpack
+ * \param mean output mean time
+ * \param dev output standard deviation
+ *
+ */
+template<int ... prp, typename obj_type>
+void packer_performance_segments(obj_type & src, obj_type & dst, double & mean, double & dev)
+{
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		Pack_segments segs;
+		src.template packSegments<prp...>(segs);
+
+		size_t id = 0;
+		bool ok = dst.template unpackSegments<prp...>(segs,id);
+
+		t.stop();
+		times.add(t.getwct());
+
+		BOOST_REQUIRE_EQUAL(ok,true);
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+BOOST_AUTO_TEST_SUITE( packer_performance )
+
+BOOST_AUTO_TEST_CASE(packer_performance_segments_vector_grid)
+{
+	typedef aggregate<double,double[3],double[3],int> aggr;
+
+	size_t n_ele = 2*1024*1024;
+	size_t sz_d = 128;
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v;
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v_c;
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v_s;
+
+	v.resize(n_ele);
+
+	for (size_t i = 0 ; i < n_ele ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i + 1;
+		v.template get<1>(i)[1] = i + 2;
+		v.template get<1>(i)[2] = i + 3;
+	}
+
+	size_t sz[3] = {sz_d,sz_d,sz_d};
+	grid_cpu<3,aggr> g(sz);
+	grid_cpu<3,aggr> g_c;
+	grid_cpu<3,aggr> g_s;
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0);
+		g.template get<1>(key)[0] = key.get(1);
+		g.template get<1>(key)[1] = key.get(2);
+		g.template get<1>(key)[2] = key.get(0);
+
+		++it;
+	}
+
+	double mean_vc, dev_vc, mean_vs, dev_vs, mean_gc, dev_gc, mean_gs, dev_gs;
+
+	packer_performance_copy<>(v,v_c,mean_vc,dev_vc);
+	packer_performance_segments<>(v,v_s,mean_vs,dev_vs);
+	packer_performance_copy<>(g,g_c,mean_gc,dev_gc);
+	packer_performance_segments<>(g,g_s,mean_gs,dev_gs);
+
+	double bytes_v = n_ele * sizeof(aggr::type);
+	double bytes_g = g.size() * sizeof(aggr::type);
+
+	std::cout << "Pack/unpack all the properties of aggregate<double,double[3],double[3],int>" << std::endl;
+	std::cout << "    vector (memory_traits_inte) " << n_ele << "  ExtPreAlloc: " << mean_vc << " s (dev " << dev_vc << ")  " << bytes_v / mean_vc / 1e9 << " GB/s"
+	          << "  segments: " << mean_vs << " s (dev " << dev_vs << ")  " << bytes_v / mean_vs / 1e9 << " GB/s  speedup: " << mean_vc / mean_vs << std::endl;
+	std::cout << "    grid (memory_traits_lin) " << sz_d << "^3  ExtPreAlloc: " << mean_gc << " s (dev " << dev_gc << ")  " << bytes_g / mean_gc / 1e9 << " GB/s"
+	          << "  segments: " << mean_gs << " s (dev " << dev_gs << ")  " << bytes_g / mean_gs / 1e9 << " GB/s  speedup: " << mean_gc / mean_gs << std::endl;
+
+	bool match = true;
+	for (size_t i = 0 ; i < n_ele ; i += 997)
+	{
+		match &= v_s.template get<0>(i) == v.template get<0>(i);
+		match &= v_s.template get<1>(i)[2] == v.template get<1>(i)[2];
+	}
+
+	auto it2 = g.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g_s.template get<1>(key)[1] == g.template get<1>(key)[1];
+		match &= g_c.template get<1>(key)[1] == g.template get<1>(key)[1];
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE(packer_performance_checkpoint)
+{
+	typedef aggregate<double,double[3],double[3],int> aggr;
+
+	size_t sz_d = 160;
+	size_t sz[3] = {sz_d,sz_d,sz_d};
+
+	grid_cpu<3,aggr> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0);
+		g.template get<1>(key)[1] = key.get(2);
+
+		++it;
+	}
+
+	openfpm::vector<double> t_pw, t_pr, t_cw, t_cl, t_ca, t_ct;
+	double sum = 0.0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		// pack into a buffer and write
+		timer t1;
+		t1.start();
+
+		size_t req = 0;
+		g.packRequest(req);
+
+		HeapMemory pmem;
+		ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+		mem.incRef();
+
+		Pack_stat sts;
+		g.pack(mem,sts);
+
+		std::ofstream dump("packer_performance.bin",std::ios::out | std::ios::binary);
+		dump.write((const char *)pmem.getPointer(),req);
+		dump.close();
+
+		t1.stop();
+		t_pw.add(t1.getwct());
+
+		mem.decRef();
+		delete &mem;
+
+		// read the buffer and unpack
+		timer t2;
+		t2.start();
+
+		{
+			HeapMemory pmem2;
+			ExtPreAlloc<HeapMemory> & mem2 = *(new ExtPreAlloc<HeapMemory>(req,pmem2));
+			mem2.incRef();
+
+			std::ifstream fs("packer_performance.bin",std::ios::in | std::ios::binary);
+			fs.read((char *)pmem2.getPointer(),req);
+
+			grid_cpu<3,aggr> g2;
+			Unpack_stat ps;
+			g2.unpack(mem2,ps);
+
+			sum += g2.template get<0>(grid_key_dx<3>({1,0,0}));
+
+			mem2.decRef();
+			delete &mem2;
+		}
+
+		t2.stop();
+		t_pr.add(t2.getwct());
+
+		// streaming checkpoint
+		timer t3;
+		t3.start();
+
+		Checkpoint_writer cw;
+		cw.open("packer_performance.ckp");
+		cw.write(g);
+		cw.close();
+
+		t3.stop();
+		t_cw.add(t3.getwct());
+
+		// restart with copy
+		timer t4;
+		t4.start();
+
+		{
+			Checkpoint_reader cr;
+			cr.open("packer_performance.ckp");
+
+			grid_cpu<3,aggr> g3;
+			cr.load(g3);
+
+			sum += g3.template get<0>(grid_key_dx<3>({1,0,0}));
+		}
+
+		t4.stop();
+		t_cl.add(t4.getwct());
+
+		// restart adopting the mapping, and first read of one property
+		Checkpoint_reader cr;
+
+		timer t5;
+		t5.start();
+
+		cr.open("packer_performance.ckp");
+
+		grid_base<3,aggr,PtrMemory,typename memory_traits_lin<aggr>::type> g4;
+		cr.adopt(g4);
+
+		t5.stop();
+		t_ca.add(t5.getwct());
+
+		timer t6;
+		t6.start();
+
+		auto it4 = g4.getIterator();
+		while (it4.isNext())
+		{
+			sum += g4.template get<0>(it4.get());
+			++it4;
+		}
+
+		t6.stop();
+		t_ct.add(t6.getwct());
+	}
+
+	double m_pw, d_pw, m_pr, d_pr, m_cw, d_cw, m_cl, d_cl, m_ca, d_ca, m_ct, d_ct;
+	standard_deviation(t_pw,m_pw,d_pw);
+	standard_deviation(t_pr,m_pr,d_pr);
+	standard_deviation(t_cw,m_cw,d_cw);
+	standard_deviation(t_cl,m_cl,d_cl);
+	standard_deviation(t_ca,m_ca,d_ca);
+	standard_deviation(t_ct,m_ct,d_ct);
+
+	double mb = g.size() * sizeof(aggr::type) / 1e6;
+
+	std::cout << "Checkpoint/restart grid " << sz_d << "^3 aggregate<double,double[3],double[3],int> (" << mb << " MB, file in page cache)" << std::endl;
+	std::cout << "    Packer + ofstream write: " << m_pw << " s (dev " << d_pw << ")  ifstream read + unpack: " << m_pr << " s (dev " << d_pr << ")" << std::endl;
+	std::cout << "    Checkpoint_writer: " << m_cw << " s (dev " << d_cw << ")  restart load: " << m_cl << " s (dev " << d_cl << ")  restart adopt: "
+	          << m_ca << " s (dev " << d_ca << ") + first read of one property " << m_ct << " s (dev " << d_ct << ")" << std::endl;
+
+	remove("packer_performance.bin");
+	remove("packer_performance.ckp");
+
+	BOOST_REQUIRE(sum != 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PERFORMANCE_PACKER_PERFORMANCE_TESTS_HPP_ */
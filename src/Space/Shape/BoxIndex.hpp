@@ -0,0 +1,443 @@
+/*
+ * BoxIndex.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_HPP_
+#define OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_HPP_
+
+#include <algorithm>
+#include "Space/Shape/Box.hpp"
+#include "Vector/map_vector.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+//! Maximum number of boxes in a leaf of BoxIndex
+#define BOX_INDEX_LEAF_SIZE 4
+
+//! Maximum depth of a BoxIndex (the median split give a depth of log2(n / BOX_INDEX_LEAF_SIZE))
+#define BOX_INDEX_MAX_DEPTH 64
+
+/*! \brief Node of a BoxIndex
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of the space
+ *
+ */
+template<unsigned int dim, typename T>
+struct box_index_node
+{
+	//! low corner of the bounding box of the node
+	T low[dim];
+
+	//! high corner of the bounding box of the node
+	T high[dim];
+
+	//! first child (the second is child+1), -1 for a leaf
+	long int child;
+
+	//! first box of the node (in the reordered boxes)
+	size_t start;
+
+	//! one after the last box of the node
+	size_t stop;
+};
+
+/*! \brief Box stored in a BoxIndex
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of the space
+ *
+ */
+template<unsigned int dim, typename T>
+struct box_index_entry
+{
+	//! low corner
+	T low[dim];
+
+	//! high corner
+	T high[dim];
+
+	//! id of the box in the original vector
+	size_t id;
+};
+
+/*! \brief Bounding volume hierarchy over a set of boxes
+ *
+ * It answer which boxes intersect a box (with the same rule of Box::Intersect, boxes that touch
+ * intersect) or contain a point (as Box::isInside). The tree is built in bulk with a median split
+ * along the longest axis of the centers, the boxes are reordered so that every leaf is contiguous
+ * in memory. The batched queries are distributed across the threads, every query is a traversal
+ * with a small stack and the tree is only read, so single queries can also be called concurrently
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of the space
+ *
+ * ### Build and query
+ * \snippet BoxIndex_unit_tests.hpp Build a BoxIndex and query
+ *
+ */
+template<unsigned int dim, typename T>
+class BoxIndex
+{
+	//! nodes (0 is the root)
+	openfpm::vector<box_index_node<dim,T>> nodes;
+
+	//! boxes reordered by leaf
+	openfpm::vector<box_index_entry<dim,T>> boxes;
+
+	/*! \brief Center of a box along a direction (times two)
+	 *
+	 * \param e box
+	 * \param d direction
+	 *
+	 * \return low + high
+	 *
+	 */
+	static inline T center2(const box_index_entry<dim,T> & e, size_t d)
+	{
+		return e.low[d] + e.high[d];
+	}
+
+	/*! \brief Create the node for the boxes in [start,stop) and its children
+	 *
+	 * \param n node
+	 * \param start first box
+	 * \param stop one after the last box
+	 * \param depth depth of the node
+	 *
+	 */
+	void build_node(size_t n, size_t start, size_t stop, size_t depth)
+	{
+		box_index_node<dim,T> & nd = nodes.get(n);
+
+		nd.start = start;
+		nd.stop = stop;
+		nd.child = -1;
+
+		// bounding box of the boxes and of their centers
+
+		T c_low[dim];
+		T c_high[dim];
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			nd.low[d] = boxes.get(start).low[d];
+			nd.high[d] = boxes.get(start).high[d];
+			c_low[d] = center2(boxes.get(start),d);
+			c_high[d] = c_low[d];
+		}
+
+		for (size_t i = start + 1 ; i < stop ; i++)
+		{
+			const box_index_entry<dim,T> & e = boxes.get(i);
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				nd.low[d] = std::min(nd.low[d],e.low[d]);
+				nd.high[d] = std::max(nd.high[d],e.high[d]);
+				c_low[d] = std::min(c_low[d],center2(e,d));
+				c_high[d] = std::max(c_high[d],center2(e,d));
+			}
+		}
+
+		if (stop - start <= BOX_INDEX_LEAF_SIZE || depth + 1 >= BOX_INDEX_MAX_DEPTH)
+		{return;}
+
+		// split at the median of the centers along the longest axis
+
+		size_t ax = 0;
+		for (size_t d = 1 ; d < dim ; d++)
+		{
+			if (c_high[d] - c_low[d] > c_high[ax] - c_low[ax])
+			{ax = d;}
+		}
+
+		size_t mid = (start + stop) / 2;
+
+		std::nth_element(&boxes.get(0) + start,&boxes.get(0) + mid,&boxes.get(0) + stop,
+						 [ax](const box_index_entry<dim,T> & a, const box_index_entry<dim,T> & b)
+						 {return center2(a,ax) < center2(b,ax);});
+
+		size_t child = nodes.size();
+		nodes.get(n).child = child;
+
+		// nd is invalid after the resize
+		nodes.resize(child + 2);
+
+		build_node(child,start,mid,depth + 1);
+		build_node(child + 1,mid,stop,depth + 1);
+	}
+
+	/*! \brief Check if the bounding box of a node or a box overlap a box
+	 *
+	 * \param low low corner
+	 * \param high high corner
+	 * \param b box
+	 *
+	 * \return true if they overlap
+	 *
+	 */
+	static inline bool overlap(const T (& low)[dim], const T (& high)[dim], const Box<dim,T> & b)
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			if (low[d] > b.getHigh(d) || high[d] < b.getLow(d))
+			{return false;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Check if the bounding box of a node or a box contain a point
+	 *
+	 * \param low low corner
+	 * \param high high corner
+	 * \param p point
+	 *
+	 * \return true if the point is inside
+	 *
+	 */
+	static inline bool overlap(const T (& low)[dim], const T (& high)[dim], const Point<dim,T> & p)
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			if (low[d] > p.get(d) || high[d] < p.get(d))
+			{return false;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Traverse the tree and call f for every box that overlap the query
+	 *
+	 * \param q query (Box or Point)
+	 * \param f function called with the id of the box
+	 *
+	 */
+	template<typename query_type, typename lambda_f>
+	inline void traverse(const query_type & q, lambda_f f) const
+	{
+		if (boxes.size() == 0)
+		{return;}
+
+		size_t stack[BOX_INDEX_MAX_DEPTH + 1];
+		size_t n_st = 0;
+
+		stack[n_st++] = 0;
+
+		while (n_st != 0)
+		{
+			const box_index_node<dim,T> & nd = nodes.get(stack[--n_st]);
+
+			if (overlap(nd.low,nd.high,q) == false)
+			{continue;}
+
+			if (nd.child != -1)
+			{
+				stack[n_st++] = nd.child + 1;
+				stack[n_st++] = nd.child;
+				continue;
+			}
+
+			for (size_t i = nd.start ; i < nd.stop ; i++)
+			{
+				const box_index_entry<dim,T> & e = boxes.get(i);
+
+				if (overlap(e.low,e.high,q) == true)
+				{f(e.id);}
+			}
+		}
+	}
+
+	/*! \brief Run a batch of queries in parallel
+	 *
+	 * \param q queries
+	 * \param start output, the result of the query i are ids[start.get(i)] ... ids[start.get(i+1)-1]
+	 * \param ids output ids of the boxes
+	 *
+	 */
+	template<typename query_type>
+	void traverse_batch(const openfpm::vector<query_type> & q, openfpm::vector<size_t> & start, openfpm::vector<size_t> & ids) const
+	{
+		size_t n_part = 1;
+
+#ifdef HAVE_OPENMP
+		n_part = std::max((size_t)1,std::min(q.size(),(size_t)omp_get_max_threads()));
+#endif
+
+		openfpm::vector<openfpm::vector<size_t>> loc;
+		loc.resize(n_part);
+
+		start.resize(q.size() + 1);
+		start.get(0) = 0;
+
+		// every part collect the results of a contiguous range of queries
+
+		#pragma omp parallel for schedule(static) if(n_part > 1)
+		for (size_t k = 0 ; k < n_part ; k++)
+		{
+			openfpm::vector<size_t> & l = loc.get(k);
+
+			for (size_t i = q.size() * k / n_part ; i < q.size() * (k+1) / n_part ; i++)
+			{
+				size_t n0 = l.size();
+
+				traverse(query_type(q.get(i)),[&l](size_t id){l.add(id);});
+
+				start.get(i+1) = l.size() - n0;
+			}
+		}
+
+		for (size_t i = 0 ; i < q.size() ; i++)
+		{start.get(i+1) += start.get(i);}
+
+		ids.resize(start.get(q.size()));
+
+		#pragma omp parallel for schedule(static) if(n_part > 1)
+		for (size_t k = 0 ; k < n_part ; k++)
+		{
+			const openfpm::vector<size_t> & l = loc.get(k);
+
+			if (l.size() != 0)
+			{std::copy(&l.get(0),&l.get(0) + l.size(),&ids.get(start.get(q.size() * k / n_part)));}
+		}
+	}
+
+public:
+
+	//! Create an empty index
+	BoxIndex()
+	{}
+
+	/*! \brief Create the index of a set of boxes
+	 *
+	 * \param b boxes
+	 *
+	 */
+	BoxIndex(const openfpm::vector<Box<dim,T>> & b)
+	{
+		build(b);
+	}
+
+	/*! \brief Build the index of a set of boxes (the previous content is removed)
+	 *
+	 * The boxes are copied, the index does not reference b
+	 *
+	 * \param b boxes
+	 *
+	 */
+	void build(const openfpm::vector<Box<dim,T>> & b)
+	{
+		boxes.resize(b.size());
+
+		for (size_t i = 0 ; i < b.size() ; i++)
+		{
+			box_index_entry<dim,T> & e = boxes.get(i);
+
+			for (size_t d = 0 ; d < dim ; d++)
+			{
+				e.low[d] = b.template get<Box<dim,T>::p1>(i)[d];
+				e.high[d] = b.template get<Box<dim,T>::p2>(i)[d];
+			}
+
+			e.id = i;
+		}
+
+		nodes.clear();
+
+		if (b.size() == 0)
+		{return;}
+
+		// a binary tree with leaves of at least BOX_INDEX_LEAF_SIZE / 2 boxes
+		nodes.reserve(4 * b.size() / BOX_INDEX_LEAF_SIZE + 1);
+		nodes.resize(1);
+
+		build_node(0,0,b.size(),0);
+	}
+
+	/*! \brief Number of boxes in the index
+	 *
+	 * \return the number of boxes
+	 *
+	 */
+	size_t size() const
+	{
+		return boxes.size();
+	}
+
+	/*! \brief Call a function for every box that intersect a box
+	 *
+	 * \param b box
+	 * \param f function called with the id of the box (its position in the vector used to build the index)
+	 *
+	 */
+	template<typename lambda_f>
+	void queryBox(const Box<dim,T> & b, lambda_f f) const
+	{
+		traverse(b,f);
+	}
+
+	/*! \brief Add the ids of the boxes that intersect a box
+	 *
+	 * \param b box
+	 * \param ids where the ids are added
+	 *
+	 */
+	void queryBox(const Box<dim,T> & b, openfpm::vector<size_t> & ids) const
+	{
+		traverse(b,[&ids](size_t id){ids.add(id);});
+	}
+
+	/*! \brief Call a function for every box that contain a point
+	 *
+	 * \param p point
+	 * \param f function called with the id of the box
+	 *
+	 */
+	template<typename lambda_f>
+	void queryPoint(const Point<dim,T> & p, lambda_f f) const
+	{
+		traverse(p,f);
+	}
+
+	/*! \brief Add the ids of the boxes that contain a point
+	 *
+	 * \param p point
+	 * \param ids where the ids are added
+	 *
+	 */
+	void queryPoint(const Point<dim,T> & p, openfpm::vector<size_t> & ids) const
+	{
+		traverse(p,[&ids](size_t id){ids.add(id);});
+	}
+
+	/*! \brief For each box in q find the boxes of the index that intersect it (in parallel)
+	 *
+	 * \param q query boxes
+	 * \param start the ids of the boxes that intersect q.get(i) are ids.get(start.get(i)) ... ids.get(start.get(i+1)-1)
+	 * \param ids ids of the boxes
+	 *
+	 */
+	void queryBoxes(const openfpm::vector<Box<dim,T>> & q, openfpm::vector<size_t> & start, openfpm::vector<size_t> & ids) const
+	{
+		traverse_batch(q,start,ids);
+	}
+
+	/*! \brief For each point in q find the boxes of the index that contain it (in parallel)
+	 *
+	 * \param q query points
+	 * \param start the ids of the boxes that contain q.get(i) are ids.get(start.get(i)) ... ids.get(start.get(i+1)-1)
+	 * \param ids ids of the boxes
+	 *
+	 */
+	void queryPoints(const openfpm::vector<Point<dim,T>> & q, openfpm::vector<size_t> & start, openfpm::vector<size_t> & ids) const
+	{
+		traverse_batch(q,start,ids);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_HPP_ */
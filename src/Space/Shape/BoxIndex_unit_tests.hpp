@@ -0,0 +1,208 @@
+/*
+ * BoxIndex_unit_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_UNIT_TESTS_HPP_
+#define OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_UNIT_TESTS_HPP_
+
+#include "Space/Shape/BoxIndex.hpp"
+
+/*! \brief Fill a vector with random boxes
+ *
+ * \param boxes vector to fill
+ * \param n number of boxes
+ * \param side maximum side of the boxes
+ *
+ */
+template<unsigned int dim, typename T>
+void box_index_test_random(openfpm::vector<Box<dim,T>> & boxes, size_t n, T side)
+{
+	boxes.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			T low = (T)(rand() % 10000) / 100;
+			boxes.template get<Box<dim,T>::p1>(i)[d] = low;
+			boxes.template get<Box<dim,T>::p2>(i)[d] = low + (T)((rand() % 1000) * side / 1000);
+		}
+	}
+}
+
+/*! \brief Check the queries of a BoxIndex against the brute force
+ *
+ * \param n number of boxes
+ * \param side maximum side of the boxes
+ *
+ */
+template<unsigned int dim, typename T>
+void box_index_test_check(size_t n, T side)
+{
+	openfpm::vector<Box<dim,T>> boxes;
+	openfpm::vector<Box<dim,T>> q;
+	openfpm::vector<Point<dim,T>> qp;
+
+	box_index_test_random(boxes,n,side);
+	box_index_test_random(q,200,side);
+
+	qp.resize(200);
+	for (size_t i = 0 ; i < qp.size() ; i++)
+	{
+		for (size_t d = 0 ; d < dim ; d++)
+		{qp.template get<0>(i)[d] = (T)(rand() % 10000) / 100;}
+	}
+
+	BoxIndex<dim,T> bi(boxes);
+	BOOST_REQUIRE_EQUAL(bi.size(),n);
+
+	openfpm::vector<size_t> start;
+	openfpm::vector<size_t> ids;
+	openfpm::vector<size_t> start_p;
+	openfpm::vector<size_t> ids_p;
+
+	bi.queryBoxes(q,start,ids);
+	bi.queryPoints(qp,start_p,ids_p);
+
+	BOOST_REQUIRE_EQUAL(start.size(),q.size() + 1);
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < q.size() ; i++)
+	{
+		Box<dim,T> bq = q.get(i);
+		Point<dim,T> pq = qp.get(i);
+
+		openfpm::vector<size_t> bf;
+		openfpm::vector<size_t> bf_p;
+
+		for (size_t j = 0 ; j < boxes.size() ; j++)
+		{
+			Box<dim,T> b = boxes.get(j);
+			Box<dim,T> b_out;
+
+			if (b.Intersect(bq,b_out) == true)
+			{bf.add(j);}
+
+			if (b.isInside(pq) == true)
+			{bf_p.add(j);}
+		}
+
+		openfpm::vector<size_t> bi_b;
+		bi_b.resize(start.get(i+1) - start.get(i));
+		for (size_t j = 0 ; j < bi_b.size() ; j++)
+		{bi_b.get(j) = ids.get(start.get(i) + j);}
+
+		openfpm::vector<size_t> bi_p;
+		bi.queryPoint(pq,bi_p);
+
+		// single query and batch query give the same result
+		match &= (bi_p.size() == start_p.get(i+1) - start_p.get(i));
+
+		if (bi_b.size() != 0)
+		{std::sort(&bi_b.get(0),&bi_b.get(0) + bi_b.size());}
+
+		if (bi_p.size() != 0)
+		{std::sort(&bi_p.get(0),&bi_p.get(0) + bi_p.size());}
+
+		match &= (bi_b.size() == bf.size());
+		match &= (bi_p.size() == bf_p.size());
+
+		for (size_t j = 0 ; j < bf.size() && j < bi_b.size() ; j++)
+		{match &= bf.get(j) == bi_b.get(j);}
+
+		for (size_t j = 0 ; j < bf_p.size() && j < bi_p.size() ; j++)
+		{match &= bf_p.get(j) == bi_p.get(j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_SUITE( box_index_test )
+
+BOOST_AUTO_TEST_CASE( box_index_use )
+{
+	//! [Build a BoxIndex and query]
+
+	openfpm::vector<Box<2,float>> boxes;
+
+	boxes.add(Box<2,float>({0.0,0.0},{1.0,1.0}));
+	boxes.add(Box<2,float>({1.0,0.0},{2.0,1.0}));
+	boxes.add(Box<2,float>({3.0,3.0},{4.0,4.0}));
+	boxes.add(Box<2,float>({0.5,0.5},{3.5,3.5}));
+
+	BoxIndex<2,float> bi(boxes);
+
+	// boxes that intersect a box (touching boxes intersect)
+	openfpm::vector<size_t> ids;
+	bi.queryBox(Box<2,float>({1.0,-1.0},{1.2,0.2}),ids);
+
+	// boxes that contain a point
+	openfpm::vector<size_t> ids_p;
+	bi.queryPoint(Point<2,float>({3.2,3.2}),ids_p);
+
+	// batch of queries (in parallel)
+	openfpm::vector<Box<2,float>> q;
+	q.add(Box<2,float>({-1.0,-1.0},{-0.5,-0.5}));
+	q.add(Box<2,float>({3.9,3.9},{5.0,5.0}));
+
+	openfpm::vector<size_t> start;
+	openfpm::vector<size_t> ids_q;
+	bi.queryBoxes(q,start,ids_q);
+
+	//! [Build a BoxIndex and query]
+
+	std::sort(&ids.get(0),&ids.get(0) + ids.size());
+	std::sort(&ids_p.get(0),&ids_p.get(0) + ids_p.size());
+
+	BOOST_REQUIRE_EQUAL(ids.size(),2ul);
+	BOOST_REQUIRE_EQUAL(ids.get(0),0ul);
+	BOOST_REQUIRE_EQUAL(ids.get(1),1ul);
+
+	BOOST_REQUIRE_EQUAL(ids_p.size(),2ul);
+	BOOST_REQUIRE_EQUAL(ids_p.get(0),2ul);
+	BOOST_REQUIRE_EQUAL(ids_p.get(1),3ul);
+
+	BOOST_REQUIRE_EQUAL(start.size(),3ul);
+	BOOST_REQUIRE_EQUAL(start.get(1),0ul);
+	BOOST_REQUIRE_EQUAL(start.get(2),1ul);
+	BOOST_REQUIRE_EQUAL(ids_q.get(0),2ul);
+
+	// empty index
+	BoxIndex<2,float> bi_e;
+	openfpm::vector<Box<2,float>> empty;
+	bi_e.build(empty);
+
+	bi_e.queryBoxes(q,start,ids_q);
+	BOOST_REQUIRE_EQUAL(bi_e.size(),0ul);
+	BOOST_REQUIRE_EQUAL(ids_q.size(),0ul);
+	BOOST_REQUIRE_EQUAL(start.get(2),0ul);
+}
+
+BOOST_AUTO_TEST_CASE( box_index_brute_force )
+{
+	box_index_test_check<2,float>(1,5.0);
+	box_index_test_check<2,float>(7,5.0);
+	box_index_test_check<3,double>(1000,10.0);
+	box_index_test_check<3,float>(5000,2.0);
+	box_index_test_check<3,long int>(3000,10);
+
+	// many identical boxes
+	openfpm::vector<Box<3,float>> boxes;
+	for (size_t i = 0 ; i < 100 ; i++)
+	{boxes.add(Box<3,float>({1.0,1.0,1.0},{2.0,2.0,2.0}));}
+
+	BoxIndex<3,float> bi(boxes);
+
+	openfpm::vector<size_t> ids;
+	bi.queryPoint(Point<3,float>({2.0,1.5,1.0}),ids);
+
+	BOOST_REQUIRE_EQUAL(ids.size(),100ul);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_SPACE_SHAPE_BOXINDEX_UNIT_TESTS_HPP_ */
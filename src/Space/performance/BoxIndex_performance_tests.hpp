@@ -0,0 +1,112 @@
+/*
+ * BoxIndex_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_SPACE_PERFORMANCE_BOXINDEX_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_SPACE_PERFORMANCE_BOXINDEX_PERFORMANCE_TESTS_HPP_
+
+#include "Space/Shape/BoxIndex.hpp"
+#include "util/stat/common_statistics.hpp"
+
+/*! \brief Create n random cubes in the unit cube, every box intersect few other boxes
+ *
+ * \param boxes vector to fill
+ * \param n number of boxes
+ *
+ */
+static inline void box_index_performance_boxes(openfpm::vector<Box<3,double>> & boxes, size_t n)
+{
+	double side = 2.0 / cbrt((double)n);
+
+	boxes.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			double low = (double)rand() / RAND_MAX;
+			boxes.template get<Box<3,double>::p1>(i)[d] = low;
+			boxes.template get<Box<3,double>::p2>(i)[d] = low + side * rand() / RAND_MAX;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( box_index_performance )
+
+BOOST_AUTO_TEST_CASE(box_index_performance_brute_force)
+{
+	size_t n_q = 1000;
+
+	std::cout << "BoxIndex " << n_q << " box queries against n random boxes in 3D (brute force: nested loop with Box::Intersect)" << std::endl;
+
+	for (size_t n = 1000 ; n <= 1000000 ; n *= 10)
+	{
+		openfpm::vector<Box<3,double>> boxes;
+		openfpm::vector<Box<3,double>> q;
+
+		box_index_performance_boxes(boxes,n);
+		box_index_performance_boxes(q,n_q);
+
+		openfpm::vector<double> t_b, t_q, t_f;
+		openfpm::vector<size_t> start;
+		openfpm::vector<size_t> ids;
+		size_t n_bf = 0;
+
+		for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+		{
+			timer t1;
+			t1.start();
+
+			BoxIndex<3,double> bi(boxes);
+
+			t1.stop();
+			t_b.add(t1.getwct());
+
+			timer t2;
+			t2.start();
+
+			bi.queryBoxes(q,start,ids);
+
+			t2.stop();
+			t_q.add(t2.getwct());
+
+			timer t3;
+			t3.start();
+
+			n_bf = 0;
+			for (size_t i = 0 ; i < q.size() ; i++)
+			{
+				Box<3,double> bq = q.get(i);
+
+				for (size_t j = 0 ; j < boxes.size() ; j++)
+				{
+					Box<3,double> b = boxes.get(j);
+					Box<3,double> b_out;
+
+					n_bf += (b.Intersect(bq,b_out) == true)?1:0;
+				}
+			}
+
+			t3.stop();
+			t_f.add(t3.getwct());
+		}
+
+		double m_b, d_b, m_q, d_q, m_f, d_f;
+		standard_deviation(t_b,m_b,d_b);
+		standard_deviation(t_q,m_q,d_q);
+		standard_deviation(t_f,m_f,d_f);
+
+		std::cout << "    n: " << n << "  build: " << m_b << " s (dev " << d_b << ")  queries: " << m_q << " s (dev " << d_q << ")  brute force: "
+		          << m_f << " s (dev " << d_f << ")  speedup (queries): " << m_f / m_q << "  speedup (build + queries): " << m_f / (m_b + m_q)
+		          << "  hits: " << ids.size() << std::endl;
+
+		BOOST_REQUIRE_EQUAL(ids.size(),n_bf);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_SPACE_PERFORMANCE_BOXINDEX_PERFORMANCE_TESTS_HPP_ */
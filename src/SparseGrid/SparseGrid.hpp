@@ -377,7 +377,8 @@ template<unsigned int dim,
 		 typename grid_lin,
 		 typename layout,
 		 template<typename> class layout_base,
-		 typename chunking>
+		 typename chunking,
+		 typename chunk_index>
 class sgrid_cpu
 {
 	//! cache pointer
@@ -389,8 +390,11 @@ class sgrid_cpu
 	//! cached id
 	mutable long int cached_id[SGRID_CACHE];
 
-	//! Map to convert from grid coordinates to chunk
-	tsl::hopscotch_map<size_t, size_t> map;
+	//! It is incremented every time the chunk structure change (it invalidate the external caches)
+	size_t cache_version = 0;
+
+	//! Map to convert from grid coordinates to chunk (sgrid_index_hopscotch, sgrid_index_dense or sgrid_index_sorted)
+	chunk_index map;
 
 	//! indicate which element in the chunk are really filled
 	openfpm::vector<cheader<dim>,S> header_inf;
@@ -403,7 +407,7 @@ class sgrid_cpu
 	//! background values
 	//aggregate_bfv<chunk_def> background;
 
-	typedef sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking> self;
+	typedef sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking,chunk_index> self;
 
 	//! vector of chunks
 	openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base > chunks;
@@ -472,7 +476,9 @@ class sgrid_cpu
 	{
 		// reconstruct map
 
-		map.clear();
+		openfpm::vector<sgrid_index_entry> e;
+		e.resize(header_inf.size() - 1);
+
 		for (size_t i = 1 ; i < header_inf.size() ; i++)
 		{
 			grid_key_dx<dim> kh = header_inf.get(i).pos;
@@ -481,9 +487,96 @@ class sgrid_cpu
 			// shift the key
 			key_shift<dim,chunking>::shift(kh,kl);
 
-			long int lin_id = g_sm_shift.LinId(kh);
+			e.get(i-1).lin_id = g_sm_shift.LinId(kh);
+			e.get(i-1).cnk = i;
+		}
 
-			map[lin_id] = i;
+		map.build(e);
+	}
+
+	/*! \brief Call a function for each chunk that intersect a box
+	 *
+	 * When the box cover less chunk positions than the number of chunks the positions are
+	 * enumerated and searched in the chunk index, so only the chunks that overlap the box are
+	 * touched, otherwise all the chunks are scanned
+	 *
+	 * \param section box in grid coordinates
+	 * \param f function called as f(chunk id, intersection relative to the chunk origin, true if the chunk is fully covered)
+	 *
+	 */
+	template<typename func_type>
+	void for_each_chunk_in_box(const Box<dim,size_t> & section, func_type f) const
+	{
+		grid_key_dx<dim> kl;
+		grid_key_dx<dim> kh;
+		grid_key_dx<dim> unused;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if (section.getHigh(i) < section.getLow(i))
+			{return;}
+
+			kl.set_d(i,section.getLow(i));
+			kh.set_d(i,section.getHigh(i));
+		}
+
+		// chunk positions covered by the box
+		key_shift<dim,chunking>::shift(kl,unused);
+		key_shift<dim,chunking>::shift(kh,unused);
+
+		size_t sz_pos[dim];
+		size_t n_pos = 1;
+		bool inside = true;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			sz_pos[i] = g_sm_shift.size(i);
+			inside &= (size_t)kh.get(i) < sz_pos[i];
+			n_pos *= kh.get(i) - kl.get(i) + 1;
+		}
+
+		auto call = [&](size_t i)
+		{
+			auto & hc = header_inf.get(i);
+
+			Box<dim,size_t> bc;
+
+			for (size_t j = 0 ; j < dim ; j++)
+			{
+				bc.setLow(j,hc.pos.get(j));
+				bc.setHigh(j,hc.pos.get(j) + sz_cnk[j] - 1);
+			}
+
+			Box<dim,size_t> inte;
+			if (bc.Intersect(section,inte) == false)
+			{return;}
+
+			bool covered = inte.getVolumeKey() == chunking::size::value;
+
+			inte -= hc.pos.toPoint();
+
+			f(i,inte,covered);
+		};
+
+		if (inside == true && n_pos < header_inf.size())
+		{
+			grid_sm<dim,void> gs_pos(sz_pos);
+			grid_key_dx_iterator_sub<dim,no_stencil,grid_sm<dim,void>> it(gs_pos,kl,kh);
+
+			while (it.isNext())
+			{
+				size_t cnk;
+				if (map.find(g_sm_shift.LinId(it.get()),cnk) == true)
+				{call(cnk);}
+
+				++it;
+			}
+		}
+		else
+		{
+			// skip the background chunk
+			for (size_t i = 1 ; i < header_inf.size() ; i++)
+			{call(i);}
 		}
 	}
 
@@ -548,6 +641,7 @@ class sgrid_cpu
 	 */
 	inline void clear_cache()
 	{
+		cache_version++;
 		cache_pnt = 0;
 		for (size_t i = 0 ; i < SGRID_CACHE ; i++)
 		{cache[i] = -1;}
@@ -575,6 +669,12 @@ class sgrid_cpu
 		{sz_i[i] = cs.get(i) + 1;}
 
 		g_sm_shift.setDimensions(sz_i);
+
+		// the last chunk has the biggest linearized position
+		for (size_t i = 0 ; i < dim ; i++)
+		{cs.set_d(i,sz_i[i] - 1);}
+
+		map.setDomain(g_sm_shift.LinId(cs) + 1);
 	}
 
 	/*! \brief initialize
@@ -657,15 +757,12 @@ class sgrid_cpu
 		{
 			// we do not have it in cache we check if we have it in the map
 
-			auto fnd = map.find(lin_id);
-			if (fnd == map.end())
+			if (map.find(lin_id,active_cnk) == false)
 			{
 				exist = false;
 				active_cnk = 0;
 				return;
 			}
-			else
-			{active_cnk = fnd->second;}
 
 			// Add on cache the chunk
 			cache[cache_pnt] = lin_id;
@@ -683,6 +780,78 @@ class sgrid_cpu
 		exist = true;
 	}
 
+	/*! \brief Given a key return the chunk than contain that key using an external cache
+	 *
+	 * It does not modify the grid, so it can be used by multiple threads concurrently
+	 * (each one with its own cache)
+	 *
+	 * \param kh chunk position (shifted key)
+	 * \param active_cnk output chunk
+	 * \param exist output true if the chunk exist
+	 * \param cc cache to use
+	 *
+	 */
+	inline void find_active_chunk(const grid_key_dx<dim> & kh,size_t & active_cnk,bool & exist, sgrid_chunk_cache & cc) const
+	{
+		if (cc.owner != this || cc.version != cache_version)
+		{
+			cc.clear();
+			cc.owner = this;
+			cc.version = cache_version;
+		}
+
+		long int lin_id = g_sm_shift.LinId(kh);
+
+		size_t id = 0;
+		for (size_t k = 0 ; k < SGRID_CACHE; k++)
+		{id += (cc.cache[k] == lin_id)?k+1:0;}
+
+		if (id == 0)
+		{
+			if (map.find(lin_id,active_cnk) == false)
+			{
+				exist = false;
+				active_cnk = 0;
+				return;
+			}
+
+			cc.cache[cc.cache_pnt] = lin_id;
+			cc.cached_id[cc.cache_pnt] = active_cnk;
+			cc.cache_pnt++;
+			cc.cache_pnt = (cc.cache_pnt >= SGRID_CACHE)?0:cc.cache_pnt;
+		}
+		else
+		{
+			active_cnk = cc.cached_id[id-1];
+			cc.cache_pnt = id;
+			cc.cache_pnt = (cc.cache_pnt == SGRID_CACHE)?0:cc.cache_pnt;
+		}
+
+		exist = true;
+	}
+
+	/*! Given a key v1 in coordinates it calculate the chunk position and the  position in the chunk
+	 *
+	 * \param v1 coordinates
+	 * \param chunk position
+	 * \param sub_id element id
+	 * \param exist output true if the chunk exist
+	 * \param cc cache to use
+	 *
+	 */
+	inline void pre_get(const grid_key_dx<dim> & v1, size_t & active_cnk, size_t & sub_id, bool & exist, sgrid_chunk_cache & cc) const
+	{
+		grid_key_dx<dim> kh = v1;
+		grid_key_dx<dim> kl;
+
+		// shift the key
+		key_shift<dim,chunking>::shift(kh,kl);
+
+		find_active_chunk(kh,active_cnk,exist,cc);
+
+		sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
+	}
+
 	/*! Given a key v1 in coordinates it calculate the chunk position and the  position in the chunk
 	 *
 	 * \param v1 coordinates
@@ -731,12 +900,11 @@ class sgrid_cpu
 		{
 			// we do not have it in cache we check if we have it in the map
 
-			auto fnd = map.find(lin_id);
-			if (fnd == map.end())
+			if (map.find(lin_id,active_cnk) == false)
 			{
 				// we do not have it in the map create a chunk
 
-				map[lin_id] = chunks.size();
+				map.insert(lin_id,chunks.size());
 				chunks.add();
 				header_inf.add();
 				header_inf.last().pos = kh;
@@ -753,12 +921,6 @@ class sgrid_cpu
 
 				active_cnk = chunks.size() - 1;
 			}
-			else
-			{
-				// we have it in the map
-
-				active_cnk = fnd->second;
-			}
 
 			// Add on cache the chunk
 			cache[cache_pnt] = lin_id;
@@ -1042,6 +1204,38 @@ public:
 		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,active_cnk,sub_id);
 	}
 
+	/*! \brief Get the reference of the selected element using an external chunk cache
+	 *
+	 * Differently from get(v1) this function does not write any member of the grid, so multiple
+	 * threads can read the grid concurrently, as long as each thread use its own cache
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 * \param cc chunk cache of the calling thread
+	 *
+	 * \return the reference of the element
+	 *
+	 */
+	template <unsigned int p>
+	inline auto get(const grid_key_dx<dim> & v1, sgrid_chunk_cache & cc) const -> decltype(get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,0))
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get(v1,active_cnk,sub_id,exist,cc);
+
+		if (exist == false)
+		{return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,sub_id);}
+
+		// we check the mask
+		auto & hm = header_mask.get(active_cnk);
+
+		if ((hm.mask[sub_id] & 1) == 0)
+		{return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,sub_id);}
+
+		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,active_cnk,sub_id);
+	}
+
 	/*! \brief Indicate that unpacking the header is supported
      *
 	 * \return false
@@ -1106,6 +1300,33 @@ public:
 		return true;
 	}
 
+	/*! \brief Check if the point exist using an external chunk cache
+	 *
+	 * \see get(v1,cc)
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 * \param cc chunk cache of the calling thread
+	 *
+	 * \return the true if the point exist
+	 *
+	 */
+	inline bool existPoint(const grid_key_dx<dim> & v1, sgrid_chunk_cache & cc) const
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get(v1,active_cnk,sub_id,exist,cc);
+
+		if (exist == false)
+		{return false;}
+
+		// we check the mask
+		auto & hm = header_mask.get(active_cnk);
+
+		return (hm.mask[sub_id] & 1) != 0;
+	}
+
 	/*! \brief Get the reference of the selected element
 	 *
 	 * \param v1 grid_key that identify the element in the grid
@@ -1154,6 +1375,29 @@ public:
 		return grid_key_sparse_dx_iterator<dim,chunking::size::value>(&header_mask,&header_inf,&pos_chunk);
 	}
 
+	/*! \brief Return an iterator over a part of the grid
+	 *
+	 * The chunks are divided in n_part contiguous sets, the iterator run over the set part.
+	 * It can be used to iterate the grid with multiple threads
+	 *
+	 * \snippet SparseGrid_unit_tests.cpp parallel read of a sparse grid
+	 *
+	 * \param part part to iterate (for example the thread id)
+	 * \param n_part number of parts (for example the number of threads)
+	 *
+	 * \return the iterator
+	 *
+	 */
+	grid_key_sparse_dx_iterator<dim,chunking::size::value>
+	getIteratorPart(size_t part, size_t n_part) const
+	{
+		size_t start;
+		size_t stop;
+		getChunkRangePart(part,n_part,start,stop);
+
+		return grid_key_sparse_dx_iterator<dim,chunking::size::value>(&header_mask,&header_inf,&pos_chunk,start,stop);
+	}
+
 	/*! \brief Return an iterator over a sub-grid
 	 *
 	 * \return return an iterator over a sub-grid
@@ -1181,6 +1425,49 @@ public:
 		return grid_key_sparse_dx_iterator_block_sub<dim,stencil_size,self,chunking>(*this,start,stop);
 	}
 
+	/*! \brief Return an iterator over the blocks of a sub-grid restricted to a part of the chunks
+	 *
+	 * The chunks are divided in n_part contiguous sets, the iterator run over the set part.
+	 * Loading the blocks and the borders does not use the internal cache, so different threads
+	 * can use different parts concurrently
+	 *
+	 * \tparam stencil size
+	 * \param start point
+	 * \param stop point
+	 * \param part part to iterate (for example the thread id)
+	 * \param n_part number of parts (for example the number of threads)
+	 *
+	 * \return an iterator over sub-grid blocks
+	 *
+	 */
+	template<unsigned int stencil_size = 0>
+	grid_key_sparse_dx_iterator_block_sub<dim,stencil_size,self,chunking>
+	getBlockIteratorPart(const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, size_t part, size_t n_part)
+	{
+		size_t c_start;
+		size_t c_stop;
+		getChunkRangePart(part,n_part,c_start,c_stop);
+
+		return grid_key_sparse_dx_iterator_block_sub<dim,stencil_size,self,chunking>(*this,start,stop,c_start,c_stop);
+	}
+
+	/*! \brief Divide the chunks in n_part contiguous set and return the range of the set part
+	 *
+	 * \param part set
+	 * \param n_part number of sets
+	 * \param start output first chunk
+	 * \param stop output last chunk + 1
+	 *
+	 */
+	void getChunkRangePart(size_t part, size_t n_part, size_t & start, size_t & stop) const
+	{
+		// chunk 0 is the background
+		size_t n_cnk = header_inf.size() - 1;
+
+		start = 1 + n_cnk * part / n_part;
+		stop = 1 + n_cnk * (part + 1) / n_part;
+	}
+
 	/*! \brief Return the internal grid information
 	 *
 	 * Return the internal grid information
@@ -1497,75 +1784,76 @@ public:
 			section_to_pack.setHigh(i,sub_it.getStop().get(i));
 		}
 
-		for (size_t i = 0 ; i < header_inf.size() ; i++)
+		for_each_chunk_in_box(section_to_pack,[&](size_t i, Box<dim,size_t> & inte, bool covered)
 		{
 			auto & hm = header_mask.get(i);
 
-			Box<dim,size_t> bc;
+			size_t old_req = req;
 
-			for (size_t j = 0 ; j < dim ; j++)
+			auto req_point = [&](size_t sub_id)
 			{
-				bc.setLow(j,header_inf.get(i).pos.get(j));
-				bc.setHigh(j,header_inf.get(i).pos.get(j) + sz_cnk[j] - 1);
-			}
-
-			// now we intersect the chunk box with the box
+				// If all of the aggregate properties do not have a "pack()" member
+				if (has_pack_agg<T,prp...>::result::value == false)
+				{
+					// here we count how many chunks must be sent
 
-			Box<dim,size_t> inte;
-			bool stp = bc.Intersect(section_to_pack,inte);
+					size_t alloc_ele = this->packMem<prp...>(1,0);
+					req += alloc_ele;
+				}
+				//If at least one property has "pack()"
+				else
+				{
+					//Call a pack request
+					call_aggregatePackRequestChunking<decltype(chunks.get_o(i)),
+														  S,prp ... >
+														  ::call_packRequest(chunks.get_o(i),sub_id,req);
+				}
+			};
 
-			if (stp == true)
+			if (covered == true)
 			{
-				// If it is intersect ok we have to check if there are points to pack
-				// we shift inte to be relative to the chunk origin
+				// the chunk is inside the box, we take all the existing points
 
-				inte -= header_inf.get(i).pos.toPoint();
+				int mask_nele;
+				short unsigned int mask_it[chunking::size::value];
 
-				// we iterate all the points
+				fill_mask(mask_it,hm.mask,mask_nele);
+
+				if (has_pack_agg<T,prp...>::result::value == false)
+				{req += mask_nele * this->packMem<prp...>(1,0);}
+				else
+				{
+					for (int j = 0 ; j < mask_nele ; j++)
+					{req_point(mask_it[j]);}
+				}
+			}
+			else
+			{
+				// we iterate all the points of the intersection
 
-				size_t old_req = req;
 				grid_key_dx_iterator_sub<dim,no_stencil,grid_sm<dim,void>> sit(gs_cnk,inte.getKP1(),inte.getKP2());
 
 				while (sit.isNext())
 				{
-					auto key = sit.get();
-
-					size_t sub_id = gs_cnk.LinId(key);
+					size_t sub_id = gs_cnk.LinId(sit.get());
 
 					if (hm.mask[sub_id] & 1)
-					{
-						// If all of the aggregate properties do not have a "pack()" member
-						if (has_pack_agg<T,prp...>::result::value == false)
-						{
-							// here we count how many chunks must be sent
-
-							size_t alloc_ele = this->packMem<prp...>(1,0);
-							req += alloc_ele;
-						}
-						//If at least one property has "pack()"
-						else
-						{
-							//Call a pack request
-							call_aggregatePackRequestChunking<decltype(chunks.get_o(i)),
-																  S,prp ... >
-																  ::call_packRequest(chunks.get_o(i),sub_id,req);
-						}
-					}
+					{req_point(sub_id);}
 
 					++sit;
 				}
+			}
 
-				if (old_req != req)
-				{
-					// There are point to send. So we have to save the mask chunk
-					req += sizeof(header_mask.get(i));
-					// the chunk position
-					req += sizeof(header_inf.get(i).pos);
-					// and the number of element
-					req += sizeof(header_inf.get(i).nele);
-				}
+			if (old_req != req)
+			{
+				// There are point to send. So we have to save the mask chunk
+				req += sizeof(header_mask.get(i));
+				// the chunk position
+				req += sizeof(header_inf.get(i).pos);
+				// and the number of element
+				req += sizeof(header_inf.get(i).nele);
 			}
-		}
+		});
 	}
 
 	/*! \brief Pack the object into the memory given an iterator
@@ -1606,44 +1894,47 @@ public:
 
 		size_t n_packed_chunk = 0;
 
-		for (size_t i = 0 ; i < header_inf.size() ; i++)
+		for_each_chunk_in_box(section_to_pack,[&](size_t i, Box<dim,size_t> & inte, bool covered)
 		{
-			auto & hc = header_inf.get(i);
 			auto & hm = header_mask.get(i);
 
-			Box<dim,size_t> bc;
+			unsigned char mask_to_pack[chunking::size::value];
+			mem.allocate_nocheck(sizeof(header_mask.get(i)) + sizeof(header_inf.get(i).pos) + sizeof(header_inf.get(i).nele));
 
-			for (size_t j = 0 ; j < dim ; j++)
-			{
-				bc.setLow(j,hc.pos.get(j));
-				bc.setHigh(j,hc.pos.get(j) + sz_cnk[j] - 1);
-			}
+			// here we get the pointer of the memory in case we have to pack the header
+			// and we also shift the memory pointer by an offset equal to the header
+			// to pack
+			unsigned char * ptr_start = (unsigned char *)mem.getPointer();
 
-			// now we intersect the chunk box with the box
+			// This flag indicate if something has been packed from this chunk
+			bool has_packed = false;
 
-			Box<dim,size_t> inte;
-			bool stp = bc.Intersect(section_to_pack,inte);
-
-			if (stp == true)
+			if (covered == true)
 			{
-				// This flag indicate if something has been packed from this chunk
-				bool has_packed = false;
+				// the chunk is inside the box, we pack all the existing points
 
-				unsigned char mask_to_pack[chunking::size::value];
-				memset(mask_to_pack,0,sizeof(mask_to_pack));
-				mem.allocate_nocheck(sizeof(header_mask.get(i)) + sizeof(header_inf.get(i).pos) + sizeof(header_inf.get(i).nele));
+				int mask_nele;
+				short unsigned int mask_it[chunking::size::value];
 
-				// here we get the pointer of the memory in case we have to pack the header
-				// and we also shift the memory pointer by an offset equal to the header
-				// to pack
-				unsigned char * ptr_start = (unsigned char *)mem.getPointer();
+				fill_mask(mask_it,hm.mask,mask_nele);
 
-				// If it is intersect ok we have to check if there are points to pack
-				// we shift inte intp the chunk origin
+				for (size_t j = 0 ; j < chunking::size::value ; j++)
+				{mask_to_pack[j] = hm.mask[j] & 1;}
 
-				inte -= hc.pos.toPoint();
+				for (int j = 0 ; j < mask_nele ; j++)
+				{
+					Packer<decltype(chunks.get_o(i)),
+								S,
+								PACKER_ENCAP_OBJECTS_CHUNKING>::template pack<T,prp...>(mem,chunks.get_o(i),mask_it[j],sts);
+				}
 
-				// we iterate all the points
+				has_packed = mask_nele != 0;
+			}
+			else
+			{
+				memset(mask_to_pack,0,sizeof(mask_to_pack));
+
+				// we iterate all the points of the intersection
 
 				grid_key_dx_iterator_sub<dim,no_stencil,grid_sm<dim,void>> sit(gs_cnk,inte.getKP1(),inte.getKP2());
 
@@ -1666,38 +1957,38 @@ public:
 
 					++sit;
 				}
+			}
 
-				if (has_packed == true)
-				{
-					unsigned char * ptr_final = (unsigned char *)mem.getPointer();
-					unsigned char * ptr_final_for = (unsigned char *)mem.getPointerEnd();
+			if (has_packed == true)
+			{
+				unsigned char * ptr_final = (unsigned char *)mem.getPointer();
+				unsigned char * ptr_final_for = (unsigned char *)mem.getPointerEnd();
 
-					// Ok we packed something so we have to pack the header
-					 size_t shift = ptr_final - ptr_start;
+				// Ok we packed something so we have to pack the header
+				 size_t shift = ptr_final - ptr_start;
 
-					 mem.shift_backward(shift);
+				 mem.shift_backward(shift);
 
-					 // The position of the chunks
+				 // The position of the chunks
 
-					 grid_key_dx<dim> pos = header_inf.get(i).pos - sub_it.getStart();
+				 grid_key_dx<dim> pos = header_inf.get(i).pos - sub_it.getStart();
 
-					 Packer<decltype(header_mask.get(i).mask),S>::pack(mem,mask_to_pack,sts);
-					 Packer<decltype(header_inf.get(i).pos),S>::pack(mem,pos,sts);
-					 Packer<decltype(header_inf.get(i).nele),S>::pack(mem,header_inf.get(i).nele,sts);
+				 Packer<decltype(header_mask.get(i).mask),S>::pack(mem,mask_to_pack,sts);
+				 Packer<decltype(header_inf.get(i).pos),S>::pack(mem,pos,sts);
+				 Packer<decltype(header_inf.get(i).nele),S>::pack(mem,header_inf.get(i).nele,sts);
 
-					 size_t shift_for = ptr_final_for - (unsigned char *)mem.getPointer();
+				 size_t shift_for = ptr_final_for - (unsigned char *)mem.getPointer();
 
-					 mem.shift_forward(shift_for);
+				 mem.shift_forward(shift_for);
 
-					 n_packed_chunk++;
-				}
-				else
-				{
-					// This just reset the last allocation
-					mem.shift_backward(0);
-				}
+				 n_packed_chunk++;
 			}
-		}
+			else
+			{
+				// This just reset the last allocation
+				mem.shift_backward(0);
+			}
+		});
 
 		// Now we fill the number of packed chunks
 		*number_of_chunks = n_packed_chunk;
@@ -1813,6 +2104,212 @@ public:
 		}
 	}
 
+	/*! \brief Insert an allocation request for a compressed pack of the sparse grid
+	 *
+	 * The request is an upper bound, the compressed pack can use less memory
+	 *
+	 * \tparam prp set of properties to pack
+	 *
+	 * \param req request
+	 *
+	 */
+	template<int ... prp> inline
+	void packRequestCompressed(size_t & req) const
+	{
+		size_t n_cnk = header_inf.size() - 1;
+
+		// number of chunks, number of runs and the size of the grid
+		req += (2 + dim)*sizeof(size_t);
+
+		// runs of chunk positions (in the worst case one for each chunk) and the masks
+		req += pack_compress_block_request(2*n_cnk*sizeof(size_t));
+		req += pack_compress_block_request(n_cnk*(1 + (chunking::size::value + 7) / 8));
+
+		pack_compress_request_prp<T> pr(size(),req);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(pr);
+	}
+
+	/*! \brief Pack the sparse grid in a compressed format
+	 *
+	 * The chunks are ordered by position and their positions are stored as runs of consecutive
+	 * linearized chunk positions. Every mask is stored as a bitset (or only a flag if the chunk
+	 * is full), then every property is stored as a block with the values of all the points. The
+	 * blocks can be byte-shuffled and compressed (see pack_compress_block). Use unpackCompressed
+	 * to unpack
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack the objects (see packRequestCompressed)
+	 * \param sts pack statistic
+	 * \param opt PACK_COMPRESS_NONE or PACK_COMPRESS_SHUFFLE_LZ
+	 *
+	 */
+	template<int ... prp> void packCompressed(ExtPreAlloc<S> & mem,
+											  Pack_stat & sts,
+											  int opt = PACK_COMPRESS_SHUFFLE_LZ) const
+	{
+		static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be packed compressed");
+
+		// order the chunks by position
+
+		openfpm::vector<sgrid_index_entry> ord;
+		ord.resize(header_inf.size() - 1);
+
+		for (size_t i = 1 ; i < header_inf.size() ; i++)
+		{
+			grid_key_dx<dim> kh = header_inf.get(i).pos;
+			grid_key_dx<dim> kl;
+			key_shift<dim,chunking>::shift(kh,kl);
+
+			ord.get(i-1).lin_id = g_sm_shift.LinId(kh);
+			ord.get(i-1).cnk = i;
+		}
+
+		if (ord.size() != 0)
+		{std::sort(&ord.get(0),&ord.get(0) + ord.size());}
+
+		// runs of consecutive positions, masks and points
+
+		openfpm::vector<size_t> runs;
+		openfpm::vector<unsigned char> masks;
+		openfpm::vector<size_t> pnt;
+
+		const size_t n_bits = (chunking::size::value + 7) / 8;
+
+		for (size_t i = 0 ; i < ord.size() ; i++)
+		{
+			size_t lin = ord.get(i).lin_id;
+			size_t cnk = ord.get(i).cnk;
+
+			if (runs.size() != 0 && runs.get(runs.size() - 2) + runs.last() == lin)
+			{runs.last()++;}
+			else
+			{
+				runs.add(lin);
+				runs.add(1);
+			}
+
+			auto & hm = header_mask.get(cnk);
+
+			if (header_inf.get(cnk).nele == chunking::size::value)
+			{masks.add(1);}
+			else
+			{
+				masks.add(0);
+
+				size_t off = masks.size();
+				masks.resize(off + n_bits);
+
+				for (size_t j = 0 ; j < n_bits ; j++)
+				{masks.get(off + j) = 0;}
+
+				for (size_t j = 0 ; j < chunking::size::value ; j++)
+				{masks.get(off + j / 8) |= (hm.mask[j] & 1) << (j % 8);}
+			}
+
+			int mask_nele;
+			short unsigned int mask_it[chunking::size::value];
+
+			fill_mask(mask_it,hm.mask,mask_nele);
+
+			for (int j = 0 ; j < mask_nele ; j++)
+			{pnt.add(cnk * chunking::size::value + mask_it[j]);}
+		}
+
+		Packer<size_t,S>::pack(mem,ord.size(),sts);
+		Packer<size_t,S>::pack(mem,runs.size() / 2,sts);
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{Packer<size_t,S>::pack(mem,getGrid().size(i),sts);}
+
+		pack_compress_block(mem,(runs.size() != 0)?&runs.get(0):NULL,runs.size()*sizeof(size_t),sizeof(size_t),opt,sts);
+		pack_compress_block(mem,(masks.size() != 0)?&masks.get(0):NULL,masks.size(),1,opt,sts);
+
+		sgrid_pack_compress_prp<const decltype(chunks),T,S,chunking::size::value> pp(chunks,pnt,mem,opt,sts);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(pp);
+	}
+
+	/*! \brief Pack the sparse grid as a list of segments without copying the data
+	 *
+	 * A header segment with the sizes of the grid and the number of chunks is appended to segs,
+	 * followed by the chunk headers, the masks and the segments of the chunks (all the properties).
+	 * The segments are valid until the sparse grid is modified
+	 *
+	 * \param segs list where the segments are appended
+	 *
+	 */
+	void packSegments(Pack_segments & segs) const
+	{
+		size_t hdr[dim+1];
+		for (size_t i = 0 ; i < dim ; i++)
+		{hdr[i] = getGrid().size(i);}
+		hdr[dim] = header_inf.size();
+
+		segs.addHeader(hdr,dim+1);
+
+		segs.add((void *)&header_inf.get(0),header_inf.size()*sizeof(cheader<dim>));
+		segs.add((void *)&header_mask.get(0),header_mask.size()*sizeof(mheader<chunking::size::value>));
+
+		chunks.packSegments(segs);
+	}
+
+	/*! \brief Unpack a sparse grid from a list of segments produced by packSegments
+	 *
+	 * \param segs segments
+	 * \param id segment where the sparse grid start (its header), at the end the segment after the sparse grid
+	 *
+	 * \return false if the segments do not match the sparse grid, in this case the grid is not modified
+	 *
+	 */
+	bool unpackSegments(const Pack_segments & segs, size_t & id)
+	{
+		size_t sz[dim];
+		const size_t * hdr = pack_segments_header(segs,id,dim+1);
+
+		// there is always the background chunk
+		if (hdr == NULL || hdr[dim] == 0)
+		{return false;}
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = hdr[i];}
+
+		size_t n_cnk = hdr[dim];
+
+		// check everything before touching the grid, one chunk for each chunk header
+		Pack_segments exp;
+		exp.add(NULL,n_cnk*sizeof(cheader<dim>));
+		exp.add(NULL,n_cnk*sizeof(mheader<chunking::size::value>));
+
+		if (pack_segments_check(segs,id+1,exp) == false ||
+			decltype(chunks)::checkSegments(segs,id+3) == false ||
+			*(const size_t *)segs.getPointer(id+3) != n_cnk)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the segments do not match the sparse grid" << std::endl;
+			return false;
+		}
+
+		id++;
+
+		this->clear();
+
+		g_sm.setDimensions(sz);
+		set_g_shift_from_size(sz,g_sm_shift);
+
+		header_inf.resize(n_cnk);
+		header_mask.resize(n_cnk);
+
+		Pack_segments dst;
+		dst.add(&header_inf.get(0),n_cnk*sizeof(cheader<dim>));
+		dst.add(&header_mask.get(0),n_cnk*sizeof(mheader<chunking::size::value>));
+
+		pack_segments_copy(segs,id,dst);
+		chunks.unpackSegments(segs,id);
+
+		reconstruct_map();
+
+		return true;
+	}
+
 	/*! \brief It does materially nothing
 	 *
 	 */
@@ -1996,11 +2493,13 @@ public:
 	 */
 	size_t getChunk(grid_key_dx<dim> & v1, bool & exist)
 	{
-		size_t act_cnk = chunks.size()-1;
+		// the neighborhood chunks are rarely in cache, we do not use it, so the
+		// function can be called by multiple threads concurrently
+		long int lin_id = g_sm_shift.LinId(v1);
 
-		find_active_chunk(v1,act_cnk,exist);
-
-		return act_cnk;
+		size_t cnk;
+		exist = map.find(lin_id,cnk);
+		return (exist)?cnk:0;
 	}
 
 	/*! \brief Get the position of a chunk
@@ -2023,22 +2522,30 @@ public:
 
 	/*! \brief apply a convolution using the stencil N
 	 *
+	 * The chunks are divided across the OpenMP threads, so prop_dst must be different from prop_src.
+	 * In 3D the blocks are loaded with the block iterator, in the other dimensions the stencil
+	 * must not exceed the size of a chunk
 	 *
 	 */
 	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, unsigned int N, typename lambda_f, typename ... ArgsT >
-	void conv(int (& stencil)[N][dim], grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv(int (& stencil)[N][dim], grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
-		if (findNN == false)
-		{conv_impl<dim>::template conv<false,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv<true,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,func);}
+		conv_run_parts(header_inf.size()-1,[&](size_t part, size_t n_part)
+		{
+			if (findNN == false)
+			{conv_impl<dim>::template conv<false,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,part,n_part,func,args ...);}
+			else
+			{conv_impl<dim>::template conv<true,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,part,n_part,func,args ...);}
+		});
 
 		findNN = true;
 	}
 
 	/*! \brief apply a convolution from start to stop point using the function func and arguments args
+	 *
+	 * The chunks are divided across the OpenMP threads, so prop_dst must be different from prop_src
 	 *
 	 * \param start point
 	 * \param stop point
@@ -2047,14 +2554,17 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename lambda_f, typename ... ArgsT >
-	void conv_cross(grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv_cross(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(2*dim * chunks.size());
 
-		if (findNN == false)
-		{conv_impl<dim>::template conv_cross<false,prop_src,prop_dst,stencil_size>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross<true,prop_src,prop_dst,stencil_size>(start,stop,*this,func);}
+		conv_run_parts(header_inf.size()-1,[&](size_t part, size_t n_part)
+		{
+			if (findNN == false)
+			{conv_impl<dim>::template conv_cross<false,prop_src,prop_dst,stencil_size>(start,stop,*this,part,n_part,func,args ...);}
+			else
+			{conv_impl<dim>::template conv_cross<true,prop_src,prop_dst,stencil_size>(start,stop,*this,part,n_part,func,args ...);}
+		});
 
 		findNN = true;
 	}
@@ -2068,7 +2578,7 @@ public:
 	 *
 	 */
 	template<unsigned int stencil_size, typename prop_type, typename lambda_f, typename ... ArgsT >
-	void conv_cross_ids(grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv_cross_ids(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		if (layout_base<aggregate<int>>::type_value::value != SOA_layout_IA)
 		{
@@ -2077,10 +2587,13 @@ public:
 
 		NNlist.resize(2*dim * chunks.size());
 
-		if (findNN == false)
-		{conv_impl<dim>::template conv_cross_ids<false,stencil_size,prop_type>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross_ids<true,stencil_size,prop_type>(start,stop,*this,func);}
+		conv_run_parts(header_inf.size()-1,[&](size_t part, size_t n_part)
+		{
+			if (findNN == false)
+			{conv_impl<dim>::template conv_cross_ids<false,stencil_size,prop_type>(start,stop,*this,part,n_part,func,args ...);}
+			else
+			{conv_impl<dim>::template conv_cross_ids<true,stencil_size,prop_type>(start,stop,*this,part,n_part,func,args ...);}
+		});
 
 		findNN = true;
 	}
@@ -2090,14 +2603,17 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src1, unsigned int prop_src2 ,unsigned int prop_dst1, unsigned int prop_dst2 ,unsigned int stencil_size, unsigned int N, typename lambda_f, typename ... ArgsT >
-	void conv2(int (& stencil)[N][dim], grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv2(int (& stencil)[N][dim], grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
-		if (findNN == false)
-		{conv_impl<dim>::template conv2<false,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv2<true,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,func);}
+		conv_run_parts(header_inf.size()-1,[&](size_t part, size_t n_part)
+		{
+			if (findNN == false)
+			{conv_impl<dim>::template conv2<false,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,part,n_part,func,args ...);}
+			else
+			{conv_impl<dim>::template conv2<true,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,part,n_part,func,args ...);}
+		});
 
 		findNN = true;
 	}
@@ -2107,14 +2623,17 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src1, unsigned int prop_src2 ,unsigned int prop_dst1, unsigned int prop_dst2 ,unsigned int stencil_size, typename lambda_f, typename ... ArgsT >
-	void conv_cross2(grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv_cross2(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
-		if (findNN == false)
-		{conv_impl<dim>::template conv_cross2<false,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross2<true,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,func);}
+		conv_run_parts(header_inf.size()-1,[&](size_t part, size_t n_part)
+		{
+			if (findNN == false)
+			{conv_impl<dim>::template conv_cross2<false,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,part,n_part,func,args ...);}
+			else
+			{conv_impl<dim>::template conv_cross2<true,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,part,n_part,func,args ...);}
+		});
 
 		findNN = true;
 	}
@@ -2235,6 +2754,135 @@ public:
 		unpack<prp...>(mem,sub_it,ps,gpuContext,rem_copy_opt::NONE_OPT);
 	}
 
+	/*! \brief Unpack a sparse grid packed with packCompressed
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem preallocated memory from where to unpack the object
+	 * \param ps unpack statistic
+	 *
+	 * \return false if the data do not match the grid or are corrupted, in this case the
+	 *         grid is left empty
+	 *
+	 */
+	template<int ... prp, typename S2>
+	bool unpackCompressed(ExtPreAlloc<S2> & mem,
+						  Unpack_stat & ps)
+	{
+		this->clear();
+
+		size_t n_cnk;
+		size_t n_runs;
+		size_t sz[dim];
+
+		Unpacker<size_t,S2>::unpack(mem,n_cnk,ps);
+		Unpacker<size_t,S2>::unpack(mem,n_runs,ps);
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{Unpacker<size_t,S2>::unpack(mem,sz[i],ps);}
+
+		g_sm.setDimensions(sz);
+		set_g_shift_from_size(sz,g_sm_shift);
+
+		openfpm::vector<size_t> runs;
+		openfpm::vector<unsigned char> masks;
+		openfpm::vector<size_t> pnt;
+
+		const size_t n_bits = (chunking::size::value + 7) / 8;
+
+		// every chunk has at most one run and one mask
+		if (n_runs > n_cnk || n_cnk > g_sm_shift.size() || unpack_compress_block_size(mem,ps) > n_cnk*(1 + n_bits))
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the compressed sparse grid header is corrupted" << std::endl;
+			this->clear();
+			return false;
+		}
+
+		runs.resize(2*n_runs);
+		if (unpack_compress_block(mem,ps,(runs.size() != 0)?&runs.get(0):NULL,runs.size()*sizeof(size_t),sizeof(size_t)) == false)
+		{
+			this->clear();
+			return false;
+		}
+
+		masks.resize(unpack_compress_block_size(mem,ps));
+		if (unpack_compress_block(mem,ps,(masks.size() != 0)?&masks.get(0):NULL,masks.size(),1) == false)
+		{
+			this->clear();
+			return false;
+		}
+
+		// the runs must cover n_cnk chunk positions inside the grid and the masks n_cnk chunks
+
+		size_t n_run_cnk = 0;
+		bool valid = true;
+
+		for (size_t r = 0 ; r < n_runs ; r++)
+		{
+			valid &= runs.get(2*r) < g_sm_shift.size() && runs.get(2*r+1) <= g_sm_shift.size() - runs.get(2*r);
+			n_run_cnk += runs.get(2*r+1);
+		}
+
+		size_t m = 0;
+
+		for (size_t c = 0 ; c < n_cnk && valid == true ; c++)
+		{
+			valid &= m < masks.size() && masks.get(m) <= 1;
+			m += (valid == true && masks.get(m) == 1)?1:1 + n_bits;
+		}
+
+		if (valid == false || n_run_cnk != n_cnk || m != masks.size())
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the chunk positions or masks of the compressed sparse grid do not match" << std::endl;
+			this->clear();
+			return false;
+		}
+
+		// recreate the chunks
+
+		m = 0;
+
+		for (size_t r = 0 ; r < n_runs ; r++)
+		{
+			for (size_t lin = runs.get(2*r) ; lin < runs.get(2*r) + runs.get(2*r+1) ; lin++)
+			{
+				grid_key_dx<dim> pos = g_sm_shift.InvLinId(lin);
+				key_shift<dim,chunking>::cpos(pos);
+
+				bool full = masks.get(m) == 1;
+				const unsigned char * bits = &masks.get(m) + 1;
+				m += (full == true)?1:1 + n_bits;
+
+				for (size_t j = 0 ; j < chunking::size::value ; j++)
+				{
+					if (full == false && (bits[j / 8] & (1 << (j % 8))) == 0)
+					{continue;}
+
+					grid_key_dx<dim> v1;
+					for (size_t k = 0 ; k < dim ; k++)
+					{v1.set_d(k,pos.get(k) + pos_chunk[j].get(k));}
+
+					size_t active_cnk;
+					size_t ele_id;
+					pre_insert(v1,active_cnk,ele_id);
+
+					pnt.add(active_cnk * chunking::size::value + ele_id);
+				}
+			}
+		}
+
+		sgrid_unpack_compress_prp<decltype(chunks),T,S2,chunking::size::value> up(chunks,pnt,mem,ps);
+		boost::mpl::for_each_ref<typename pack_segments_prp<T,prp...>::type>(up);
+
+		if (up.ok == false)
+		{
+			this->clear();
+			return false;
+		}
+
+		return true;
+	}
+
 	/*! \brief unpack the sub-grid object applying an operation
 	 *
 	 * \tparam op operation
@@ -2360,6 +3008,7 @@ public:
 	 */
 	sgrid_cpu & operator=(const sgrid_cpu & sg)
 	{
+		cache_version++;
 		cache_pnt = sg.cache_pnt;
 
 		for (size_t i = 0 ; i < SGRID_CACHE ; i++)
@@ -2462,6 +3111,7 @@ public:
 	 */
 	sgrid_cpu & operator=(sgrid_cpu && sg)
 	{
+		cache_version++;
 		cache_pnt = sg.cache_pnt;
 
 		for (size_t i = 0 ; i < SGRID_CACHE ; i++)
@@ -2702,8 +3352,9 @@ template<unsigned int dim,
 		 typename grid_lin = grid_zm<dim,void>,
 		 typename layout = typename memory_traits_inte<T>::type,
 		 template<typename> class layout_base = memory_traits_inte,
-		 typename chunking = default_chunking<dim>>
-using sgrid_soa = sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking>;
+		 typename chunking = default_chunking<dim>,
+		 typename chunk_index = sgrid_index_hopscotch>
+using sgrid_soa = sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking,chunk_index>;
 
 
 #endif /* OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRID_HPP_ */
@@ -13,6 +13,8 @@ const static int cnk_nele = 1;
 const static int cnk_mask = 2;
 
 #include "util/sparsegrid_util_common.hpp"
+#include "SparseGrid_chunk_index.hpp"
+#include "Packer_Unpacker/Pack_compress.hpp"
 
 //! sizeof the cache
 #define SGRID_CACHE 2
@@ -20,6 +22,50 @@ const static int cnk_mask = 2;
 //! When we have more that 1024 to remove remove them
 #define FLUSH_REMOVE 1024
 
+//! Number of parts of chunks for each thread in the parallel convolutions
+#define SGRID_CONV_PARTS_PER_THREAD 8
+
+/*! \brief Chunk cache for the readers of a sparse grid
+ *
+ * The sparse grid has an internal cache of the last chunks accessed, that is written
+ * also by the const get. Threads that read the same grid concurrently must use their
+ * own cache (one per thread or per iterator) and the get/existPoint overloads that
+ * accept it. The cache is automatically invalidated if the grid change its chunk structure
+ *
+ */
+struct sgrid_chunk_cache
+{
+	//! cache pointer
+	size_t cache_pnt;
+
+	//! cache
+	long int cache[SGRID_CACHE];
+
+	//! cached id
+	long int cached_id[SGRID_CACHE];
+
+	//! grid that filled the cache
+	const void * owner;
+
+	//! version of the chunk structure of the grid when the cache has been filled
+	size_t version;
+
+	//! Constructor
+	sgrid_chunk_cache()
+	:owner(NULL),version(0)
+	{
+		clear();
+	}
+
+	//! Invalidate the cache
+	inline void clear()
+	{
+		cache_pnt = 0;
+		for (size_t i = 0 ; i < SGRID_CACHE ; i++)
+		{cache[i] = -1;}
+	}
+};
+
 template<typename T>
 struct encapsulated_type
 {
@@ -201,14 +247,14 @@ struct default_chunking<6>
 							   boost::mpl::int_<2>,
 							   boost::mpl::int_<2>,
 							   boost::mpl::int_<2>,
-							   boost::mpl::int_<2>> shift_c;
+							   boost::mpl::int_<2>> shift;
 
 	typedef boost::mpl::vector<boost::mpl::int_<2>,
 			                   boost::mpl::int_<4>,
 							   boost::mpl::int_<6>,
 							   boost::mpl::int_<8>,
 							   boost::mpl::int_<10>,
-							   boost::mpl::int_<12>> shift;
+							   boost::mpl::int_<12>> shift_c;
 
 	typedef boost::mpl::int_<4096> size;
 };
@@ -284,7 +330,8 @@ template<unsigned int dim,
 		 typename grid_lin = grid_sm<dim,void>,
 		 typename layout=typename memory_traits_lin<T>::type,
 		 template<typename> class layout_base = memory_traits_lin,
-		 typename chunking = default_chunking<dim>>
+		 typename chunking = default_chunking<dim>,
+		 typename chunk_index = sgrid_index_hopscotch>
 class sgrid_cpu;
 
 
@@ -395,22 +442,22 @@ struct key_shift<4,chunk>
 {
 	inline static void shift(grid_key_dx<4> & kh, grid_key_dx<4> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<4> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
 	}
 };
 
@@ -431,25 +478,25 @@ struct key_shift<5,chunk>
 {
 	inline static void shift(grid_key_dx<5> & kh, grid_key_dx<5> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<5> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
 	}
 
 };
@@ -471,28 +518,28 @@ struct key_shift<6,chunk>
 {
 	inline static void shift(grid_key_dx<6> & kh, grid_key_dx<6> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<6> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) << boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
 	}
 };
 
@@ -516,31 +563,31 @@ struct key_shift<7,chunk>
 {
 	inline static void shift(grid_key_dx<7> & kh, grid_key_dx<7> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kl.set_d(6,kh.get(6) & (boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value - 1));
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kl.set_d(6,kh.get(6) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<6>>::type::value - 1));
+		kh.set_d(6,kh.get(6) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<7> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) << boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kh.set_d(6,kh.get(6) << boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kh.set_d(6,kh.get(6) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
 	}
 };
 
@@ -563,34 +610,34 @@ struct key_shift<8,chunk>
 {
 	inline static void shift(grid_key_dx<8> & kh, grid_key_dx<8> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kl.set_d(6,kh.get(6) & (boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value - 1));
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
-		kl.set_d(7,kh.get(7) & (boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value - 1));
-		kh.set_d(7,kh.get(7) >> boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kl.set_d(6,kh.get(6) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<6>>::type::value - 1));
+		kh.set_d(6,kh.get(6) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
+		kl.set_d(7,kh.get(7) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<7>>::type::value - 1));
+		kh.set_d(7,kh.get(7) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<7>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<8> & kh)
 	{
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
-		kh.set_d(7,kh.get(7) >> boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kh.set_d(6,kh.get(6) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
+		kh.set_d(7,kh.get(7) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<7>>::type::value);
 	}
 };
 
@@ -643,4 +690,136 @@ struct get_selector<T[N1]>
 	}
 };
 
+/*! \brief For each property pack in a compressed block the values of a list of points of a sparse grid
+ *
+ * \tparam chunks_type vector of chunks
+ * \tparam T aggregate
+ * \tparam Mem memory
+ * \tparam n_ele number of elements in a chunk
+ *
+ */
+template<typename chunks_type, typename T, typename Mem, unsigned int n_ele>
+struct sgrid_pack_compress_prp
+{
+	//! chunks
+	chunks_type & chunks;
+
+	//! points to pack (chunk * n_ele + element in the chunk)
+	const openfpm::vector<size_t> & pnt;
+
+	//! memory where to pack
+	ExtPreAlloc<Mem> & mem;
+
+	//! compression option
+	int opt;
+
+	//! pack statistic
+	Pack_stat & sts;
+
+	/*! \brief constructor
+	 *
+	 * \param chunks chunks
+	 * \param pnt points to pack
+	 * \param mem memory where to pack
+	 * \param opt compression option
+	 * \param sts pack statistic
+	 *
+	 */
+	sgrid_pack_compress_prp(chunks_type & chunks, const openfpm::vector<size_t> & pnt, ExtPreAlloc<Mem> & mem, int opt, Pack_stat & sts)
+	:chunks(chunks),pnt(pnt),mem(mem),opt(opt),sts(sts)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef pack_compress_prp<prop> sel;
+		typedef typename sel::base base;
+
+		std::vector<base> buf(pnt.size()*sel::n_comp);
+
+		size_t k = 0;
+		for (size_t c = 0 ; c < sel::n_comp ; c++)
+		{
+			for (size_t i = 0 ; i < pnt.size() ; i++, k++)
+			{
+				size_t id = pnt.get(i);
+				buf[k] = sel::comp(chunks.template get<tprp::value>(id / n_ele),c)[id % n_ele];
+			}
+		}
+
+		pack_compress_block(mem,buf.data(),buf.size()*sizeof(base),sizeof(base),opt,sts);
+	}
+};
+
+/*! \brief For each property unpack a compressed block into a list of points of a sparse grid
+ *
+ * \tparam chunks_type vector of chunks
+ * \tparam T aggregate
+ * \tparam Mem memory
+ * \tparam n_ele number of elements in a chunk
+ *
+ */
+template<typename chunks_type, typename T, typename Mem, unsigned int n_ele>
+struct sgrid_unpack_compress_prp
+{
+	//! chunks
+	chunks_type & chunks;
+
+	//! points to unpack (chunk * n_ele + element in the chunk)
+	const openfpm::vector<size_t> & pnt;
+
+	//! memory from where to unpack
+	ExtPreAlloc<Mem> & mem;
+
+	//! unpack statistic
+	Unpack_stat & ps;
+
+	//! false if a block does not match or is corrupted, the following blocks are skipped
+	bool ok = true;
+
+	/*! \brief constructor
+	 *
+	 * \param chunks chunks
+	 * \param pnt points to unpack
+	 * \param mem memory from where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	sgrid_unpack_compress_prp(chunks_type & chunks, const openfpm::vector<size_t> & pnt, ExtPreAlloc<Mem> & mem, Unpack_stat & ps)
+	:chunks(chunks),pnt(pnt),mem(mem),ps(ps)
+	{}
+
+	//! It call the functor for each property
+	template<typename tprp>
+	inline void operator()(tprp & t)
+	{
+		if (ok == false)
+		{return;}
+
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<tprp::value>>::type prop;
+		typedef pack_compress_prp<prop> sel;
+		typedef typename sel::base base;
+
+		std::vector<base> buf(pnt.size()*sel::n_comp);
+
+		if (unpack_compress_block(mem,ps,buf.data(),buf.size()*sizeof(base),sizeof(base)) == false)
+		{
+			ok = false;
+			return;
+		}
+
+		size_t k = 0;
+		for (size_t c = 0 ; c < sel::n_comp ; c++)
+		{
+			for (size_t i = 0 ; i < pnt.size() ; i++, k++)
+			{
+				size_t id = pnt.get(i);
+				sel::comp(chunks.template get<tprp::value>(id / n_ele),c)[id % n_ele] = buf[k];
+			}
+		}
+	}
+};
+
 #endif /* OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRIDUTIL_HPP_ */
@@ -0,0 +1,452 @@
+/*
+ * SparseGrid_chunk_index.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRID_CHUNK_INDEX_HPP_
+#define OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRID_CHUNK_INDEX_HPP_
+
+#include "hash_map/hopscotch_map.h"
+#include "Vector/map_vector.hpp"
+#include <algorithm>
+
+//! Maximum number of chunk positions covered by the direct table of sgrid_index_dense
+#ifndef SGRID_INDEX_DENSE_MAX
+#define SGRID_INDEX_DENSE_MAX (1 << 24)
+#endif
+
+//! Average number of chunks for each bucket of the interpolation table of sgrid_index_sorted
+#define SGRID_INDEX_BUCKET_SIZE 4
+
+//! Minimum size of the insert buffer of sgrid_index_sorted before it is merged
+#define SGRID_INDEX_DELTA_MIN 256
+
+/*! \brief Entry of a chunk index
+ *
+ * linearized position of the chunk (in the grid of the chunks) and chunk id
+ *
+ */
+struct sgrid_index_entry
+{
+	//! linearized chunk position
+	size_t lin_id;
+
+	//! chunk id
+	size_t cnk;
+
+	//! order by position
+	bool operator<(const sgrid_index_entry & e) const
+	{
+		return lin_id < e.lin_id;
+	}
+};
+
+/*! \brief Chunk index of sgrid_cpu based on an hopscotch hash map
+ *
+ * Every chunk index backend map the linearized position of a chunk to its id with the following interface
+ *
+ * * setDomain(n) the linearized positions are in [0,n)
+ * * find(lin_id,cnk) return true and the chunk id if the chunk exist
+ * * insert(lin_id,cnk) add a chunk that does not exist
+ * * build(e) replace the content with the entries e (e can be reordered)
+ * * clear() and swap(idx)
+ *
+ * find does not modify the index, so it can be called by multiple threads concurrently
+ *
+ */
+class sgrid_index_hopscotch
+{
+	//! map from chunk position to chunk id
+	tsl::hopscotch_map<size_t, size_t> map;
+
+public:
+
+	/*! \brief Set the range of the linearized chunk positions (unused)
+	 *
+	 * \param n number of chunk positions
+	 *
+	 */
+	void setDomain(size_t n)
+	{}
+
+	/*! \brief Find a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk output chunk id
+	 *
+	 * \return true if the chunk exist
+	 *
+	 */
+	inline bool find(size_t lin_id, size_t & cnk) const
+	{
+		auto fnd = map.find(lin_id);
+		if (fnd == map.end())
+		{return false;}
+
+		cnk = fnd->second;
+		return true;
+	}
+
+	/*! \brief Add a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk chunk id
+	 *
+	 */
+	inline void insert(size_t lin_id, size_t cnk)
+	{
+		map[lin_id] = cnk;
+	}
+
+	/*! \brief Replace the content of the index
+	 *
+	 * \param e entries
+	 *
+	 */
+	void build(openfpm::vector<sgrid_index_entry> & e)
+	{
+		map.clear();
+		for (size_t i = 0 ; i < e.size() ; i++)
+		{map[e.get(i).lin_id] = e.get(i).cnk;}
+	}
+
+	//! Remove all the chunks
+	void clear()
+	{
+		map.clear();
+	}
+
+	/*! \brief Swap the content of two indexes
+	 *
+	 * \param idx index to swap with
+	 *
+	 */
+	void swap(sgrid_index_hopscotch & idx)
+	{
+		map.swap(idx.map);
+	}
+};
+
+/*! \brief Chunk index of sgrid_cpu based on a direct table over the grid of the chunks
+ *
+ * Every position of the grid of the chunks has an entry with the chunk id (0 if the chunk does not exist,
+ * the chunk 0 is the background chunk), a lookup is a single load. It is intended for grids with a small
+ * bounding box, when the grid of the chunks has more than SGRID_INDEX_DENSE_MAX positions an hopscotch
+ * map is used instead
+ *
+ */
+class sgrid_index_dense
+{
+	//! chunk id for each chunk position
+	openfpm::vector<unsigned int> table;
+
+	//! map used for the positions outside the table
+	tsl::hopscotch_map<size_t, size_t> map;
+
+public:
+
+	/*! \brief Set the range of the linearized chunk positions and re-insert the chunks
+	 *
+	 * \param n number of chunk positions
+	 *
+	 */
+	void setDomain(size_t n)
+	{
+		n = (n > SGRID_INDEX_DENSE_MAX)?0:n;
+
+		if (n == table.size())
+		{return;}
+
+		openfpm::vector<sgrid_index_entry> e;
+
+		for (size_t i = 0 ; i < table.size() ; i++)
+		{
+			if (table.get(i) != 0)
+			{
+				e.add();
+				e.last().lin_id = i;
+				e.last().cnk = table.get(i);
+			}
+		}
+
+		for (auto & m : map)
+		{
+			e.add();
+			e.last().lin_id = m.first;
+			e.last().cnk = m.second;
+		}
+
+		table.resize(n);
+		build(e);
+	}
+
+	/*! \brief Find a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk output chunk id
+	 *
+	 * \return true if the chunk exist
+	 *
+	 */
+	inline bool find(size_t lin_id, size_t & cnk) const
+	{
+		if (lin_id < table.size())
+		{
+			cnk = table.get(lin_id);
+			return cnk != 0;
+		}
+
+		auto fnd = map.find(lin_id);
+		if (fnd == map.end())
+		{return false;}
+
+		cnk = fnd->second;
+		return true;
+	}
+
+	/*! \brief Add a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk chunk id
+	 *
+	 */
+	inline void insert(size_t lin_id, size_t cnk)
+	{
+		if (lin_id < table.size())
+		{table.get(lin_id) = cnk;}
+		else
+		{map[lin_id] = cnk;}
+	}
+
+	/*! \brief Replace the content of the index
+	 *
+	 * \param e entries
+	 *
+	 */
+	void build(openfpm::vector<sgrid_index_entry> & e)
+	{
+		clear();
+		for (size_t i = 0 ; i < e.size() ; i++)
+		{insert(e.get(i).lin_id,e.get(i).cnk);}
+	}
+
+	//! Remove all the chunks
+	void clear()
+	{
+		if (table.size() != 0)
+		{std::fill(&table.get(0),&table.get(0) + table.size(),0);}
+
+		map.clear();
+	}
+
+	/*! \brief Swap the content of two indexes
+	 *
+	 * \param idx index to swap with
+	 *
+	 */
+	void swap(sgrid_index_dense & idx)
+	{
+		table.swap(idx.table);
+		map.swap(idx.map);
+	}
+};
+
+/*! \brief Chunk index of sgrid_cpu based on a sorted array of chunk positions
+ *
+ * The chunks are stored sorted by linearized position (Morton order when the grid use the grid_zm
+ * linearizer). A table of buckets over the high bits of the position (a piecewise-linear interpolation
+ * of the distribution of the positions) restrict each search to few elements. New chunks are added
+ * to a small sorted buffer that is merged when it reach the square root of the number of chunks, so
+ * the insert cost stay sub-linear
+ *
+ */
+class sgrid_index_sorted
+{
+	//! sorted chunks
+	openfpm::vector<sgrid_index_entry> e;
+
+	//! sorted chunks inserted after the last merge
+	openfpm::vector<sgrid_index_entry> delta;
+
+	//! for each bucket the first chunk with (lin_id >> shift) >= bucket (one more element at the end)
+	openfpm::vector<size_t> bucket;
+
+	//! shift that give the bucket of a position
+	size_t shift = 0;
+
+	//! rebuild the bucket table
+	void build_buckets()
+	{
+		bucket.clear();
+		shift = 0;
+
+		if (e.size() == 0)
+		{return;}
+
+		size_t nb = 1;
+		while (nb * SGRID_INDEX_BUCKET_SIZE < e.size())
+		{nb *= 2;}
+
+		size_t max_id = e.last().lin_id;
+		while ((max_id >> shift) >= nb)
+		{shift++;}
+
+		bucket.resize(nb + 1);
+
+		size_t j = 0;
+		for (size_t b = 0 ; b <= nb ; b++)
+		{
+			while (j < e.size() && (e.get(j).lin_id >> shift) < b)
+			{j++;}
+
+			bucket.get(b) = j;
+		}
+	}
+
+	//! merge the insert buffer into the sorted chunks
+	void merge()
+	{
+		openfpm::vector<sgrid_index_entry> m;
+		m.resize(e.size() + delta.size());
+
+		if (m.size() != 0)
+		{
+			const sgrid_index_entry * ep = (e.size() != 0)?&e.get(0):NULL;
+			const sgrid_index_entry * dp = (delta.size() != 0)?&delta.get(0):NULL;
+
+			std::merge(ep,ep + e.size(),dp,dp + delta.size(),&m.get(0));
+		}
+
+		e.swap(m);
+		delta.clear();
+
+		build_buckets();
+	}
+
+	/*! \brief Search a position in a sorted range
+	 *
+	 * \param a first element of the range
+	 * \param n number of elements
+	 * \param lin_id position to search
+	 * \param cnk output chunk id
+	 *
+	 * \return true if found
+	 *
+	 */
+	static inline bool search(const sgrid_index_entry * a, size_t n, size_t lin_id, size_t & cnk)
+	{
+		if (n == 0)
+		{return false;}
+
+		while (n > 1)
+		{
+			size_t half = n / 2;
+			a = (a[half].lin_id <= lin_id)?a+half:a;
+			n -= half;
+		}
+
+		cnk = a->cnk;
+		return a->lin_id == lin_id;
+	}
+
+public:
+
+	/*! \brief Set the range of the linearized chunk positions (unused)
+	 *
+	 * \param n number of chunk positions
+	 *
+	 */
+	void setDomain(size_t n)
+	{}
+
+	/*! \brief Find a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk output chunk id
+	 *
+	 * \return true if the chunk exist
+	 *
+	 */
+	inline bool find(size_t lin_id, size_t & cnk) const
+	{
+		size_t b = lin_id >> shift;
+
+		if (b + 1 < bucket.size())
+		{
+			size_t start = bucket.get(b);
+			if (search(&e.get(0) + start,bucket.get(b+1) - start,lin_id,cnk) == true)
+			{return true;}
+		}
+
+		if (delta.size() != 0)
+		{return search(&delta.get(0),delta.size(),lin_id,cnk);}
+
+		return false;
+	}
+
+	/*! \brief Add a chunk
+	 *
+	 * \param lin_id linearized chunk position
+	 * \param cnk chunk id
+	 *
+	 */
+	inline void insert(size_t lin_id, size_t cnk)
+	{
+		sgrid_index_entry en;
+		en.lin_id = lin_id;
+		en.cnk = cnk;
+
+		size_t pos = 0;
+		if (delta.size() != 0)
+		{pos = std::upper_bound(&delta.get(0),&delta.get(0) + delta.size(),en) - &delta.get(0);}
+
+		delta.add();
+		std::copy_backward(&delta.get(0) + pos,&delta.get(0) + delta.size() - 1,&delta.get(0) + delta.size());
+		delta.get(pos) = en;
+
+		if (delta.size() >= SGRID_INDEX_DELTA_MIN && delta.size() * delta.size() >= e.size())
+		{merge();}
+	}
+
+	/*! \brief Replace the content of the index
+	 *
+	 * \param en entries, they are sorted
+	 *
+	 */
+	void build(openfpm::vector<sgrid_index_entry> & en)
+	{
+		if (en.size() != 0)
+		{std::sort(&en.get(0),&en.get(0) + en.size());}
+
+		e = en;
+		delta.clear();
+
+		build_buckets();
+	}
+
+	//! Remove all the chunks
+	void clear()
+	{
+		e.clear();
+		delta.clear();
+		bucket.clear();
+		shift = 0;
+	}
+
+	/*! \brief Swap the content of two indexes
+	 *
+	 * \param idx index to swap with
+	 *
+	 */
+	void swap(sgrid_index_sorted & idx)
+	{
+		e.swap(idx.e);
+		delta.swap(idx.delta);
+		bucket.swap(idx.bucket);
+		std::swap(shift,idx.shift);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRID_CHUNK_INDEX_HPP_ */
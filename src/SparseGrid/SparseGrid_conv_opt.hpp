@@ -8,6 +8,11 @@
 #ifndef SPARSEGRID_CONV_OPT_HPP_
 #define SPARSEGRID_CONV_OPT_HPP_
 
+#include "util/mathutil.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
 template<unsigned int l>
 union data_il
 {
@@ -63,24 +68,728 @@ struct ids_crs
 
 
 
+/*! \brief Run the function f over the chunks of a sparse grid divided in parts
+ *
+ * The active chunks are divided in contiguous parts, several for each thread, and the parts are
+ * distributed dynamically across the OpenMP threads, because chunks can have a very different
+ * number of active points. f(part,n_part) must only write the chunks of its part.
+ *
+ * \param n_chunks number of chunks
+ * \param f function to call for each part
+ *
+ */
+template<typename lambda_part>
+static inline void conv_run_parts(size_t n_chunks, lambda_part f)
+{
+	size_t n_part = 1;
+
+#ifdef HAVE_OPENMP
+	n_part = SGRID_CONV_PARTS_PER_THREAD*omp_get_max_threads();
+#endif
+
+	n_part = (n_part > n_chunks)?n_chunks:n_part;
+	n_part = (n_part == 0)?1:n_part;
+
+	#pragma omp parallel for schedule(dynamic) if (n_part > 1)
+	for (size_t part = 0 ; part < n_part ; part++)
+	{f(part,n_part);}
+}
+
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU) || defined(__HIP__)
+
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * It copy the chunk sizes into a runtime array
+ *
+ */
+template<unsigned int dim, typename mpl_v>
+struct conv_chunk_sz
+{
+	//! chunk sizes
+	int (& sz)[dim];
+
+	/*! \brief constructor
+	 *
+	 * \param sz runtime sz to fill
+	 *
+	 */
+	inline conv_chunk_sz(int (& sz)[dim])
+	:sz(sz)
+	{};
+
+	//! It copy the size of the dimension T
+	template<typename T>
+	inline void operator()(T& t) const
+	{
+		sz[T::value] = boost::mpl::at<mpl_v,boost::mpl::int_<T::value>>::type::value;
+	}
+};
+
+/*! \brief Neighborhood of a chunk for the dimension generic convolutions
+ *
+ * It store the ids of the 3^dim chunks around a chunk, so a point of the chunk shifted by
+ * at most the chunk size can be resolved without touching the chunk map. Not existing
+ * chunks, or chunks outside the grid, are mapped to the background chunk 0
+ *
+ * \tparam dim dimensionality
+ * \tparam SparseGridType sparse grid
+ *
+ */
+template<unsigned int dim, typename SparseGridType>
+struct conv_chunk_nn
+{
+	//! number of neighborhood chunks (including the chunk itself)
+	static const int nNN = openfpm::math::pow(3,dim);
+
+	//! chunk size
+	int sz[dim];
+
+	//! stride of each dimension inside the chunk
+	int str[dim];
+
+	//! neighborhood chunks
+	long int nn[nNN];
+
+	//! Constructor
+	conv_chunk_nn()
+	{
+		conv_chunk_sz<dim,typename SparseGridType::chunking_type::type> ccs(sz);
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,dim>>(ccs);
+
+		str[0] = 1;
+		for (size_t i = 1 ; i < dim ; i++)
+		{str[i] = str[i-1]*sz[i-1];}
+	}
+
+	/*! \brief Find the neighborhood chunks of the chunk cid
+	 *
+	 * \param grid sparse grid
+	 * \param cid chunk
+	 *
+	 */
+	void fill(SparseGridType & grid, size_t cid)
+	{
+		grid_key_dx<dim> cp = grid.getChunkPos(cid);
+
+		for (int n = 0 ; n < nNN ; n++)
+		{
+			grid_key_dx<dim> p;
+			bool inside = true;
+
+			int r = n;
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				long int c = cp.get(i) + (r % 3) - 1;
+				r /= 3;
+
+				p.set_d(i,c);
+				inside &= (c >= 0 && c*sz[i] <= (long int)grid.getGrid().size(i));
+			}
+
+			bool exist;
+			nn[n] = (inside == true)?grid.getChunk(p,exist):0;
+		}
+	}
+
+	/*! \brief Given a point in local coordinates of the chunk return the chunk and the position in the chunk
+	 *
+	 * \param lp local coordinates (they can go outside the chunk by at most one chunk size)
+	 * \param cnk chunk
+	 * \param sub position in the chunk
+	 *
+	 */
+	inline void get(const int (& lp)[dim], long int & cnk, int & sub) const
+	{
+		int n = 0;
+		int m = 1;
+		sub = 0;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			int s = (lp[i] < 0)?0:((lp[i] >= sz[i])?2:1);
+
+			n += s*m;
+			m *= 3;
+			sub += (lp[i] - (s-1)*sz[i])*str[i];
+		}
+
+		cnk = nn[n];
+	}
+};
+
+/*! \brief Cross stencil for the dimension generic conv_cross
+ *
+ * xm[i] and xp[i] are the neighborhood points in direction -i and +i
+ *
+ */
+template<unsigned int dim, typename prop_type>
+struct cross_stencil_nd_v
+{
+	//! neighborhood in negative direction
+	Vc::Vector<prop_type> xm[dim];
+
+	//! neighborhood in positive direction
+	Vc::Vector<prop_type> xp[dim];
+};
+
+/*! \brief Rows of a stencil for the dimension generic convolutions
+ *
+ * The points of a chunk are processed row by row (a row is a line in dimension 0).
+ * The rows touched by the stencil without a shift in dimension 0 are read directly from the
+ * chunks, the others are copied, with an halo taken from the neighborhood chunks, into
+ * contiguous buffers. The stencil points are then loaded with unaligned vector loads
+ *
+ * \tparam dim dimensionality
+ * \tparam prop_type type of the properties to load
+ * \tparam n_prop number of properties to load
+ *
+ */
+template<unsigned int dim, typename prop_type, unsigned int n_prop>
+struct conv_nd_rows
+{
+	typedef Vc::Vector<prop_type> vtype;
+
+	//! offsets of the rows (in dimension 0 is zero), the row 0 is the central row
+	openfpm::vector<grid_key_dx<dim>> rows;
+
+	//! halo of each row in dimension 0 (0 if the row can be read directly from the chunk)
+	openfpm::vector<int> row_halo;
+
+	//! for each stencil point the row
+	openfpm::vector<int> st_row;
+
+	//! for each stencil point the shift in dimension 0
+	openfpm::vector<int> st_d0;
+
+	//! maximum halo in dimension 0
+	int halo;
+
+	//! size of the chunk in dimension 0
+	int sz0;
+
+	//! size of the row buffers
+	int row_len;
+
+	//! row buffers for each property
+	openfpm::vector<prop_type> buf[n_prop];
+
+	//! pointer to the element 0 of each row for each property
+	openfpm::vector<const prop_type *> rp[n_prop];
+
+	//! mask row buffers
+	openfpm::vector<unsigned char> mbuf;
+
+	//! pointer to the element 0 of each mask row
+	openfpm::vector<const unsigned char *> rm;
+
+	//! for each point of the central row the number of existing stencil points
+	openfpm::vector<unsigned char> msum;
+
+	//! for each point of the central row if it has to be processed
+	openfpm::vector<unsigned char> ok;
+
+	/*! \brief Constructor
+	 *
+	 * \param stencil stencil points
+	 * \param n_st number of stencil points
+	 * \param sz0 size of the chunk in dimension 0
+	 *
+	 */
+	template<typename stencil_type>
+	conv_nd_rows(const stencil_type & stencil, int n_st, int sz0)
+	:halo(0),sz0(sz0)
+	{
+		grid_key_dx<dim> zero;
+		zero.zero();
+		rows.add(zero);
+		row_halo.add(0);
+
+		for (int s = 0 ; s < n_st ; s++)
+		{
+			grid_key_dx<dim> r;
+			r.set_d(0,0);
+			for (size_t i = 1 ; i < dim ; i++)
+			{r.set_d(i,stencil[s][i]);}
+
+			size_t k = 0;
+			for ( ; k < rows.size() ; k++)
+			{
+				if (rows.get(k) == r)	{break;}
+			}
+
+			if (k == rows.size())
+			{
+				rows.add(r);
+				row_halo.add(0);
+			}
+
+			st_row.add(k);
+			st_d0.add(stencil[s][0]);
+			row_halo.get(k) = std::max(row_halo.get(k),std::abs(stencil[s][0]));
+			halo = std::max(halo,std::abs(stencil[s][0]));
+		}
+
+		// a vector bigger than a row cannot be loaded directly from the chunk
+		if ((int)vtype::Size > sz0)
+		{
+			for (size_t r = 0 ; r < row_halo.size() ; r++)
+			{row_halo.get(r) = std::max(row_halo.get(r),1);}
+			halo = std::max(halo,1);
+		}
+
+		row_len = sz0 + 2*halo + vtype::Size;
+
+		for (size_t p = 0 ; p < n_prop ; p++)
+		{
+			buf[p].resize(row_len * rows.size());
+			std::fill(&buf[p].template get<0>(0),&buf[p].template get<0>(0) + buf[p].size(),0);
+			rp[p].resize(rows.size());
+		}
+
+		mbuf.resize(row_len * rows.size());
+		std::fill(&mbuf.template get<0>(0),&mbuf.template get<0>(0) + mbuf.size(),0);
+		rm.resize(rows.size());
+
+		msum.resize(row_len);
+		ok.resize(row_len);
+	}
+
+	/*! \brief Copy a segment of a row of the chunks into a buffer
+	 *
+	 * \param dst destination
+	 * \param cnn neighborhood of the chunk
+	 * \param lp point in local coordinates where the segment start
+	 * \param n number of elements
+	 * \param src_f function that given chunk and position return the pointer of the source
+	 *
+	 */
+	template<typename T, typename cnn_type, typename src_func>
+	static inline void copy_segment(T * dst, const cnn_type & cnn, const int (& lp)[dim], int n, src_func src_f)
+	{
+		long int cnk;
+		int sub;
+		cnn.get(lp,cnk,sub);
+
+		const T * src = src_f(cnk,sub);
+		std::copy(src,src+n,dst);
+	}
+
+	/*! \brief Set the pointers of the rows around the row lp, copying the rows that need an halo
+	 *
+	 * \param cnn neighborhood of the chunk
+	 * \param lp row in local coordinates
+	 * \param src_f function that given the chunk and the position in the chunk return the pointer of the source
+	 * \param buf_f function that given the row return the buffer
+	 * \param ptr output pointer to the element 0 of each row
+	 *
+	 */
+	template<typename T, typename cnn_type, typename src_func, typename buf_func>
+	inline void load_rows(const cnn_type & cnn, const int (& lp)[dim], src_func src_f, buf_func buf_f, openfpm::vector<const T *> & ptr)
+	{
+		for (size_t r = 0 ; r < rows.size() ; r++)
+		{
+			int q[dim];
+			for (size_t i = 0 ; i < dim ; i++)
+			{q[i] = lp[i] + rows.get(r).get(i);}
+			q[0] = 0;
+
+			int h = row_halo.get(r);
+
+			if (h == 0)
+			{
+				long int cnk;
+				int sub;
+				cnn.get(q,cnk,sub);
+
+				ptr.get(r) = src_f(cnk,sub);
+				continue;
+			}
+
+			T * dst = buf_f(r) + halo;
+
+			copy_segment<T>(dst,cnn,q,sz0,src_f);
+
+			q[0] = -h;
+			copy_segment<T>(dst - h,cnn,q,h,src_f);
+
+			q[0] = sz0;
+			copy_segment<T>(dst + sz0,cnn,q,h,src_f);
+
+			ptr.get(r) = dst;
+		}
+	}
+
+	/*! \brief Load the masks of the rows around lp and calculate the points to process
+	 *
+	 * \param grid sparse grid
+	 * \param cnn neighborhood of the chunk
+	 * \param lp row in local coordinates
+	 * \param lo0 first point to process
+	 * \param hi0 last point to process
+	 *
+	 * \return false if in the row there are not points to process
+	 *
+	 */
+	template<typename SparseGridType, typename cnn_type>
+	inline bool load_masks(SparseGridType & grid, const cnn_type & cnn, const int (& lp)[dim], int lo0, int hi0)
+	{
+		auto & headers = grid.private_get_header_mask();
+
+		// first the central row, if there are not points we skip the row
+
+		long int cnk;
+		int sub;
+		cnn.get(lp,cnk,sub);
+
+		auto & hm = headers.get(cnk);
+
+		bool any = false;
+		for (int x = lo0 ; x <= hi0 ; x++)
+		{
+			ok.get(x) = hm.mask[sub+x] & 1;
+			any |= (ok.get(x) != 0);
+		}
+
+		if (any == false)	{return false;}
+
+		for (int x = 0 ; x < lo0 ; x++)	{ok.get(x) = 0;}
+		for (int x = hi0+1 ; x < row_len ; x++)	{ok.get(x) = 0;}
+
+		load_rows<unsigned char>(cnn,lp,[&](long int cnk, int sub){return (const unsigned char *)&headers.get(cnk).mask[sub];},
+				                        [&](int r){return &mbuf.template get<0>(r*row_len);},rm);
+
+		unsigned char * ms = &msum.template get<0>(0);
+		std::fill(ms,ms+sz0,0);
+
+		for (size_t s = 0 ; s < st_row.size() ; s++)
+		{
+			const unsigned char * m = rm.get(st_row.get(s)) + st_d0.get(s);
+
+			for (int x = 0 ; x < sz0 ; x++)
+			{ms[x] += m[x] & 1;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Load the property prop of the rows around lp as property p
+	 *
+	 * \param grid sparse grid
+	 * \param cnn neighborhood of the chunk
+	 * \param lp row in local coordinates
+	 *
+	 */
+	template<unsigned int prop, unsigned int p, typename SparseGridType, typename cnn_type>
+	inline void load_prop(SparseGridType & grid, const cnn_type & cnn, const int (& lp)[dim])
+	{
+		auto & datas = grid.private_get_data();
+
+		load_rows<prop_type>(cnn,lp,[&](long int cnk, int sub){return (const prop_type *)&datas.get(cnk).template get<prop>()[sub];},
+				                    [&](int r){return &buf[p].template get<0>(r*row_len);},rp[p]);
+	}
+
+	/*! \brief Return the mask of the points to process in the group starting at x0
+	 *
+	 * \param cmp mask
+	 * \param x0 first point of the group
+	 *
+	 * \return false if there are not points to process
+	 *
+	 */
+	inline bool group_mask(Vc::Mask<prop_type> & cmp, int x0)
+	{
+		bool any = false;
+		for (int l = 0 ; l < (int)vtype::Size ; l++)
+		{
+			cmp[l] = (ok.get(x0+l) != 0);
+			any |= (ok.get(x0+l) != 0);
+		}
+
+		return any;
+	}
+
+	/*! \brief Load the central point of a group
+	 *
+	 * \param x0 first point of the group
+	 *
+	 */
+	template<unsigned int p>
+	inline vtype center(int x0)
+	{
+		return vtype(rp[p].get(0) + x0,Vc::Unaligned);
+	}
+
+	/*! \brief Load the stencil point s of a group
+	 *
+	 * \param s stencil point
+	 * \param x0 first point of the group
+	 *
+	 */
+	template<unsigned int p>
+	inline vtype point(int s, int x0)
+	{
+		return vtype(rp[p].get(st_row.get(s)) + st_d0.get(s) + x0,Vc::Unaligned);
+	}
+
+	/*! \brief Store the result of a group
+	 *
+	 * \param res result
+	 * \param dst row of the destination in the chunk
+	 * \param x0 first point of the group
+	 * \param cmp mask of the points to store
+	 *
+	 */
+	inline void store(const vtype & res, prop_type * dst, int x0, const Vc::Mask<prop_type> & cmp)
+	{
+		if ((int)vtype::Size <= sz0)
+		{res.store(dst + x0,cmp,Vc::Unaligned);}
+		else
+		{
+			// the vector is bigger than a chunk row
+			for (int l = 0 ; l < (int)vtype::Size ; l++)
+			{
+				if (cmp[l] == true)	{dst[x0 + l] = res[l];}
+			}
+		}
+	}
+};
+
+/*! \brief Dimension generic implementation of the convolutions
+ *
+ * The chunks are processed one by one, the points of the chunk row by row in groups
+ * of Vc::Vector<prop_type>::Size along the dimension 0. The stencil can be arbitrary as long
+ * as it does not exceed the size of a chunk
+ *
+ */
+template<unsigned int dim>
+struct conv_impl_nd
+{
+	/*! \brief Iterate the rows of the chunks of a part intersected with the box start-stop
+	 *
+	 * For each row it call g(cid,cnn,lp,lo0,hi0) where lp is the first point of the row
+	 * in local chunk coordinates and lo0,hi0 is the range of the row to process
+	 *
+	 */
+	template<typename SparseGridType, typename lambda_g>
+	static void chunks_part(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid, size_t part, size_t n_part, lambda_g g)
+	{
+		auto & header_inf = grid.private_get_header_inf();
+
+		conv_chunk_nn<dim,SparseGridType> cnn;
+
+		size_t c_start;
+		size_t c_stop;
+		grid.getChunkRangePart(part,n_part,c_start,c_stop);
+
+		for (size_t cid = c_start ; cid < c_stop ; cid++)
+		{
+			auto & pos = header_inf.get(cid).pos;
+
+			// intersection of the chunk with start-stop
+			int lo[dim];
+			int hi[dim];
+			bool empty = false;
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				lo[i] = std::max((long int)start.get(i) - (long int)pos.get(i),0l);
+				hi[i] = std::min((long int)stop.get(i) - (long int)pos.get(i),(long int)cnn.sz[i]-1);
+
+				empty |= lo[i] > hi[i];
+			}
+
+			if (empty == true)	{continue;}
+
+			cnn.fill(grid,cid);
+
+			int lp[dim];
+			for (size_t i = 0 ; i < dim ; i++)
+			{lp[i] = lo[i];}
+			lp[0] = 0;
+
+			while (true)
+			{
+				g(cid,cnn,lp,lo[0],hi[0]);
+
+				size_t i = 1;
+				for ( ; i < dim ; i++)
+				{
+					lp[i]++;
+					if (lp[i] <= hi[i])	{break;}
+					lp[i] = lo[i];
+				}
+
+				if (i == dim)	{break;}
+			}
+		}
+	}
+
+	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
+	{
+		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+		typedef Vc::Vector<prop_type> vtype;
+
+		auto & datas = grid.private_get_data();
+
+		conv_chunk_nn<dim,SparseGridType> cnn_sz;
+		conv_nd_rows<dim,prop_type,1> rw(stencil,N,cnn_sz.sz[0]);
+
+		chunks_part(start,stop,grid,part,n_part,[&](size_t cid, const conv_chunk_nn<dim,SparseGridType> & cnn, int (& lp)[dim], int lo0, int hi0)
+		{
+			if (rw.load_masks(grid,cnn,lp,lo0,hi0) == false)	{return;}
+
+			rw.template load_prop<prop_src,0>(grid,cnn,lp);
+
+			long int cnk;
+			int sub0;
+			cnn.get(lp,cnk,sub0);
+			prop_type * dst = &datas.get(cid).template get<prop_dst>()[sub0];
+
+			for (int x0 = lo0 - lo0 % vtype::Size ; x0 <= hi0 ; x0 += vtype::Size)
+			{
+				Vc::Mask<prop_type> cmp;
+				if (rw.group_mask(cmp,x0) == false)	{continue;}
+
+				vtype xs[N+1];
+
+				xs[0] = rw.template center<0>(x0);
+				for (size_t s = 0 ; s < N ; s++)
+				{xs[s+1] = rw.template point<0>(s,x0);}
+
+				vtype res = func(xs, &rw.msum.template get<0>(x0), args ...);
+
+				rw.store(res,dst,x0,cmp);
+			}
+		});
+	}
+
+	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
+	{
+		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+		typedef Vc::Vector<prop_type> vtype;
+
+		auto & datas = grid.private_get_data();
+
+		// cross stencil xm[0],xp[0],xm[1],xp[1] ...
+		int stencil[2*dim][dim];
+		for (size_t s = 0 ; s < 2*dim ; s++)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{stencil[s][i] = (i == s/2)?((s % 2 == 0)?-1:1):0;}
+		}
+
+		conv_chunk_nn<dim,SparseGridType> cnn_sz;
+		conv_nd_rows<dim,prop_type,1> rw(stencil,2*dim,cnn_sz.sz[0]);
+
+		chunks_part(start,stop,grid,part,n_part,[&](size_t cid, const conv_chunk_nn<dim,SparseGridType> & cnn, int (& lp)[dim], int lo0, int hi0)
+		{
+			if (rw.load_masks(grid,cnn,lp,lo0,hi0) == false)	{return;}
+
+			rw.template load_prop<prop_src,0>(grid,cnn,lp);
+
+			long int cnk;
+			int sub0;
+			cnn.get(lp,cnk,sub0);
+			prop_type * dst = &datas.get(cid).template get<prop_dst>()[sub0];
+
+			for (int x0 = lo0 - lo0 % vtype::Size ; x0 <= hi0 ; x0 += vtype::Size)
+			{
+				Vc::Mask<prop_type> cmp;
+				if (rw.group_mask(cmp,x0) == false)	{continue;}
+
+				vtype cmd = rw.template center<0>(x0);
+				cross_stencil_nd_v<dim,prop_type> cs;
+
+				for (size_t i = 0 ; i < dim ; i++)
+				{
+					cs.xm[i] = rw.template point<0>(2*i,x0);
+					cs.xp[i] = rw.template point<0>(2*i+1,x0);
+				}
+
+				vtype res = func(cmd, cs, &rw.msum.template get<0>(x0), args ...);
+
+				rw.store(res,dst,x0,cmp);
+			}
+		});
+	}
+
+	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
+			 unsigned int prop_dst1, unsigned int prop_dst2,
+			 unsigned int stencil_size , unsigned int N,
+			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv2(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
+	{
+		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
+		typedef Vc::Vector<prop_type> vtype;
+
+		auto & datas = grid.private_get_data();
+
+		conv_chunk_nn<dim,SparseGridType> cnn_sz;
+		conv_nd_rows<dim,prop_type,2> rw(stencil,N,cnn_sz.sz[0]);
+
+		chunks_part(start,stop,grid,part,n_part,[&](size_t cid, const conv_chunk_nn<dim,SparseGridType> & cnn, int (& lp)[dim], int lo0, int hi0)
+		{
+			if (rw.load_masks(grid,cnn,lp,lo0,hi0) == false)	{return;}
+
+			rw.template load_prop<prop_src1,0>(grid,cnn,lp);
+			rw.template load_prop<prop_src2,1>(grid,cnn,lp);
+
+			long int cnk;
+			int sub0;
+			cnn.get(lp,cnk,sub0);
+			prop_type * dst1 = &datas.get(cid).template get<prop_dst1>()[sub0];
+			prop_type * dst2 = &datas.get(cid).template get<prop_dst2>()[sub0];
+
+			for (int x0 = lo0 - lo0 % vtype::Size ; x0 <= hi0 ; x0 += vtype::Size)
+			{
+				Vc::Mask<prop_type> cmp;
+				if (rw.group_mask(cmp,x0) == false)	{continue;}
+
+				vtype xs1[N+1];
+				vtype xs2[N+1];
+
+				xs1[0] = rw.template center<0>(x0);
+				xs2[0] = rw.template center<1>(x0);
+				for (size_t s = 0 ; s < N ; s++)
+				{
+					xs1[s+1] = rw.template point<0>(s,x0);
+					xs2[s+1] = rw.template point<1>(s,x0);
+				}
+
+				vtype vo1;
+				vtype vo2;
+
+				func(vo1, vo2, xs1, xs2, &rw.msum.template get<0>(x0), args ...);
+
+				rw.store(vo1,dst1,x0,cmp);
+				rw.store(vo2,dst2,x0,cmp);
+			}
+		});
+	}
+};
+
+#endif
+
 template<unsigned int dim>
 struct conv_impl
 {
-	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv operation not implemented for this dimension " << std::endl;
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU) || defined(__HIP__)
+		conv_impl_nd<dim>::template conv<findNN,NNtype,prop_src,prop_dst,stencil_size>(stencil,start,stop,grid,part,n_part,func,args ...);
 #else
 		std::cout << __FILE__ << ":" << __LINE__ << " error conv is unsupported when compiled on NVCC " << std::endl;
 #endif
 	}
 
 	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross operation not implemented for this dimension " << std::endl;
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU) || defined(__HIP__)
+		conv_impl_nd<dim>::template conv_cross<findNN,prop_src,prop_dst,stencil_size>(start,stop,grid,part,n_part,func,args ...);
 #else
 		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross is unsupported when compiled on NVCC " << std::endl;
 #endif
@@ -90,22 +799,32 @@ struct conv_impl
 			 unsigned int prop_dst1, unsigned int prop_dst2,
 			 unsigned int stencil_size , unsigned int N,
 			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv2(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv2 operation not implemented for this dimension " << std::endl;
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU) || defined(__HIP__)
+		conv_impl_nd<dim>::template conv2<findNN,NNType,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,grid,part,n_part,func,args ...);
 #else
 		std::cout << __FILE__ << ":" << __LINE__ << " error conv2 is unsupported when compiled on NVCC " << std::endl;
 #endif
 	}
 
 	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross2(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
 #ifndef __NVCC__
 		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 operation not implemented for this dimension " << std::endl;
 #else
 		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 is unsupported when compiled on NVCC " << std::endl;
+#endif
+	}
+
+	template<bool findNN, unsigned int stencil_size, typename prop_type, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross_ids(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
+	{
+#ifndef __NVCC__
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross_ids operation not implemented for this dimension " << std::endl;
+#else
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross_ids is unsupported when compiled on NVCC " << std::endl;
 #endif
 	}
 };
@@ -215,9 +934,9 @@ template<>
 struct conv_impl<3>
 {
 	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		auto it = grid.template getBlockIteratorPart<stencil_size>(start,stop,part,n_part);
 
 		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
 
@@ -347,9 +1066,9 @@ struct conv_impl<3>
 	}
 
 	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<1>(start,stop);
+		auto it = grid.template getBlockIteratorPart<1>(start,stop,part,n_part);
 
 		auto & datas = grid.private_get_data();
 		auto & headers = grid.private_get_header_mask();
@@ -515,14 +1234,15 @@ struct conv_impl<3>
 			 unsigned int prop_dst1, unsigned int prop_dst2,
 			 unsigned int stencil_size , unsigned int N,
 			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		auto it = grid.template getBlockIteratorPart<stencil_size>(start,stop,part,n_part);
 
 		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
 
 		unsigned char mask[decltype(it)::sizeBlockBord];
 		unsigned char mask_sum[decltype(it)::sizeBlockBord];
+		unsigned char mask_unused[decltype(it)::sizeBlock];
 		__attribute__ ((aligned (64))) prop_type block_bord_src1[decltype(it)::sizeBlockBord];
 		__attribute__ ((aligned (64))) prop_type block_bord_dst1[decltype(it)::sizeBlock+16];
 		__attribute__ ((aligned (64))) prop_type block_bord_src2[decltype(it)::sizeBlockBord];
@@ -537,6 +1257,13 @@ struct conv_impl<3>
 			it.template loadBlockBorder<prop_src1,NNType,findNN>(block_bord_src1,mask);
 			it.template loadBlockBorder<prop_src2,NNType,findNN>(block_bord_src2,mask);
 
+			if (it.start_b(2) != stencil_size || it.start_b(1) != stencil_size || it.start_b(0) != stencil_size ||
+			    it.stop_b(2) != sz2::value+stencil_size || it.stop_b(1) != sz1::value+stencil_size || it.stop_b(0) != sz0::value+stencil_size)
+			{
+				loadBlock_impl<prop_dst1,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst1,grid,it.getChunkId(),mask_unused);
+				loadBlock_impl<prop_dst2,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst2,grid,it.getChunkId(),mask_unused);
+			}
+
 			// Sum the mask
 			for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
 			{
@@ -554,24 +1281,24 @@ struct conv_impl<3>
 					{
 						size_t cmd = *(size_t *)&mask[cc];
 
-						if (cmd == 0) {continue;}
-
+						if (cmd != 0)
+						{
+							size_t xm[N];
 
-						size_t xm[N];
+							for (size_t s = 0 ; s < N ; s++)
+							{
+								xm[s] = *(size_t *)&mask[c[s]];
+							}
 
-						for (int s = 0 ; s < N ; s++)
-						{
-							xm[s] = *(size_t *)&mask[c[s]];
-						}
+							size_t sum = 0;
+							for (size_t s = 0 ; s < N ; s++)
+							{
+								sum += xm[s];
+							}
 
-						size_t sum = 0;
-						for (int s = 0 ; s < N ; s++)
-						{
-							sum += xm[s];
+							*(size_t *)&mask_sum[cc] = sum;
 						}
 
-						*(size_t *)&mask_sum[cc] = sum;
-
 						cc += sizeof(size_t);
 						for (int s = 0 ; s < N ; s++)
 						{
@@ -601,11 +1328,21 @@ struct conv_impl<3>
 
 						for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
 						{
-							cmp[s] = (mask[cc+s] == true);
+							cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
 						}
 
 						// we do only id exist the point
-						if (Vc::none_of(cmp) == true) {continue;}
+						if (Vc::none_of(cmp) == true)
+						{
+							cc += Vc::Vector<prop_type>::Size;
+							for (size_t s = 0 ; s < N ; s++)
+							{
+								c[s] += Vc::Vector<prop_type>::Size;
+							}
+							cd += Vc::Vector<prop_type>::Size;
+
+							continue;
+						}
 
 						Vc::Mask<prop_type> surround;
 
@@ -647,9 +1384,9 @@ struct conv_impl<3>
 	}
 
 	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		auto it = grid.template getBlockIteratorPart<stencil_size>(start,stop,part,n_part);
 
 		auto & datas = grid.private_get_data();
 		auto & headers = grid.private_get_header_mask();
@@ -825,9 +1562,9 @@ struct conv_impl<3>
 	}
 
 	template<bool findNN, unsigned int stencil_size, typename prop_type, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross_ids(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross_ids(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , size_t part, size_t n_part, lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		auto it = grid.template getBlockIteratorPart<stencil_size>(start,stop,part,n_part);
 
 		auto & datas = grid.private_get_data();
 		auto & headers = grid.private_get_header_mask();
@@ -436,6 +436,9 @@ class grid_key_sparse_dx_iterator
 	//! point to the actual chunk
 	size_t chunk_id;
 
+	//! stop chunk (excluded)
+	size_t chunk_stop;
+
 	//! Number of points in mask_it
 	int mask_nele;
 
@@ -454,7 +457,7 @@ class grid_key_sparse_dx_iterator
 		mask_nele = 0;
 		mask_it_pnt = 0;
 
-		while (mask_nele == 0 && chunk_id < header_inf->size())
+		while (mask_nele == 0 && isNext())
 		{
 			auto & mask = header_mask->get(chunk_id).mask;
 
@@ -478,7 +481,26 @@ public:
 	grid_key_sparse_dx_iterator(const openfpm::vector<mheader<n_ele>> * header_mask,
 							    const openfpm::vector<cheader<dim>> * header_inf,
 								const grid_key_dx<dim> (* lin_id_pos)[n_ele])
-	:header_mask(header_mask),header_inf(header_inf),lin_id_pos(lin_id_pos),chunk_id(1),mask_nele(0),mask_it_pnt(0)
+	:header_mask(header_mask),header_inf(header_inf),lin_id_pos(lin_id_pos),chunk_id(1),chunk_stop((size_t)-1),mask_nele(0),mask_it_pnt(0)
+	{
+		SelectValidAndFill_mask_it();
+	}
+
+	/*! \brief Iterator over the chunks in the range [chunk_start,chunk_stop)
+	 *
+	 * \param header_mask mask of each chunk
+	 * \param header_inf information of each chunk
+	 * \param lin_id_pos linearized id to position conversion
+	 * \param chunk_start first chunk
+	 * \param chunk_stop stop chunk (excluded)
+	 *
+	 */
+	grid_key_sparse_dx_iterator(const openfpm::vector<mheader<n_ele>> * header_mask,
+							    const openfpm::vector<cheader<dim>> * header_inf,
+								const grid_key_dx<dim> (* lin_id_pos)[n_ele],
+								size_t chunk_start,
+								size_t chunk_stop)
+	:header_mask(header_mask),header_inf(header_inf),lin_id_pos(lin_id_pos),chunk_id(chunk_start),chunk_stop(chunk_stop),mask_nele(0),mask_it_pnt(0)
 	{
 		SelectValidAndFill_mask_it();
 	}
@@ -495,7 +517,7 @@ public:
 		chunk_id++;
 		mask_it_pnt = 0;
 
-		if (chunk_id < header_inf->size())
+		if (isNext())
 		{
 			SelectValidAndFill_mask_it();
 		}
@@ -517,6 +539,7 @@ public:
 		header_inf = g_s_it.header_inf;
 		lin_id_pos = g_s_it.lin_id_pos;
 		chunk_id = g_s_it.chunk_id;
+		chunk_stop = g_s_it.chunk_stop;
 		mask_nele = g_s_it.mask_nele;
 		mask_it_pnt = g_s_it.mask_it_pnt;
 
@@ -537,6 +560,7 @@ public:
 		header_inf = g_s_it.private_get_header_inf();
 		lin_id_pos = g_s_it.private_get_lin_id_pos();
 		chunk_id = 0;
+		chunk_stop = (size_t)-1;
 
 		SelectValidAndFill_mask_it();
 	}
@@ -579,7 +603,7 @@ public:
 	 */
 	bool isNext()
 	{
-		return chunk_id < header_inf->size();
+		return chunk_id < header_inf->size() && chunk_id < chunk_stop;
 	}
 };
 
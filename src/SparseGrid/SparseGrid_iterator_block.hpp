@@ -482,6 +482,9 @@ class grid_key_sparse_dx_iterator_block_sub
 	//! point to the actual chunk
 	size_t chunk_id;
 
+	//! stop chunk (excluded)
+	size_t chunk_stop;
+
 	//! Starting point
 	grid_key_dx<dim> start_;
 
@@ -522,7 +525,7 @@ class grid_key_sparse_dx_iterator_block_sub
 		auto & header = spg.private_get_header_inf();
 		auto & header_mask = spg.private_get_header_mask();
 
-		while (chunk_id < header.size())
+		while (chunk_id < header.size() && chunk_id < chunk_stop)
 		{
 			auto & mask = header_mask.get(chunk_id).mask;
 
@@ -568,7 +571,24 @@ public:
 	grid_key_sparse_dx_iterator_block_sub(SparseGridType & spg,
 								const grid_key_dx<dim> & start,
 								const grid_key_dx<dim> & stop)
-	:spg(spg),chunk_id(1),
+	:grid_key_sparse_dx_iterator_block_sub(spg,start,stop,1,(size_t)-1)
+	{}
+
+	/*! \brief Iterator over the blocks of the chunks in the range [chunk_start,chunk_stop)
+	 *
+	 * \param spg sparse grid
+	 * \param start starting point
+	 * \param stop stop point
+	 * \param chunk_start first chunk
+	 * \param chunk_stop stop chunk (excluded)
+	 *
+	 */
+	grid_key_sparse_dx_iterator_block_sub(SparseGridType & spg,
+								const grid_key_dx<dim> & start,
+								const grid_key_dx<dim> & stop,
+								size_t chunk_start,
+								size_t chunk_stop)
+	:spg(spg),chunk_id(chunk_start),chunk_stop(chunk_stop),
 	 start_(start),stop_(stop)
 	{
 		// Create border coeficents
@@ -676,7 +696,7 @@ public:
 
 		chunk_id++;
 
-		if (chunk_id < header.size())
+		if (chunk_id < header.size() && chunk_id < chunk_stop)
 		{
 			SelectValid();
 		}
@@ -693,7 +713,7 @@ public:
 	{
 		auto & header = spg.private_get_header_inf();
 
-		return chunk_id < header.size();
+		return chunk_id < header.size() && chunk_id < chunk_stop;
 	}
 
 	/*! \brief Return the starting point for the iteration
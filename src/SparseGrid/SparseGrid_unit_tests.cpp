@@ -11,7 +11,9 @@
 #include <boost/test/unit_test.hpp>
 #include "SparseGrid/SparseGrid.hpp"
 #include "NN/CellList/CellDecomposer.hpp"
+#include "Packer_Unpacker/Pack_checkpoint.hpp"
 #include <math.h>
+#include <map>
 //#include "util/debug.hpp"
 
 BOOST_AUTO_TEST_SUITE( sparse_grid_test )
@@ -2203,6 +2205,145 @@ BOOST_AUTO_TEST_CASE( sparse_grid_sub_grid_it_packing)
 }
 
 
+/*! \brief Pack a box of a grid, check that the request match the packed bytes and unpack on another grid
+ *
+ * \param grid grid to pack
+ * \param bx box to pack
+ *
+ */
+template<typename sgrid> void Test_pack_sub_box_and_check(sgrid & grid, const Box<3,size_t> & bx)
+{
+	size_t sz[3];
+
+	for (size_t i = 0 ; i < 3 ; i++)
+	{sz[i] = grid.getGrid().size(i);}
+
+	sgrid grid2(sz);
+
+	grid_key_dx<3> start({(long int)bx.getLow(0),(long int)bx.getLow(1),(long int)bx.getLow(2)});
+	grid_key_dx<3> stop({(long int)bx.getHigh(0),(long int)bx.getHigh(1),(long int)bx.getHigh(2)});
+
+	auto sub_it = grid.getIterator(start,stop);
+	size_t req = 0;
+	grid.template packRequest<0,1>(sub_it,req);
+
+	HeapMemory pmem;
+	pmem.allocate(req);
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	grid.template pack<0,1>(mem,sub_it,sts);
+
+	BOOST_REQUIRE_EQUAL(mem.size(),req);
+
+	mem.reset();
+
+	int gpuContext;
+	Unpack_stat usts;
+	grid2.template unpack<0,1>(mem,sub_it,usts,gpuContext,rem_copy_opt::NONE_OPT);
+
+	// every point of the box is restored and nothing outside of it
+
+	bool match = true;
+	size_t cnt = 0;
+	size_t cnt2 = 0;
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		if (bx.isInside(key.toPoint()) == true)
+		{
+			match &= grid2.existPoint(key);
+			match &= grid.template get<0>(key) == grid2.template get<0>(key);
+			match &= grid.template get<1>(key) == grid2.template get<1>(key);
+			cnt++;
+		}
+
+		++it;
+	}
+
+	auto it2 = grid2.getIterator();
+
+	while (it2.isNext())
+	{
+		match &= bx.isInside(it2.get().toPoint());
+		cnt2++;
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,cnt2);
+	BOOST_REQUIRE(cnt != 0);
+
+	mem.decRef();
+	delete &mem;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_sub_box_packing )
+{
+	size_t sz[3] = {96,96,96};
+
+	sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid(sz);
+
+	// a dense grid with holes, every chunk is partially filled
+
+	grid_key_dx_iterator<3> it(grid.getGrid());
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		if ((key.get(0) + key.get(1) + key.get(2)) % 3 != 0)
+		{
+			grid.template insert<0>(key) = key.get(0)*10000 + key.get(1)*100 + key.get(2);
+			grid.template insert<1>(key) = key.get(0) - key.get(2);
+		}
+
+		++it;
+	}
+
+	// the boxes cover less chunk positions than the number of chunks, the chunk positions
+	// are enumerated. Most of the chunks are only partially inside the box
+
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({13,13,13},{22,25,19}));
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({0,0,0},{1,0,0}));
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({16,8,40},{31,23,47}));
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({80,3,60},{95,95,61}));
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_sub_box_packing_scan )
+{
+	size_t sz[3] = {200,200,200};
+
+	sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid(sz);
+
+	// few chunks, the boxes cover more chunk positions than the number of chunks
+	// and all the chunks are scanned
+
+	for (long int i = 10 ; i <= 40 ; i++)
+	{
+		for (long int j = 30 ; j <= 50 ; j++)
+		{
+			for (long int k = 100 ; k <= 120 ; k += 2)
+			{
+				grid_key_dx<3> key({i,j,k});
+
+				grid.template insert<0>(key) = i*10000 + j*100 + k;
+				grid.template insert<1>(key) = i - k;
+			}
+		}
+	}
+
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({5,5,5},{33,190,190}));
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({0,0,0},{199,199,199}));
+	Test_pack_sub_box_and_check(grid,Box<3,size_t>({20,0,103},{199,41,199}));
+}
+
 BOOST_AUTO_TEST_CASE( sparse_grid_remove_area)
 {
 	size_t sz[3] = {501,501,501};
@@ -2359,6 +2500,231 @@ BOOST_AUTO_TEST_CASE( sparse_pack_full_noprp )
 	Test_unpack_and_check_full_noprp(grid);
 }
 
+BOOST_AUTO_TEST_CASE( sparse_pack_compressed )
+{
+	size_t sz[3] = {128,128,128};
+
+	sgrid_cpu<3,aggregate<double,int,float[3]>,HeapMemory> grid(sz);
+
+	// a shell (full and partial chunks) and some isolated points
+	grid_key_dx_iterator<3> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r = sqrt((key.get(0) - 64.0)*(key.get(0) - 64.0) + (key.get(1) - 64.0)*(key.get(1) - 64.0) + (key.get(2) - 64.0)*(key.get(2) - 64.0));
+
+		if ((r > 40.0 && r < 46.0) || (key.get(0) % 31 == 0 && key.get(1) % 37 == 0 && key.get(2) % 41 == 0))
+		{
+			grid.template insert<0>(key) = r;
+			grid.template insert<1>(key) = key.get(0) / 8;
+			grid.template insert<2>(key)[0] = key.get(1);
+			grid.template insert<2>(key)[1] = 0.0;
+			grid.template insert<2>(key)[2] = key.get(2);
+		}
+
+		++key_it;
+	}
+
+	size_t req = 0;
+	grid.packRequestCompressed(req);
+
+	size_t req_raw = 0;
+	grid.packRequest(req_raw);
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	grid.packCompressed(mem,sts);
+
+	BOOST_REQUIRE(mem.size() <= req);
+	BOOST_REQUIRE(mem.size() < req_raw);
+
+	sgrid_cpu<3,aggregate<double,int,float[3]>,HeapMemory> grid2;
+
+	Unpack_stat ps;
+	BOOST_REQUIRE_EQUAL(grid2.unpackCompressed(mem,ps),true);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),mem.size());
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size());
+	BOOST_REQUIRE_EQUAL(grid2.getGrid().size(0),128ul);
+
+	bool match = true;
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		match &= grid2.existPoint(key);
+		match &= grid2.template get<0>(key) == grid.template get<0>(key);
+		match &= grid2.template get<1>(key) == grid.template get<1>(key);
+		match &= grid2.template get<2>(key)[0] == grid.template get<2>(key)[0];
+		match &= grid2.template get<2>(key)[2] == grid.template get<2>(key)[2];
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// only one property without compression
+	size_t req1 = 0;
+	grid.template packRequestCompressed<1>(req1);
+
+	HeapMemory pmem1;
+	ExtPreAlloc<HeapMemory> & mem1 = *(new ExtPreAlloc<HeapMemory>(req1,pmem1));
+	mem1.incRef();
+
+	Pack_stat sts1;
+	grid.template packCompressed<1>(mem1,sts1,PACK_COMPRESS_NONE);
+
+	sgrid_cpu<3,aggregate<double,int,float[3]>,HeapMemory> grid3;
+
+	Unpack_stat ps1;
+	BOOST_REQUIRE_EQUAL(grid3.template unpackCompressed<1>(mem1,ps1),true);
+
+	BOOST_REQUIRE_EQUAL(grid3.size(),grid.size());
+
+	auto it3 = grid.getIterator();
+
+	while (it3.isNext())
+	{
+		auto key = it3.get();
+
+		match &= grid3.template get<1>(key) == grid.template get<1>(key);
+
+		++it3;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// a buffer packed with other properties does not match, the grid is left empty
+	sgrid_cpu<3,aggregate<double,int,float[3]>,HeapMemory> grid4;
+
+	Unpack_stat ps2;
+	BOOST_REQUIRE_EQUAL(grid4.template unpackCompressed<0>(mem1,ps2),false);
+	BOOST_REQUIRE_EQUAL(grid4.size(),0ul);
+
+	// a corrupted number of chunks does not match the runs
+	size_t * n_cnk = (size_t *)pmem1.getPointer();
+	*n_cnk += 1;
+
+	Unpack_stat ps3;
+	BOOST_REQUIRE_EQUAL(grid4.template unpackCompressed<1>(mem1,ps3),false);
+	BOOST_REQUIRE_EQUAL(grid4.size(),0ul);
+
+	// corrupted chunk positions
+	*n_cnk -= 1;
+	size_t * run = (size_t *)((unsigned char *)pmem1.getPointer() + 5*sizeof(size_t) + 3*sizeof(size_t));
+	size_t run_old = *run;
+	*run = (size_t)-1;
+
+	Unpack_stat ps4;
+	BOOST_REQUIRE_EQUAL(grid4.template unpackCompressed<1>(mem1,ps4),false);
+	BOOST_REQUIRE_EQUAL(grid4.size(),0ul);
+
+	// the stored size of the uncompressed runs does not match the raw size
+	*run = run_old;
+	size_t * run_hdr = (size_t *)((unsigned char *)pmem1.getPointer() + 5*sizeof(size_t));
+	size_t run_stored = run_hdr[1];
+	run_hdr[1] += sizeof(size_t);
+
+	Unpack_stat ps5;
+	BOOST_REQUIRE_EQUAL(grid4.template unpackCompressed<1>(mem1,ps5),false);
+	BOOST_REQUIRE_EQUAL(grid4.size(),0ul);
+
+	// the stored size of the runs goes over the end of the buffer
+	run_hdr[1] = run_stored + mem1.size();
+
+	Unpack_stat ps6;
+	BOOST_REQUIRE_EQUAL(grid4.template unpackCompressed<1>(mem1,ps6),false);
+	BOOST_REQUIRE_EQUAL(grid4.size(),0ul);
+
+	mem.decRef();
+	delete &mem;
+	mem1.decRef();
+	delete &mem1;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_checkpoint )
+{
+	size_t sz[3] = {100,100,100};
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid(sz);
+
+	grid_key_dx_iterator<3> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		if ((key.get(0) + 2*key.get(1) + 3*key.get(2)) % 7 == 0 && key.get(2) < 60)
+		{
+			grid.template insert<0>(key) = key.get(0) + key.get(1);
+			grid.template insert<1>(key)[1] = key.get(2);
+		}
+
+		++key_it;
+	}
+
+	Checkpoint_writer cw;
+	cw.open("sparse_grid_checkpoint_test.ckp");
+	cw.write(grid);
+	BOOST_REQUIRE_EQUAL(cw.close(),true);
+
+	Checkpoint_reader cr;
+	cr.open("sparse_grid_checkpoint_test.ckp");
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid2;
+	BOOST_REQUIRE_EQUAL(cr.load(grid2),true);
+
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size());
+	BOOST_REQUIRE_EQUAL(grid2.getGrid().size(1),100ul);
+
+	bool match = true;
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		match &= grid2.existPoint(key);
+		match &= grid2.template get<0>(key) == grid.template get<0>(key);
+		match &= grid2.template get<1>(key)[1] == grid.template get<1>(key)[1];
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the restarted sparse grid can grow
+	grid_key_dx<3> k({99,99,99});
+	grid2.template insert<0>(k) = 5.0;
+
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size() + 1);
+	BOOST_REQUIRE_EQUAL(grid2.template get<0>(k),5.0);
+	BOOST_REQUIRE_EQUAL(grid2.template get<0>(grid_key_dx<3>({7,0,0})),7.0);
+
+	// segments of another aggregate do not match, the grid is not modified
+	Pack_segments segs;
+	grid.packSegments(segs);
+
+	sgrid_cpu<3,aggregate<double,float[3]>,HeapMemory> grid3;
+	size_t id = 0;
+	BOOST_REQUIRE_EQUAL(grid3.unpackSegments(segs,id),false);
+	BOOST_REQUIRE_EQUAL(grid3.size(),0ul);
+
+	id = 1;
+	BOOST_REQUIRE_EQUAL(grid2.unpackSegments(segs,id),false);
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size() + 1);
+	BOOST_REQUIRE_EQUAL(grid2.template get<0>(k),5.0);
+
+	remove("sparse_grid_checkpoint_test.ckp");
+}
+
 BOOST_AUTO_TEST_CASE( sparse_operator_equal )
 {
 	size_t sz[3] = {270,270,270};
@@ -2434,5 +2800,559 @@ BOOST_AUTO_TEST_CASE( sparse_testing_clear )
 	BOOST_REQUIRE_EQUAL(grid.template get<0>(keyzero),555.0);
 }
 
+BOOST_AUTO_TEST_CASE( sparse_grid_parallel_read )
+{
+	size_t sz[3] = {100,100,100};
+
+	sgrid_cpu<3,aggregate<double,double>,HeapMemory> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	// fill a spherical shell
+	grid_key_dx_iterator<3> key_it(grid.getGrid());
+	auto gs = grid.getGrid();
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r2 = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r2 += ((double)key.get(i) - 50.0)*((double)key.get(i) - 50.0);}
+
+		if (r2 > 20.0*20.0 && r2 < 35.0*35.0)
+		{grid.insert<0>(key) = gs.LinId(key);}
+
+		++key_it;
+	}
+
+	const size_t n_part = 4;
+
+	//! [parallel read of a sparse grid]
+
+	#pragma omp parallel for
+	for (size_t part = 0 ; part < n_part ; part++)
+	{
+		// every thread has its own chunk cache
+		sgrid_chunk_cache cc;
+
+		auto it = grid.getIteratorPart(part,n_part);
+
+		while (it.isNext())
+		{
+			auto p = it.get();
+
+			double sum = 0.0;
+			for (size_t i = 0 ; i < 3 ; i++)
+			{
+				sum += grid.template get<0>(p.move(i,1),cc);
+				sum += grid.template get<0>(p.move(i,-1),cc);
+			}
+
+			grid.template get<1>(it.getKeyF()) = sum - 6.0*grid.template get<0>(p,cc);
+
+			++it;
+		}
+	}
+
+	//! [parallel read of a sparse grid]
+
+	// check against the serial reading and that every point has been visited exactly once
+
+	size_t cnt = 0;
+	bool match = true;
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		double sum = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{
+			sum += grid.template get<0>(p.move(i,1));
+			sum += grid.template get<0>(p.move(i,-1));
+		}
+
+		match &= grid.template get<1>(p) == sum - 6.0*grid.template get<0>(p);
+		cnt++;
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,grid.size());
+
+	size_t cnt_part = 0;
+	size_t cnt_blk = 0;
+	size_t cnt_blk_part = 0;
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({98,98,98});
+
+	auto it_blk = grid.getBlockIterator<1>(start,stop);
+	while (it_blk.isNext())
+	{
+		cnt_blk++;
+		++it_blk;
+	}
+
+	for (size_t part = 0 ; part < n_part ; part++)
+	{
+		auto it = grid.getIteratorPart(part,n_part);
+
+		while (it.isNext())
+		{
+			cnt_part++;
+			++it;
+		}
+
+		auto it_blk = grid.getBlockIteratorPart<1>(start,stop,part,n_part);
+
+		while (it_blk.isNext())
+		{
+			cnt_blk_part++;
+			++it_blk;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(cnt_part,grid.size());
+	BOOST_REQUIRE_EQUAL(cnt_blk_part,cnt_blk);
+
+	// a cache filled before a change of the chunk structure must be invalidated
+
+	sgrid_chunk_cache cc;
+	grid_key_dx<3> k({50,50,20});
+	grid_key_dx<3> k2({50,50,50});
+
+	BOOST_REQUIRE_EQUAL(grid.existPoint(k2,cc),false);
+	BOOST_REQUIRE_EQUAL(grid.existPoint(k,cc),true);
+
+	grid.remove(k);
+
+	BOOST_REQUIRE_EQUAL(grid.existPoint(k,cc),false);
+}
+
+/*! \brief Fill a spherical shell of a sparse grid in any dimension
+ *
+ * \param grid sparse grid
+ * \param r1 inner radius
+ * \param r2 outer radius
+ *
+ */
+template<unsigned int dim, typename grid_type>
+void fill_shell_nd(grid_type & grid, double r1, double r2)
+{
+	grid_key_dx_iterator<dim> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			double x = (double)key.get(i) - grid.getGrid().size(i) / 2;
+			r += x*x;
+		}
+
+		if (r > r1*r1 && r < r2*r2)
+		{
+			grid.template insert<0>(key) = key.get(0) + 2*key.get(dim-1);
+			grid.template insert<2>(key) = key.get(0);
+		}
+
+		++key_it;
+	}
+}
+
+/*! \brief Check the result of a Laplacian convolution against the scalar get
+ *
+ * \param grid sparse grid
+ * \param start point
+ * \param stop point
+ * \param prop_src source property
+ * \param prop_dst destination property
+ *
+ */
+template<unsigned int dim, unsigned int prop_src, unsigned int prop_dst, typename grid_type>
+bool check_lap_nd(grid_type & grid, grid_key_dx<dim> & start, grid_key_dx<dim> & stop, size_t & cnt)
+{
+	bool check = true;
+	cnt = 0;
+
+	auto it = grid.getIterator(start,stop);
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		double lap = -2.0*dim*grid.template get<prop_src>(p);
+		bool surround = true;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			lap += grid.template get<prop_src>(p.move(i,1)) + grid.template get<prop_src>(p.move(i,-1));
+			surround &= grid.existPoint(p.move(i,1)) && grid.existPoint(p.move(i,-1));
+		}
+
+		lap = (surround)?lap:1.0;
+
+		check &= grid.template get<prop_dst>(p) == lap;
+		cnt++;
+
+		++it;
+	}
+
+	return check;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_insert_get_8d )
+{
+	size_t sz[8] = {130,9,9,3,3,3,3,3};
+
+	sgrid_cpu<8,aggregate<double,int>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = -1.0;
+
+	grid_sm<8,void> g_sm(sz);
+	std::map<size_t,int> ref;
+
+	srand(0);
+
+	for (int i = 0 ; i < 5000 ; i++)
+	{
+		grid_key_dx<8> key;
+
+		for (size_t d = 0 ; d < 8 ; d++)
+		{key.set_d(d,rand() % sz[d]);}
+
+		grid.template insert<0>(key) = i;
+		grid.template insert<1>(key) = -i;
+
+		ref[g_sm.LinId(key)] = i;
+	}
+
+	// the chunk origins must give back the inserted keys
+
+	bool match = true;
+	size_t cnt = 0;
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		auto r = ref.find(g_sm.LinId(key));
+
+		match &= r != ref.end() &&
+		         grid.template get<0>(key) == r->second &&
+		         grid.template get<1>(key) == -r->second;
+
+		cnt++;
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,ref.size());
+
+	for (auto & r : ref)
+	{
+		grid_key_dx<8> key = g_sm.InvLinId(r.first);
+
+		match &= grid.existPoint(key);
+		match &= grid.template get<0>(key) == r.second;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid_key_dx<8> out({129,8,8,2,2,2,2,2});
+
+	if (ref.find(g_sm.LinId(out)) == ref.end())
+	{BOOST_REQUIRE_EQUAL(grid.template get<0>(out),-1.0);}
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_fast_stencil_nd)
+{
+	// 2D
+
+	{
+	size_t sz[2] = {300,300};
+
+	sgrid_cpu<2,aggregate<double,double,double,double>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid.getBackgroundValue().template get<2>() = 0.0;
+
+	fill_shell_nd<2>(grid,60.0,140.0);
+
+	grid_key_dx<2> start({1,1});
+	grid_key_dx<2> stop({200,298});
+
+	int stencil[4][2] = {{1,0},{-1,0},{0,-1},{0,1}};
+
+	grid.conv<0,1,1>(stencil,start,stop,[](Vc::double_v (& xs)[5], unsigned char * mask_sum){
+																Vc::double_v Lap = xs[1] + xs[2] +
+																				   xs[3] + xs[4] - 4.0*xs[0];
+
+																auto surround = load_mask<Vc::double_v>(mask_sum);
+
+																return Vc::iif(surround == Vc::double_v(4.0),Lap,Vc::double_v(1.0));
+	                                                         });
+
+	size_t cnt;
+	BOOST_REQUIRE_EQUAL((check_lap_nd<2,0,1>(grid,start,stop,cnt)),true);
+	BOOST_REQUIRE(cnt != 0);
+
+	grid.conv_cross<0,3,1>(start,stop,[](Vc::double_v & cmd, cross_stencil_nd_v<2,double> & s, unsigned char * mask_sum){
+																Vc::double_v Lap = s.xm[0] + s.xp[0] +
+																				   s.xm[1] + s.xp[1] - 4.0*cmd;
+
+																auto surround = load_mask<Vc::double_v>(mask_sum);
+
+																return Vc::iif(surround == Vc::double_v(4.0),Lap,Vc::double_v(1.0));
+	                                                         });
+
+	BOOST_REQUIRE_EQUAL((check_lap_nd<2,0,3>(grid,start,stop,cnt)),true);
+
+	grid.conv2<0,2,1,3,1>(stencil,start,stop,[](Vc::double_v & vo1, Vc::double_v & vo2, Vc::double_v (& xs1)[5], Vc::double_v (& xs2)[5], unsigned char * mask_sum){
+																auto surround = load_mask<Vc::double_v>(mask_sum);
+
+																vo1 = Vc::iif(surround == Vc::double_v(4.0),xs1[1] + xs1[2] + xs1[3] + xs1[4] - 4.0*xs1[0],Vc::double_v(1.0));
+																vo2 = Vc::iif(surround == Vc::double_v(4.0),xs2[1] + xs2[2] + xs2[3] + xs2[4] - 4.0*xs2[0],Vc::double_v(1.0));
+	                                                         });
+
+	BOOST_REQUIRE_EQUAL((check_lap_nd<2,0,1>(grid,start,stop,cnt)),true);
+	BOOST_REQUIRE_EQUAL((check_lap_nd<2,2,3>(grid,start,stop,cnt)),true);
+	}
+
+	// 2D, float, stencil with size 2
+
+	{
+	size_t sz[2] = {300,300};
+
+	sgrid_cpu<2,aggregate<float,float,float>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	fill_shell_nd<2>(grid,60.0,140.0);
+
+	grid_key_dx<2> start({2,2});
+	grid_key_dx<2> stop({297,150});
+
+	int stencil[6][2] = {{2,0},{-2,0},{0,2},{0,-2},{1,1},{-1,-1}};
+
+	grid.conv<0,1,2>(stencil,start,stop,[](Vc::float_v (& xs)[7], unsigned char * mask_sum){
+																Vc::float_v res = xs[1] + xs[2] + xs[3] + xs[4] + xs[5] + xs[6] - 6.0f*xs[0];
+
+																auto surround = load_mask<Vc::float_v>(mask_sum);
+
+																return Vc::iif(surround == Vc::float_v(6.0f),res,Vc::float_v(1.0f));
+	                                                         });
+
+	bool check = true;
+	size_t cnt = 0;
+	auto it = grid.getIterator(start,stop);
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		float res = - 6.0f*grid.template get<0>(p);
+		bool surround = true;
+
+		for (size_t s = 0 ; s < 6 ; s++)
+		{
+			grid_key_dx<2> q = p;
+			q.set_d(0,p.get(0) + stencil[s][0]);
+			q.set_d(1,p.get(1) + stencil[s][1]);
+
+			res += grid.template get<0>(q);
+			surround &= grid.existPoint(q);
+		}
+
+		res = (surround)?res:1.0f;
+
+		check &= fabs(grid.template get<1>(p) - res) <= 1e-3f*fabs(res);
+		cnt++;
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(check,true);
+	BOOST_REQUIRE(cnt != 0);
+	}
+
+	// 3D conv2 (block iterator implementation)
+
+	{
+	size_t sz[3] = {100,100,100};
+
+	sgrid_cpu<3,aggregate<double,double,double,double>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid.getBackgroundValue().template get<2>() = 0.0;
+
+	fill_shell_nd<3>(grid,20.0,40.0);
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({98,60,98});
+
+	int stencil[6][3] = {{1,0,0},{-1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+	grid.conv2<0,2,1,3,1>(stencil,start,stop,[](Vc::double_v & vo1, Vc::double_v & vo2, Vc::double_v (& xs1)[7], Vc::double_v (& xs2)[7], unsigned char * mask_sum){
+																auto surround = load_mask<Vc::double_v>(mask_sum);
+
+																vo1 = Vc::iif(surround == Vc::double_v(6.0),xs1[1] + xs1[2] + xs1[3] + xs1[4] + xs1[5] + xs1[6] - 6.0*xs1[0],Vc::double_v(1.0));
+																vo2 = Vc::iif(surround == Vc::double_v(6.0),xs2[1] + xs2[2] + xs2[3] + xs2[4] + xs2[5] + xs2[6] - 6.0*xs2[0],Vc::double_v(1.0));
+	                                                         });
+
+	size_t cnt;
+	BOOST_REQUIRE_EQUAL((check_lap_nd<3,0,1>(grid,start,stop,cnt)),true);
+	BOOST_REQUIRE_EQUAL((check_lap_nd<3,2,3>(grid,start,stop,cnt)),true);
+	}
+
+	// 4D
+
+	{
+	size_t sz[4] = {36,36,36,36};
+
+	sgrid_cpu<4,aggregate<double,double,double,double>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	fill_shell_nd<4>(grid,8.0,14.0);
+
+	grid_key_dx<4> start({1,1,1,1});
+	grid_key_dx<4> stop({34,34,20,34});
+
+	int stencil[8][4] = {{1,0,0,0},{-1,0,0,0},{0,1,0,0},{0,-1,0,0},{0,0,1,0},{0,0,-1,0},{0,0,0,1},{0,0,0,-1}};
+
+	grid.conv<0,1,1>(stencil,start,stop,[](Vc::double_v (& xs)[9], unsigned char * mask_sum){
+																Vc::double_v Lap = - 8.0*xs[0];
+
+																for (int s = 1 ; s < 9 ; s++)
+																{Lap += xs[s];}
+
+																auto surround = load_mask<Vc::double_v>(mask_sum);
+
+																return Vc::iif(surround == Vc::double_v(8.0),Lap,Vc::double_v(1.0));
+	                                                         });
+
+	size_t cnt;
+	BOOST_REQUIRE_EQUAL((check_lap_nd<4,0,1>(grid,start,stop,cnt)),true);
+	BOOST_REQUIRE(cnt != 0);
+	}
+}
+
+/*! \brief Insert, get, remove and resize on a sparse grid with a given chunk index
+ *
+ * \tparam grid_type sparse grid
+ *
+ */
+template<typename grid_type>
+void sparse_grid_chunk_index_check()
+{
+	size_t sz[3] = {300,300,300};
+
+	grid_type grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = -1;
+
+	grid_sm<3,void> g_sm(sz);
+
+	// scattered points (one chunk each) and a dense cube
+	openfpm::vector<grid_key_dx<3>> keys;
+
+	srand(0);
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		grid_key_dx<3> k({rand() % 300,rand() % 300,rand() % 300});
+		keys.add(k);
+	}
+
+	grid_key_dx_iterator_sub<3> sub(g_sm,grid_key_dx<3>({100,100,100}),grid_key_dx<3>({131,131,131}));
+	while (sub.isNext())
+	{
+		keys.add(sub.get());
+		++sub;
+	}
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{grid.template insert<0>(keys.get(i)) = g_sm.LinId(keys.get(i));}
+
+	bool match = true;
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{
+		match &= grid.template get<0>(keys.get(i)) == g_sm.LinId(keys.get(i));
+		match &= grid.existPoint(keys.get(i));
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(grid.template get<0>(grid_key_dx<3>({299,0,299})),(grid.existPoint(grid_key_dx<3>({299,0,299})))?g_sm.LinId(grid_key_dx<3>({299,0,299})):-1);
+
+	// remove the scattered points, the empty chunks are eliminated and the index rebuilt
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		auto & k = keys.get(i);
+		if (k.get(0) < 100 || k.get(0) > 131 || k.get(1) < 100 || k.get(1) > 131 || k.get(2) < 100 || k.get(2) > 131)
+		{grid.remove(k);}
+	}
+
+	grid.flush_remove();
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		auto & k = keys.get(i);
+		bool in = !(k.get(0) < 100 || k.get(0) > 131 || k.get(1) < 100 || k.get(1) > 131 || k.get(2) < 100 || k.get(2) > 131);
+		match &= grid.template get<0>(k) == ((in)?g_sm.LinId(k):-1);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(grid.size(),(size_t)32*32*32);
+
+	// resize bigger the index is rebuilt on the new grid of chunks
+	size_t sz2[3] = {600,600,600};
+	grid.resize(sz2);
+
+	grid_key_dx_iterator_sub<3> sub2(g_sm,grid_key_dx<3>({100,100,100}),grid_key_dx<3>({131,131,131}));
+	while (sub2.isNext())
+	{
+		match &= grid.template get<0>(sub2.get()) == g_sm.LinId(sub2.get());
+		++sub2;
+	}
+
+	grid.template insert<0>(grid_key_dx<3>({550,550,550})) = 7;
+	match &= grid.template get<0>(grid_key_dx<3>({550,550,550})) == 7;
+	match &= grid.template get<0>(grid_key_dx<3>({551,550,550})) == -1;
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// copy
+	grid_type grid2;
+	grid2 = grid;
+	match &= grid2.template get<0>(grid_key_dx<3>({550,550,550})) == 7;
+	match &= grid2.template get<0>(grid_key_dx<3>({110,120,130})) == g_sm.LinId(grid_key_dx<3>({110,120,130}));
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_chunk_index )
+{
+	//! [Sparse grid chunk index]
+
+	// the chunk index is the last template parameter
+	typedef sgrid_cpu<3,aggregate<long int>,HeapMemory,grid_sm<3,void>,typename memory_traits_lin<aggregate<long int>>::type,
+					  memory_traits_lin,default_chunking<3>,sgrid_index_dense> sgrid_dense;
+
+	//! [Sparse grid chunk index]
+
+	typedef sgrid_cpu<3,aggregate<long int>,HeapMemory,grid_sm<3,void>,typename memory_traits_lin<aggregate<long int>>::type,
+					  memory_traits_lin,default_chunking<3>,sgrid_index_sorted> sgrid_sorted;
+
+	typedef sgrid_cpu<3,aggregate<long int>,HeapMemory,grid_zm<3,void>,typename memory_traits_lin<aggregate<long int>>::type,
+					  memory_traits_lin,default_chunking<3>,sgrid_index_sorted> sgrid_sorted_zm;
+
+	sparse_grid_chunk_index_check<sgrid_cpu<3,aggregate<long int>,HeapMemory>>();
+	sparse_grid_chunk_index_check<sgrid_dense>();
+	sparse_grid_chunk_index_check<sgrid_sorted>();
+	sparse_grid_chunk_index_check<sgrid_sorted_zm>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,714 @@
+/*
+ * SparseGrid_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_SPARSEGRID_PERFORMANCE_SPARSEGRID_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_SPARSEGRID_PERFORMANCE_SPARSEGRID_PERFORMANCE_TESTS_HPP_
+
+#include "SparseGrid/SparseGrid.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Apply a 7-point Laplacian on a part of the blocks of the sparse grid
+ *
+ * \param grid sparse grid
+ * \param start point
+ * \param stop point
+ * \param part part of the chunks to process
+ * \param n_part number of parts
+ *
+ */
+template<typename grid_type>
+void sg_performance_lap_part(grid_type & grid, grid_key_dx<3> & start, grid_key_dx<3> & stop, size_t part, size_t n_part)
+{
+	auto it = grid.template getBlockIteratorPart<1>(start,stop,part,n_part);
+
+	unsigned char mask[decltype(it)::sizeBlockBord];
+	__attribute__ ((aligned (32))) double block_bord_src[decltype(it)::sizeBlockBord];
+	__attribute__ ((aligned (32))) double block_bord_dst[decltype(it)::sizeBlock];
+
+	while (it.isNext())
+	{
+		it.template loadBlockBorder<0,NNStar_c<3>,false>(block_bord_src,mask);
+
+		for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+		{
+			for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
+			{
+				int c = it.LinB(it.start_b(0),j,k);
+
+				int yp = it.LinB(it.start_b(0),j+1,k);
+				int ym = it.LinB(it.start_b(0),j-1,k);
+
+				int zp = it.LinB(it.start_b(0),j,k+1);
+				int zm = it.LinB(it.start_b(0),j,k-1);
+
+				for (int i = it.start_b(0) ; i < it.stop_b(0) ; i++)
+				{
+					double Lap = block_bord_src[c+1] + block_bord_src[c-1] +
+						         block_bord_src[yp] + block_bord_src[ym] +
+						         block_bord_src[zp] + block_bord_src[zm] - 6.0*block_bord_src[c];
+
+					block_bord_dst[it.LinB_off(i,j,k)] = (mask[c])?Lap:0.0;
+
+					c++;
+					yp++;
+					ym++;
+					zp++;
+					zm++;
+				}
+			}
+		}
+
+		it.template storeBlock<1>(block_bord_dst);
+
+		++it;
+	}
+}
+
+/*! \brief Compare the vectorized conv with a scalar loop on a spherical shell in dimension dim
+ *
+ * Both run on a single thread
+ *
+ * \param sz size of the grid in each dimension
+ * \param r1 inner radius of the shell
+ * \param r2 outer radius of the shell
+ *
+ */
+template<unsigned int dim>
+void sg_performance_conv_vs_scalar(size_t sz_d, double r1, double r2)
+{
+	size_t sz[dim];
+	for (size_t i = 0 ; i < dim ; i++)	{sz[i] = sz_d;}
+
+	sgrid_cpu<dim,aggregate<double,double>,HeapMemory> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	grid_key_dx_iterator<dim> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r2_ = 0.0;
+		for (size_t i = 0 ; i < dim ; i++)
+		{r2_ += ((double)key.get(i) - sz_d/2)*((double)key.get(i) - sz_d/2);}
+
+		if (r2_ > r1*r1 && r2_ < r2*r2)
+		{grid.template insert<0>(key) = key.get(0) + key.get(dim-1);}
+
+		++key_it;
+	}
+
+	grid_key_dx<dim> start;
+	grid_key_dx<dim> stop;
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		start.set_d(i,1);
+		stop.set_d(i,sz_d-2);
+	}
+
+	int stencil[2*dim][dim];
+	for (int s = 0 ; s < 2*dim ; s++)
+	{
+		for (int i = 0 ; i < dim ; i++)
+		{stencil[s][i] = (i == s/2)?((s % 2 == 0)?-1:1):0;}
+	}
+
+#ifdef HAVE_OPENMP
+	int max_threads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+
+	openfpm::vector<double> times_v;
+	openfpm::vector<double> times_s;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		grid.template conv<0,1,1>(stencil,start,stop,[](Vc::double_v (& xs)[2*dim+1], unsigned char * mask_sum){
+			Vc::double_v res = -(double)(2*dim)*xs[0];
+			for (int s = 1 ; s < 2*dim+1 ; s++)	{res += xs[s];}
+			return res;
+		});
+
+		t.stop();
+		times_v.add(t.getwct());
+
+		// scalar loop
+
+		t.reset();
+		t.start();
+
+		sgrid_chunk_cache cc;
+		auto it = grid.getIterator(start,stop);
+
+		while (it.isNext())
+		{
+			auto p = it.get();
+			auto kf = it.getKeyF();
+
+			double res = -(double)(2*dim)*grid.getBlock(kf).template get<0>()[kf.getPos()];
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				res += grid.template get<0>(p.move(i,1),cc);
+				res += grid.template get<0>(p.move(i,-1),cc);
+			}
+
+			grid.getBlock(kf).template get<1>()[kf.getPos()] = res;
+
+			++it;
+		}
+
+		t.stop();
+		times_s.add(t.getwct());
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+
+	double mean_v;
+	double dev_v;
+	double mean_s;
+	double dev_s;
+	standard_deviation(times_v,mean_v,dev_v);
+	standard_deviation(times_s,mean_s,dev_s);
+
+	std::cout << "Sparse grid " << dim << "D conv " << grid.size() << " points, vectorized: " << mean_v << " s (dev " << dev_v << ")"
+			  << "  scalar: " << mean_s << " s (dev " << dev_s << ")  speedup: " << mean_s / mean_v << std::endl;
+}
+
+/*! \brief Time insert, random get and neighborhood iteration on scattered points with a chunk index backend
+ *
+ * \tparam chunk_index chunk index of the sparse grid
+ *
+ * \param name name of the backend
+ * \param keys points to insert
+ * \param qry random points to get
+ * \param check output checksum
+ *
+ */
+template<typename chunk_index>
+void sg_performance_chunk_index(const char * name, openfpm::vector<grid_key_dx<3>> & keys, openfpm::vector<grid_key_dx<3>> & qry, double & check)
+{
+	typedef aggregate<double> aggr;
+	typedef sgrid_cpu<3,aggr,HeapMemory,grid_zm<3,void>,typename memory_traits_lin<aggr>::type,memory_traits_lin,default_chunking<3>,chunk_index> grid_type;
+
+	size_t sz[3] = {1024,1024,1024};
+
+	openfpm::vector<double> times_i;
+	openfpm::vector<double> times_g;
+	openfpm::vector<double> times_n;
+
+	check = 0.0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		grid_type grid(sz);
+		grid.getBackgroundValue().template get<0>() = 0.0;
+
+		timer t;
+		t.start();
+
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{grid.template insert<0>(keys.get(i)) = 1.0 + (i & 0xF);}
+
+		t.stop();
+		times_i.add(t.getwct());
+
+		timer t2;
+		t2.start();
+
+		double sg = 0.0;
+		for (size_t i = 0 ; i < qry.size() ; i++)
+		{sg += grid.template get<0>(qry.get(i));}
+
+		t2.stop();
+		times_g.add(t2.getwct());
+
+		timer t3;
+		t3.start();
+
+		sgrid_chunk_cache cc;
+		double sn = 0.0;
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{
+			auto & k = keys.get(i);
+
+			for (size_t d = 0 ; d < 3 ; d++)
+			{
+				if (k.get(d) > 0)	{sn += grid.template get<0>(k.move(d,-1),cc);}
+				if (k.get(d) < 1023)	{sn += grid.template get<0>(k.move(d,1),cc);}
+			}
+		}
+
+		t3.stop();
+		times_n.add(t3.getwct());
+
+		check += sg + sn;
+	}
+
+	double mean_i, dev_i, mean_g, dev_g, mean_n, dev_n;
+	standard_deviation(times_i,mean_i,dev_i);
+	standard_deviation(times_g,mean_g,dev_g);
+	standard_deviation(times_n,mean_n,dev_n);
+
+	std::cout << "    " << name << "  insert: " << mean_i << " s (dev " << dev_i << ")  get: " << mean_g << " s (dev " << dev_g << ")"
+	          << "  neighborhood: " << mean_n << " s (dev " << dev_n << ")" << std::endl;
+}
+
+/*! \brief Pack the ghost boxes of a decomposition of the sparse grid
+ *
+ * The grid is divided in n_sub^3 sub-domains, for each sub-domain the 26 boxes of width g
+ * at the border of the sub-domain (faces, edges and corners) are packed. Only packRequest
+ * and pack are timed (not the construction of the sub-grid iterators)
+ *
+ * \param grid sparse grid
+ * \param n_sub number of sub-domains in each direction
+ * \param g width of the ghost
+ * \param n_box output number of packed boxes
+ * \param time output time spent in packRequest and pack
+ *
+ * \return number of packed bytes
+ *
+ */
+template<typename grid_type>
+size_t sg_performance_ghost_pack(grid_type & grid, size_t n_sub, size_t g, size_t & n_box, double & time)
+{
+	size_t bytes = 0;
+	n_box = 0;
+	time = 0.0;
+
+	size_t sz_sub = grid.getGrid().size(0) / n_sub;
+
+	size_t n_sub_[3] = {n_sub,n_sub,n_sub};
+	grid_sm<3,void> gsub(n_sub_);
+	grid_key_dx_iterator<3> sit(gsub);
+
+	while (sit.isNext())
+	{
+		auto s = sit.get();
+
+		for (size_t dir = 0 ; dir < 27 ; dir++)
+		{
+			if (dir == 13)
+			{continue;}
+
+			grid_key_dx<3> start;
+			grid_key_dx<3> stop;
+
+			size_t d_ = dir;
+			for (size_t i = 0 ; i < 3 ; i++)
+			{
+				long int lo = s.get(i) * sz_sub;
+				long int hi = lo + sz_sub - 1;
+
+				switch (d_ % 3)
+				{
+				case 0:
+					start.set_d(i,lo);
+					stop.set_d(i,lo + g - 1);
+					break;
+				case 1:
+					start.set_d(i,lo);
+					stop.set_d(i,hi);
+					break;
+				default:
+					start.set_d(i,hi - g + 1);
+					stop.set_d(i,hi);
+				}
+
+				d_ /= 3;
+			}
+
+			auto sub_it = grid.getIterator(start,stop);
+
+			timer t;
+			t.start();
+
+			size_t req = 0;
+			grid.template packRequest<0>(sub_it,req);
+
+			HeapMemory pmem;
+			pmem.allocate(req);
+			ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+			mem.incRef();
+
+			Pack_stat sts;
+			grid.template pack<0>(mem,sub_it,sts);
+
+			t.stop();
+			time += t.getwct();
+
+			bytes += mem.size();
+			n_box++;
+
+			mem.decRef();
+			delete &mem;
+		}
+
+		++sit;
+	}
+
+	return bytes;
+}
+
+BOOST_AUTO_TEST_SUITE( sparse_grid_performance )
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_conv_scaling)
+{
+	size_t sz[3] = {256,256,256};
+
+	sgrid_cpu<3,aggregate<double,double>,HeapMemory> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	// spherical shell, the kernel read also the background around the shell
+	grid_key_dx_iterator<3> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r2 = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r2 += ((double)key.get(i) - 128.0)*((double)key.get(i) - 128.0);}
+
+		if (r2 > 60.0*60.0 && r2 < 120.0*120.0)
+		{grid.template insert<0>(key) = key.get(0) + key.get(1) + key.get(2);}
+
+		++key_it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({254,254,254});
+
+	grid.private_get_nnlist().resize(NNStar_c<3>::nNN * grid.private_get_header_inf().size());
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	double t_one = 0.0;
+
+	// 1,2,4 ... threads, the last one is always max_threads
+	for (size_t nt = 1 ; nt <= max_threads ; nt = (nt < max_threads && 2*nt > max_threads)?max_threads:2*nt)
+	{
+		openfpm::vector<double> times;
+
+		for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+		{
+			timer t;
+			t.start();
+
+			#pragma omp parallel for num_threads(nt) schedule(dynamic)
+			for (size_t part = 0 ; part < 8*nt ; part++)
+			{sg_performance_lap_part(grid,start,stop,part,8*nt);}
+
+			t.stop();
+			times.add(t.getwct());
+		}
+
+		double mean;
+		double dev;
+		standard_deviation(times,mean,dev);
+
+		if (nt == 1)	{t_one = mean;}
+
+		std::cout << "Sparse grid 7-point conv " << grid.size() << " points, threads: " << nt << "  time: " << mean
+				  << " s (dev " << dev << ")  speedup: " << t_one / mean << "  efficiency: " << t_one / mean / nt << std::endl;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_conv_parallel)
+{
+	size_t sz[3] = {256,256,256};
+
+	sgrid_cpu<3,aggregate<double,double>,HeapMemory> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	grid_key_dx_iterator<3> key_it(grid.getGrid());
+
+	while (key_it.isNext())
+	{
+		auto key = key_it.get();
+
+		double r2 = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r2 += ((double)key.get(i) - 128.0)*((double)key.get(i) - 128.0);}
+
+		if (r2 > 60.0*60.0 && r2 < 120.0*120.0)
+		{grid.template insert<0>(key) = key.get(0) + key.get(1) + key.get(2);}
+
+		++key_it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({254,254,254});
+
+	int stencil[6][3] = {{1,0,0},{-1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	double t_one = 0.0;
+
+	for (size_t nt = 1 ; nt <= max_threads ; nt = (nt < max_threads && 2*nt > max_threads)?max_threads:2*nt)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		openfpm::vector<double> times;
+
+		for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+		{
+			timer t;
+			t.start();
+
+			grid.template conv<0,1,1>(stencil,start,stop,[](Vc::double_v (& xs)[7], unsigned char * mask_sum){
+				return xs[1] + xs[2] + xs[3] + xs[4] + xs[5] + xs[6] - 6.0*xs[0];
+			});
+
+			t.stop();
+			times.add(t.getwct());
+		}
+
+		double mean;
+		double dev;
+		standard_deviation(times,mean,dev);
+
+		if (nt == 1)	{t_one = mean;}
+
+		std::cout << "Sparse grid conv " << grid.size() << " points, threads: " << nt << "  time: " << mean
+				  << " s (dev " << dev << ")  speedup: " << t_one / mean << std::endl;
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_conv_vectorized)
+{
+	sg_performance_conv_vs_scalar<2>(2048,500.0,1000.0);
+	sg_performance_conv_vs_scalar<3>(256,60.0,120.0);
+	sg_performance_conv_vs_scalar<4>(64,16.0,30.0);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_chunk_index)
+{
+	// small clusters of points scattered in the grid, most of the neighborhoods cross chunks
+	openfpm::vector<grid_key_dx<3>> keys;
+	openfpm::vector<grid_key_dx<3>> qry;
+
+	srand(0);
+	for (size_t i = 0 ; i < 40000 ; i++)
+	{
+		grid_key_dx<3> c({rand() % 1022,rand() % 1022,rand() % 1022});
+
+		for (size_t j = 0 ; j < 8 ; j++)
+		{keys.add(grid_key_dx<3>({c.get(0) + (long int)(j & 1),c.get(1) + (long int)((j >> 1) & 1),c.get(2) + (long int)((j >> 2) & 1)}));}
+	}
+
+	for (size_t i = 0 ; i < 1000000 ; i++)
+	{
+		// half in the inserted points and half random
+		if (i & 1)
+		{qry.add(keys.get(((size_t)rand() * RAND_MAX + rand()) % keys.size()));}
+		else
+		{qry.add(grid_key_dx<3>({rand() % 1024,rand() % 1024,rand() % 1024}));}
+	}
+
+	double check_h, check_d, check_s;
+
+	std::cout << "Sparse grid chunk index " << keys.size() << " points in clusters of 8, " << qry.size() << " random get" << std::endl;
+
+	sg_performance_chunk_index<sgrid_index_hopscotch>("hopscotch map",keys,qry,check_h);
+	sg_performance_chunk_index<sgrid_index_dense>("dense table  ",keys,qry,check_d);
+	sg_performance_chunk_index<sgrid_index_sorted>("sorted array ",keys,qry,check_s);
+
+	BOOST_REQUIRE_EQUAL(check_h,check_d);
+	BOOST_REQUIRE_EQUAL(check_h,check_s);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_ghost_pack)
+{
+	long int sz_d = 1024;
+	size_t sz[3] = {(size_t)sz_d,(size_t)sz_d,(size_t)sz_d};
+
+	sgrid_cpu<3,aggregate<double>,HeapMemory> grid(sz);
+
+	// level-set like thin spherical shell
+	double c = sz_d / 2;
+	double r1 = 0.47*sz_d;
+	double r2 = r1 + 2.0;
+
+	for (long int i = 0 ; i < sz_d ; i++)
+	{
+		for (long int j = 0 ; j < sz_d ; j++)
+		{
+			double d2 = (i - c)*(i - c) + (j - c)*(j - c);
+
+			if (d2 >= r2*r2)
+			{continue;}
+
+			double k_out = sqrt(r2*r2 - d2);
+			double k_in = (d2 < r1*r1)?sqrt(r1*r1 - d2):0.0;
+
+			for (long int k = (long int)ceil(c - k_out) ; k <= (long int)floor(c + k_out) ; k++)
+			{
+				if (fabs(k - c) >= k_in)
+				{grid.template insert<0>(grid_key_dx<3>({i,j,k})) = k - c;}
+			}
+		}
+	}
+
+	size_t n_sub = 8;
+	size_t g = 2;
+
+	openfpm::vector<double> times;
+	size_t bytes = 0;
+	size_t n_box = 0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		double time;
+		bytes = sg_performance_ghost_pack(grid,n_sub,g,n_box,time);
+
+		times.add(time);
+	}
+
+	double mean, dev;
+	standard_deviation(times,mean,dev);
+
+	std::cout << "Sparse grid ghost pack " << grid.size() << " points, " << grid.private_get_header_inf().size() - 1 << " chunks, " << n_box << " ghost boxes of width " << g
+	          << "  time: " << mean << " s (dev " << dev << ")  " << n_box / mean << " boxes/s  " << bytes / mean / 1e6 << " MB/s" << std::endl;
+
+	BOOST_REQUIRE(bytes != 0);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_grid_performance_pack_compressed)
+{
+	long int sz_d = 512;
+	size_t sz[3] = {(size_t)sz_d,(size_t)sz_d,(size_t)sz_d};
+
+	sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid(sz);
+
+	// level-set like narrow band, signed distance and a flag
+	double c = sz_d / 2;
+	double r0 = 0.4*sz_d;
+	double r1 = r0 - 3.0;
+	double r2 = r0 + 3.0;
+
+	for (long int i = 0 ; i < sz_d ; i++)
+	{
+		for (long int j = 0 ; j < sz_d ; j++)
+		{
+			double d2 = (i - c)*(i - c) + (j - c)*(j - c);
+
+			if (d2 >= r2*r2)
+			{continue;}
+
+			double k_out = sqrt(r2*r2 - d2);
+			double k_in = (d2 < r1*r1)?sqrt(r1*r1 - d2):0.0;
+
+			for (long int k = (long int)ceil(c - k_out) ; k <= (long int)floor(c + k_out) ; k++)
+			{
+				if (fabs(k - c) >= k_in)
+				{
+					grid_key_dx<3> key({i,j,k});
+					double phi = sqrt(d2 + (k - c)*(k - c)) - r0;
+
+					grid.template insert<0>(key) = phi;
+					grid.template insert<1>(key) = (phi < 0.0)?-1:1;
+				}
+			}
+		}
+	}
+
+	// plain pack
+	size_t req_raw = 0;
+	grid.packRequest(req_raw);
+
+	HeapMemory pmem_raw;
+	ExtPreAlloc<HeapMemory> & mem_raw = *(new ExtPreAlloc<HeapMemory>(req_raw,pmem_raw));
+	mem_raw.incRef();
+
+	Pack_stat sts_raw;
+	grid.pack(mem_raw,sts_raw);
+
+	size_t req = 0;
+	grid.packRequestCompressed(req);
+
+	openfpm::vector<double> times_p;
+	openfpm::vector<double> times_u;
+	size_t bytes = 0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		HeapMemory pmem;
+		ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+		mem.incRef();
+
+		timer t;
+		t.start();
+
+		Pack_stat sts;
+		grid.packCompressed(mem,sts);
+
+		t.stop();
+		times_p.add(t.getwct());
+
+		bytes = mem.size();
+
+		sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid2;
+
+		timer t2;
+		t2.start();
+
+		Unpack_stat ps;
+		bool ok = grid2.unpackCompressed(mem,ps);
+
+		t2.stop();
+		times_u.add(t2.getwct());
+
+		BOOST_REQUIRE_EQUAL(ok,true);
+		BOOST_REQUIRE_EQUAL(grid2.size(),grid.size());
+
+		mem.decRef();
+		delete &mem;
+	}
+
+	double mean_p, dev_p, mean_u, dev_u;
+	standard_deviation(times_p,mean_p,dev_p);
+	standard_deviation(times_u,mean_u,dev_u);
+
+	double raw = grid.size()*(sizeof(double) + sizeof(int));
+
+	std::cout << "Sparse grid compressed pack " << grid.size() << " points  pack: " << mem_raw.size() << " byte  compressed: " << bytes
+	          << " byte (ratio " << (double)mem_raw.size() / bytes << ")  compress: " << raw / mean_p / 1e6 << " MB/s (dev " << dev_p
+	          << " s)  decompress: " << raw / mean_u / 1e6 << " MB/s (dev " << dev_u << " s)" << std::endl;
+
+	BOOST_REQUIRE(bytes < mem_raw.size());
+
+	mem_raw.decRef();
+	delete &mem_raw;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_SPARSEGRID_PERFORMANCE_SPARSEGRID_PERFORMANCE_TESTS_HPP_ */
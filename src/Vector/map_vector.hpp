@@ -33,6 +33,7 @@
 #include <fstream>
 #include "Packer_Unpacker/Packer_util.hpp"
 #include "Packer_Unpacker/has_pack_agg.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
 #include "timer.hpp"
 #include "map_vector_std_util.hpp"
 #include "data_type/aggregate.hpp"
@@ -40,6 +41,8 @@
 #include "util/cuda_util.hpp"
 #include "cuda/map_vector_cuda_ker.cuh"
 #include "map_vector_printers.hpp"
+#include "map_vector_move_util.hpp"
+#include "map_vector_par_util.hpp"
 
 namespace openfpm
 {
@@ -616,6 +619,65 @@ namespace openfpm
 				add(v.get(i));
 		}
 
+	private:
+
+		/*! \brief Merge the elements of v into this vector at the positions returned by key_f
+		 *
+		 * \see merge_prp
+		 *
+		 * \param v source vector
+		 * \param key_f function that given the element of v return the element of this vector
+		 * \param opt MERGE_PRP_SERIAL, MERGE_PRP_UNIQUE or MERGE_PRP_SORT_REDUCE
+		 *
+		 */
+		template <template<typename,typename> class op, unsigned int ...args, typename vector_src, typename key_func>
+		void merge_prp_opart(const vector_src & v, key_func key_f, size_t opt)
+		{
+#ifdef SE_CLASS1
+
+			for (size_t i = 0 ; i < v.size() ; i++)
+			{
+				if (key_f(i) >= size())
+					std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << key_f(i) << " but the vector has size " << size() << std::endl;
+			}
+
+#endif
+
+			if (opt & MERGE_PRP_SORT_REDUCE)
+			{
+				// each destination is reduced by one thread, in the order of the source elements
+				openfpm::vector<size_t> offs;
+				openfpm::vector<size_t> ids;
+
+				vector_sort_by_destination(v.size(),size(),key_f,offs,ids);
+
+				vector_par_for(size(),[&](size_t start, size_t stop)
+				{
+					for (size_t d = start ; d < stop ; d++)
+					{
+						for (size_t k = offs.get(d) ; k < offs.get(d+1) ; k++)
+						{object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(ids.get(k)),get(d));}
+					}
+				});
+			}
+			else if (opt & MERGE_PRP_UNIQUE)
+			{
+				vector_par_for(v.size(),[&](size_t start, size_t stop)
+				{
+					for (size_t i = start ; i < stop ; i++)
+					{object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(key_f(i)));}
+				});
+			}
+			else
+			{
+				//! Add the element of v
+				for (size_t i = 0 ; i < v.size() ; i++)
+				{object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(key_f(i)));}
+			}
+		}
+
+	public:
+
 		/*! \brief It merge the elements of a source vector to this vector
 		 *
 		 * Given 2 vector v1 and v2 of size 7,3. and as merging operation the function add.
@@ -648,12 +710,16 @@ namespace openfpm
 		 * \tparam args one or more number that define which property to set-up
 		 *
 		 * \param v source vector
-		 * \param start index from where to start the merging
+		 * \param opart for each element of v the element of this vector where to merge
+		 * \param opt MERGE_PRP_SERIAL (default), MERGE_PRP_UNIQUE when the indexes in opart are unique
+		 *            (merged in parallel) or MERGE_PRP_SORT_REDUCE when they can be repeated (the source is
+		 *            sorted by destination and each destination is reduced in parallel)
 		 *
 		 */
 		template <template<typename,typename> class op, typename S, typename M, typename gp, unsigned int ...args>
 		void merge_prp(const vector<S,M,layout_base,gp,OPENFPM_NATIVE> & v,
-				 	   const openfpm::vector<size_t> & opart)
+				 	   const openfpm::vector<size_t> & opart,
+				 	   size_t opt = MERGE_PRP_SERIAL)
 		{
 #ifdef SE_CLASS1
 
@@ -661,18 +727,8 @@ namespace openfpm
 				std::cerr << __FILE__ << ":" << __LINE__ << " error merge_prp: v.size()=" << v.size() << " must be the same as o_part.size()" << opart.size() << std::endl;
 
 #endif
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
-#ifdef SE_CLASS1
 
-				if (opart.get(i) > size())
-					std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << opart.get(i) << " but the vector has size " << size() << std::endl;
-
-#endif
-				// write the object in the last element
-				object_s_di_op<op,decltype(v.get(i)),decltype(get(size()-1)),OBJ_ENCAP,args...>(v.get(i),get(opart.get(i)));
-			}
+			merge_prp_opart<op,args...>(v,[&](size_t i){return (size_t)opart.get(i);},opt);
 		}
 
 		/*! \brief It merge the elements of a source vector to this vector (on device)
@@ -751,7 +807,10 @@ namespace openfpm
 		 * \tparam args one or more number that define which property to set-up
 		 *
 		 * \param v source vector
-		 * \param start index from where to start the merging
+		 * \param opart for each element of v the element of this vector where to merge
+		 * \param opt MERGE_PRP_SERIAL (default), MERGE_PRP_UNIQUE when the indexes in opart are unique
+		 *            (merged in parallel) or MERGE_PRP_SORT_REDUCE when they can be repeated (the source is
+		 *            sorted by destination and each destination is reduced in parallel)
 		 *
 		 */
 		template <template<typename,typename> class op,
@@ -762,7 +821,8 @@ namespace openfpm
 				  typename vector_opart_type,
 				  unsigned int ...args>
 		void merge_prp_v(const vector<S,M,layout_base2,gp,OPENFPM_NATIVE> & v,
-						 const vector_opart_type & opart)
+						 const vector_opart_type & opart,
+						 size_t opt = MERGE_PRP_SERIAL)
 		{
 #ifdef SE_CLASS1
 
@@ -770,18 +830,8 @@ namespace openfpm
 				std::cerr << __FILE__ << ":" << __LINE__ << " error merge_prp: v.size()=" << v.size() << " must be the same as o_part.size()" << opart.size() << std::endl;
 
 #endif
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
-#ifdef SE_CLASS1
 
-				if (i >= opart.size())
-					std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << opart.template get<0>(i) << " but the vector has size " << size() << std::endl;
-
-#endif
-				// write the object in the last element
-				object_s_di_op<op,decltype(v.get(i)),decltype(get(size()-1)),OBJ_ENCAP,args...>(v.get(i),get(opart.template get<0>(i)));
-			}
+			merge_prp_opart<op,args...>(v,[&](size_t i){return (size_t)opart.template get<0>(i);},opt);
 		}
 
 		/*! \brief It merge the elements of a source vector to this vector
@@ -1037,18 +1087,19 @@ namespace openfpm
 		void merge_prp_v(const vector<S,M,layout_base2,gp,OPENFPM_NATIVE> & v,
 				         size_t start)
 		{
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
 #ifdef SE_CLASS1
 
-				if (start + i >= v_size)
-					std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << start+i << " but the vector has size " << size() << std::endl;
+			if (start + v.size() > v_size)
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << start+v.size()-1 << " but the vector has size " << size() << std::endl;
 
 #endif
-				// write the object in the last element
-				object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(start+i));
-			}
+
+			// the destinations are all different, the ranges are merged in parallel
+			vector_par_for(v.size(),[&](size_t r_start, size_t r_stop)
+			{
+				for (size_t i = r_start ; i < r_stop ; i++)
+				{object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(start+i));}
+			});
 		}
 
 		/*! \brief It add the element of a source vector to this vector
@@ -1073,15 +1124,17 @@ namespace openfpm
 				  unsigned int ...args>
 		void add_prp(const vector<S,M,layout_base2,gp,impl> & v)
 		{
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
-				// Add a new element
-				add();
+			size_t old_sz = size();
 
-				// write the object in the last element
-				object_s_di<decltype(v.get(i)),decltype(get(size()-1)),OBJ_ENCAP,args...>(v.get(i),get(size()-1));
-			}
+			// Add the new elements
+			resize_no_device(size() + v.size());
+
+			// write the objects in the new elements
+			vector_par_for(v.size(),[&](size_t start, size_t stop)
+			{
+				for (size_t i = start ; i < stop ; i++)
+				{object_s_di<decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(old_sz+i));}
+			});
 		}
 
 		/*! \brief It add the element of a source vector to this vector
@@ -1132,64 +1185,54 @@ namespace openfpm
 		}
 
 
-		/*! \brief Remove one entry from the vector
+		/*! \brief Move the elements [src,src+n) to [dst,dst+n)
 		 *
-		 * \param key element to remove
+		 * For trivially copyable properties the elements are moved in block (per property in case of
+		 * interleaved layout), otherwise they are copied one by one
+		 *
+		 * \warning dst must be smaller than src or the two ranges must not overlap
+		 *
+		 * \param dst destination element
+		 * \param src source element
+		 * \param n number of elements
 		 *
 		 */
-		void remove(size_t key)
+		void move_block(size_t dst, size_t src, size_t n)
 		{
-			size_t d_k = key;
-			size_t s_k = key + 1;
-
-			// keys
-			while (s_k < size())
-			{
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
-			}
-
-			// re-calculate the vector size
+			if (n == 0 || dst == src)	{return;}
 
-			v_size--;
+			vector_move_block<T,layout_base<T>>::move(*this,dst,src,n);
 		}
 
-		/*! \brief Remove several entries from the vector
-		 *
-		 * \warning the keys in the vector MUST be sorted
+	private:
+
+		/*! \brief Remove several entries from the vector compacting the runs of elements between the keys
 		 *
-		 * \param keys objects id to remove
+		 * \param keys objects id to remove (sorted)
 		 * \param start key starting point
+		 * \param key_f function that return the key i
 		 *
 		 */
-		void remove(openfpm::vector<size_t> & keys, size_t start = 0)
+		template<typename key_vector, typename key_func>
+		void remove_sorted(key_vector & keys, size_t start, key_func key_f)
 		{
 			// Nothing to remove return
 			if (keys.size() <= start )
 				return;
 
-			size_t a_key = start;
-			size_t d_k = keys.get(a_key);
-			size_t s_k = keys.get(a_key) + 1;
+			size_t d_k = key_f(keys,start);
 
-			// keys
-			while (s_k < size())
+			for (size_t a_key = start ; a_key < keys.size() ; a_key++)
 			{
-				// s_k should always point to a key that is not going to be deleted
-				while (a_key+1 < keys.size() && s_k == keys.get(a_key+1))
-				{
-					a_key++;
-					s_k = keys.get(a_key) + 1;
-				}
+				// the run of elements to keep after the key
+				size_t s_k = key_f(keys,a_key) + 1;
+				size_t e_k = (a_key+1 < keys.size())?(size_t)key_f(keys,a_key+1):size();
+				e_k = std::min(e_k,size());
 
-				// In case of overflow
-				if (s_k >= size())
-					break;
+				if (s_k >= e_k)	{continue;}
 
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
+				move_block(d_k,s_k,e_k - s_k);
+				d_k += e_k - s_k;
 			}
 
 			// re-calculate the vector size
@@ -1197,7 +1240,49 @@ namespace openfpm
 			v_size -= keys.size() - start;
 		}
 
+		/*! \brief Remove several entries from the vector moving the last elements in the holes
+		 *
+		 * \param keys objects id to remove (sorted)
+		 * \param start key starting point
+		 * \param key_f function that return the key i
+		 *
+		 */
+		template<typename key_vector, typename key_func>
+		void remove_unordered_sorted(key_vector & keys, size_t start, key_func key_f)
+		{
+			// we go backward, the last element is never an element to remove
+			for (long int a_key = (long int)keys.size() - 1 ; a_key >= (long int)start ; a_key--)
+			{
+				size_t key = key_f(keys,a_key);
+
+				if (key >= size())	{continue;}
+
+				if (key != size() - 1)
+				{move_block(key,size() - 1,1);}
+
+				v_size--;
+			}
+		}
+
+	public:
+
+		/*! \brief Remove one entry from the vector
+		 *
+		 * \param key element to remove
+		 *
+		 */
+		void remove(size_t key)
+		{
+			move_block(key,key+1,size() - key - 1);
+
+			// re-calculate the vector size
+
+			v_size--;
+		}
+
 		/*! \brief Remove several entries from the vector
+		 *
+		 * The elements between two removed keys are moved in block
 		 *
 		 * \warning the keys in the vector MUST be sorted
 		 *
@@ -1205,38 +1290,69 @@ namespace openfpm
 		 * \param start key starting point
 		 *
 		 */
-		void remove(openfpm::vector<aggregate<int>> & keys, size_t start = 0)
+		void remove(openfpm::vector<size_t> & keys, size_t start = 0)
 		{
-			// Nothing to remove return
-			if (keys.size() <= start )
-				return;
-
-			size_t a_key = start;
-			size_t d_k = keys.template get<0>(a_key);
-			size_t s_k = keys.template get<0>(a_key) + 1;
+			remove_sorted(keys,start,[](openfpm::vector<size_t> & keys, size_t i){return keys.get(i);});
+		}
 
-			// keys
-			while (s_k < size())
-			{
-				// s_k should always point to a key that is not going to be deleted
-				while (a_key+1 < keys.size() && s_k == keys.template get<0>(a_key+1))
-				{
-					a_key++;
-					s_k = keys.template get<0>(a_key) + 1;
-				}
+		/*! \brief Remove several entries from the vector
+		 *
+		 * The elements between two removed keys are moved in block
+		 *
+		 * \warning the keys in the vector MUST be sorted
+		 *
+		 * \param keys objects id to remove
+		 * \param start key starting point
+		 *
+		 */
+		void remove(openfpm::vector<aggregate<int>> & keys, size_t start = 0)
+		{
+			remove_sorted(keys,start,[](openfpm::vector<aggregate<int>> & keys, size_t i){return (size_t)keys.template get<0>(i);});
+		}
 
-				// In case of overflow
-				if (s_k >= size())
-					break;
+		/*! \brief Remove one entry from the vector replacing it with the last element
+		 *
+		 * The order of the elements is not preserved
+		 *
+		 * \param key element to remove
+		 *
+		 */
+		void remove_unordered(size_t key)
+		{
+			if (key != size() - 1)
+			{move_block(key,size() - 1,1);}
 
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
-			}
+			v_size--;
+		}
 
-			// re-calculate the vector size
+		/*! \brief Remove several entries from the vector filling the holes with the last elements
+		 *
+		 * The order of the elements is not preserved, but only the removed elements are touched
+		 *
+		 * \warning the keys in the vector MUST be sorted
+		 *
+		 * \param keys objects id to remove
+		 * \param start key starting point
+		 *
+		 */
+		void remove_unordered(openfpm::vector<size_t> & keys, size_t start = 0)
+		{
+			remove_unordered_sorted(keys,start,[](openfpm::vector<size_t> & keys, size_t i){return keys.get(i);});
+		}
 
-			v_size -= keys.size() - start;
+		/*! \brief Remove several entries from the vector filling the holes with the last elements
+		 *
+		 * The order of the elements is not preserved, but only the removed elements are touched
+		 *
+		 * \warning the keys in the vector MUST be sorted
+		 *
+		 * \param keys objects id to remove
+		 * \param start key starting point
+		 *
+		 */
+		void remove_unordered(openfpm::vector<aggregate<int>> & keys, size_t start = 0)
+		{
+			remove_unordered_sorted(keys,start,[](openfpm::vector<aggregate<int>> & keys, size_t i){return (size_t)keys.template get<0>(i);});
 		}
 
 		/*! \brief Get an element of the vector
@@ -2159,7 +2275,7 @@ namespace openfpm
 		 */
 		template<unsigned int p = 0> const void * getPointer() const
 		{
-			return base.getPointer();
+			return base.template getPointer<p>();
 		}
 
 		/*! \brief This class has pointer inside
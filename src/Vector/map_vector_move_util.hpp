@@ -0,0 +1,165 @@
+/*
+ * map_vector_move_util.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MAP_VECTOR_MOVE_UTIL_HPP_
+#define MAP_VECTOR_MOVE_UTIL_HPP_
+
+#include <string.h>
+#include <type_traits>
+#include "util/check_no_pointers.hpp"
+
+/*! \brief Check if all the properties of an aggregate can be moved with a memmove
+ *
+ * A property can be moved if it is trivially copyable or it declare to not have pointers
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct prp_memmove_check
+{
+	//! true if all the properties checked so far can be moved
+	bool ok = true;
+
+	//! It check the property Tp
+	template<typename Tp>
+	inline void operator()(Tp & t)
+	{
+		typedef typename std::remove_all_extents<typename boost::mpl::at<typename T::type,Tp>::type>::type base;
+
+		ok &= std::is_trivially_copyable<base>::value || check_no_pointers<base>::value() == PNP::NO_POINTERS;
+	}
+};
+
+/*! \brief Move a block of elements property by property for the interleaved layout
+ *
+ * The components of an array property are stored one after the other, each one has a
+ * size equal to the capacity of the vector
+ *
+ * \tparam vector_type vector
+ * \tparam T aggregate
+ *
+ */
+template<typename vector_type, typename T>
+struct prp_move_block_inte
+{
+	//! vector
+	vector_type & v;
+
+	//! destination element
+	size_t dst;
+
+	//! source element
+	size_t src;
+
+	//! number of elements
+	size_t n;
+
+	//! capacity of the vector
+	size_t cap;
+
+	/*! \brief constructor
+	 *
+	 * \param v vector
+	 * \param dst destination element
+	 * \param src source element
+	 * \param n number of elements
+	 *
+	 */
+	prp_move_block_inte(vector_type & v, size_t dst, size_t src, size_t n)
+	:v(v),dst(dst),src(src),n(n),cap(v.capacity())
+	{}
+
+	//! It move the property Tp
+	template<typename Tp>
+	inline void operator()(Tp & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,Tp>::type prp_type;
+		typedef typename std::remove_all_extents<prp_type>::type base;
+
+		const size_t n_comp = sizeof(prp_type) / sizeof(base);
+
+		base * ptr = static_cast<base *>(v.template getPointer<Tp::value>());
+
+		for (size_t c = 0 ; c < n_comp ; c++)
+		{memmove(ptr + c*cap + dst,ptr + c*cap + src,n*sizeof(base));}
+	}
+};
+
+/*! \brief Move a block of elements inside a vector
+ *
+ * Generic implementation, it copy the elements one by one
+ *
+ * \tparam T aggregate
+ * \tparam layout memory layout
+ * \tparam sel layout selector
+ *
+ */
+template<typename T, typename layout, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value>
+struct vector_move_block
+{
+	/*! \brief Move the elements [src,src+n) to [dst,dst+n)
+	 *
+	 * \warning dst must be smaller than src or the two ranges must not overlap
+	 *
+	 * \param v vector
+	 * \param dst destination element
+	 * \param src source element
+	 * \param n number of elements
+	 *
+	 */
+	template<typename vector_type>
+	static inline void move(vector_type & v, size_t dst, size_t src, size_t n)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{v.set(dst+i,v.get(src+i));}
+	}
+};
+
+//! Move a block of elements inside a vector with linear layout
+template<typename T, typename layout>
+struct vector_move_block<T,layout,2>
+{
+	template<typename vector_type>
+	static inline void move(vector_type & v, size_t dst, size_t src, size_t n)
+	{
+		prp_memmove_check<T> chk;
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(chk);
+
+		if (chk.ok == false)
+		{
+			vector_move_block<T,layout,0>::move(v,dst,src,n);
+			return;
+		}
+
+		char * ptr = static_cast<char *>(v.template getPointer<0>());
+		memmove(ptr + dst*sizeof(typename T::type),ptr + src*sizeof(typename T::type),n*sizeof(typename T::type));
+	}
+};
+
+//! Move a block of elements inside a vector with interleaved layout
+template<typename T, typename layout>
+struct vector_move_block<T,layout,1>
+{
+	template<typename vector_type>
+	static inline void move(vector_type & v, size_t dst, size_t src, size_t n)
+	{
+		prp_memmove_check<T> chk;
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(chk);
+
+		if (chk.ok == false)
+		{
+			vector_move_block<T,layout,0>::move(v,dst,src,n);
+			return;
+		}
+
+		prp_move_block_inte<vector_type,T> mv(v,dst,src,n);
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(mv);
+	}
+};
+
+#endif /* MAP_VECTOR_MOVE_UTIL_HPP_ */
@@ -0,0 +1,260 @@
+/*
+ * map_vector_par_util.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MAP_VECTOR_PAR_UTIL_HPP_
+#define MAP_VECTOR_PAR_UTIL_HPP_
+
+#include <algorithm>
+#include <vector>
+#include <type_traits>
+#include <limits>
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+//! Under this number of elements the host operations on vectors run serial
+#ifndef VECTOR_PAR_MIN_SIZE
+#define VECTOR_PAR_MIN_SIZE 32768
+#endif
+
+//! Number of elements processed by a thread in one range
+#define VECTOR_PAR_CHUNK 4096
+
+//! merge serially in the order of the source elements (default)
+constexpr int MERGE_PRP_SERIAL = 0;
+
+//! the merging indexes are unique, merge in parallel writing directly on the destination
+constexpr int MERGE_PRP_UNIQUE = 1;
+
+//! the merging indexes can be repeated, sort the source by destination and reduce in parallel
+constexpr int MERGE_PRP_SORT_REDUCE = 2;
+
+/*! \brief Run f(start,stop) over the ranges of VECTOR_PAR_CHUNK elements of [0,n)
+ *
+ * The ranges are distributed across the OpenMP threads, if n is smaller than
+ * VECTOR_PAR_MIN_SIZE the ranges are processed serially
+ *
+ * \param n number of elements
+ * \param f function to call on each range
+ *
+ */
+template<typename lambda_f>
+inline void vector_par_for(size_t n, lambda_f f)
+{
+	size_t n_chunk = (n + VECTOR_PAR_CHUNK - 1) / VECTOR_PAR_CHUNK;
+
+	#pragma omp parallel for schedule(dynamic) if (n >= VECTOR_PAR_MIN_SIZE)
+	for (size_t c = 0 ; c < n_chunk ; c++)
+	{
+		size_t start = c * VECTOR_PAR_CHUNK;
+		size_t stop = std::min(start + VECTOR_PAR_CHUNK,n);
+
+		f(start,stop);
+	}
+}
+
+/*! \brief Sort the source elements by destination (counting sort)
+ *
+ * The sort is stable, the source elements that go into the same destination keep their order
+ *
+ * \param n number of source elements
+ * \param n_dst number of destination elements
+ * \param key_f function that given the source element return the destination
+ * \param offs output for each destination d the source elements are ids[offs[d]] ... ids[offs[d+1]-1]
+ * \param ids output source elements sorted by destination
+ *
+ */
+template<typename vector_ids, typename key_func>
+void vector_sort_by_destination(size_t n, size_t n_dst, key_func key_f, vector_ids & offs, vector_ids & ids)
+{
+	// one more counter, the cursors of the destination d are in offs[d+1], at the end
+	// of the scatter offs[d+1] is the end of d (the start of d+1)
+	offs.resize(n_dst + 2);
+	ids.resize(n);
+
+	size_t * o = &offs.template get<0>(0);
+	std::fill(o,o + n_dst + 2,0);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{o[key_f(i) + 2]++;}
+
+	for (size_t d = 0 ; d < n_dst ; d++)
+	{o[d+2] += o[d+1];}
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		size_t & pos = o[key_f(i) + 1];
+		ids.template get<0>(pos) = i;
+		pos++;
+	}
+}
+
+/*! \brief Exclusive prefix sum of val_f(0) ... val_f(n-1) calculated in parallel
+ *
+ * The sum of each range of VECTOR_PAR_CHUNK elements is calculated in parallel, the
+ * ranges are scanned serially, and a second parallel pass call write_f(i,s) where s
+ * is the sum of val_f(0) ... val_f(i-1). val_f is called twice for each element
+ *
+ * \param n number of elements
+ * \param val_f function that given the element i return its value
+ * \param write_f function called with the element i and its exclusive prefix sum
+ *
+ * \return the sum of all the values
+ *
+ */
+template<typename val_func, typename write_func>
+size_t vector_par_scan(size_t n, val_func val_f, write_func write_f)
+{
+	size_t n_chunk = (n + VECTOR_PAR_CHUNK - 1) / VECTOR_PAR_CHUNK;
+	std::vector<size_t> sum(n_chunk + 1,0);
+
+	vector_par_for(n,[&](size_t start, size_t stop)
+	{
+		size_t s = 0;
+		for (size_t i = start ; i < stop ; i++)
+		{s += val_f(i);}
+
+		sum[start / VECTOR_PAR_CHUNK + 1] = s;
+	});
+
+	for (size_t c = 0 ; c < n_chunk ; c++)
+	{sum[c+1] += sum[c];}
+
+	vector_par_for(n,[&](size_t start, size_t stop)
+	{
+		size_t s = sum[start / VECTOR_PAR_CHUNK];
+		for (size_t i = start ; i < stop ; i++)
+		{
+			write_f(i,s);
+			s += val_f(i);
+		}
+	});
+
+	return sum[n_chunk];
+}
+
+/*! \brief Sort an array with a parallel LSD radix sort
+ *
+ * The keys are unsigned 64 bit integers, the bytes are processed from the least
+ * significant and only the bytes needed to represent max_key - min_key are sorted.
+ * Every thread count the digits of a contiguous block of the array, so the sort is
+ * stable. The blocks are decided on the team that OpenMP actually start, that can be
+ * smaller than the requested one (nested regions, dynamic threads, thread limits).
+ * Under VECTOR_PAR_MIN_SIZE elements it run serial
+ *
+ * \param v array to sort
+ * \param tmp buffer of the same size of v
+ * \param n number of elements
+ * \param key_f function that given an element return its key
+ *
+ */
+template<typename T, typename key_func>
+void vector_par_radix_sort(T * v, T * tmp, size_t n, key_func key_f)
+{
+	if (n <= 1)
+	{return;}
+
+	size_t k_min = std::numeric_limits<size_t>::max();
+	size_t k_max = 0;
+
+	#pragma omp parallel for reduction(min:k_min) reduction(max:k_max) if (n >= VECTOR_PAR_MIN_SIZE)
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		size_t k = key_f(v[i]);
+		k_min = (k < k_min)?k:k_min;
+		k_max = (k > k_max)?k:k_max;
+	}
+
+	int n_pass = 0;
+	for (size_t r = k_max - k_min ; r != 0 ; r >>= 8)
+	{n_pass++;}
+
+	int nt = 1;
+#ifdef HAVE_OPENMP
+	if (n >= VECTOR_PAR_MIN_SIZE)
+	{nt = omp_get_max_threads();}
+#endif
+
+	std::vector<size_t> hist(nt*256);
+
+	T * src = v;
+	T * dst = tmp;
+
+	for (int pass = 0 ; pass < n_pass ; pass++)
+	{
+		int sh = 8*pass;
+
+		int nt_r = 1;
+
+		#pragma omp parallel num_threads(nt)
+		{
+			// the team can be smaller than nt
+			#pragma omp single
+			{
+#ifdef HAVE_OPENMP
+				nt_r = omp_get_num_threads();
+#endif
+			}
+
+			int t = 0;
+#ifdef HAVE_OPENMP
+			t = omp_get_thread_num();
+#endif
+			size_t start = n * t / nt_r;
+			size_t stop = n * (t+1) / nt_r;
+
+			size_t * h = &hist[t*256];
+			std::fill(h,h+256,0);
+
+			for (size_t i = start ; i < stop ; i++)
+			{h[((key_f(src[i]) - k_min) >> sh) & 0xFF]++;}
+
+			#pragma omp barrier
+			#pragma omp single
+			{
+				// digit major, thread minor
+				size_t off = 0;
+				for (size_t d = 0 ; d < 256 ; d++)
+				{
+					for (int q = 0 ; q < nt_r ; q++)
+					{
+						size_t c = hist[q*256+d];
+						hist[q*256+d] = off;
+						off += c;
+					}
+				}
+			}
+
+			for (size_t i = start ; i < stop ; i++)
+			{dst[h[((key_f(src[i]) - k_min) >> sh) & 0xFF]++] = src[i];}
+		}
+
+		std::swap(src,dst);
+	}
+
+	if (src != v)
+	{
+		vector_par_for(n,[&](size_t start, size_t stop)
+		{std::copy(src + start,src + stop,v + start);});
+	}
+}
+
+/*! \brief Radix sort key of an integer, the order of the keys is the order of the integers
+ *
+ * \param x integer
+ *
+ * \return the key
+ *
+ */
+template<typename Ti>
+inline size_t radix_key(Ti x)
+{
+	// flip the sign bit of the sign extended value, so negative numbers come first
+	return (std::is_signed<Ti>::value)?((size_t)(long int)x ^ ((size_t)1 << 63)):(size_t)x;
+}
+
+#endif /* MAP_VECTOR_PAR_UTIL_HPP_ */
@@ -25,6 +25,16 @@
 #include "util/cuda/segreduce_ofp.cuh"
 #include "util/cuda/merge_ofp.cuh"
 
+//! flush_on_cpu merge in place when the new indexes times this ratio are not more than the old indexes
+#ifndef VECTOR_SPARSE_INPLACE_MERGE_RATIO
+#define VECTOR_SPARSE_INPLACE_MERGE_RATIO 64
+#endif
+
+//! get_sparse_batch interleave this number of binary searches for unsorted ids
+#ifndef VECTOR_SPARSE_BATCH_GROUP
+#define VECTOR_SPARSE_BATCH_GROUP 16
+#endif
+
 enum flush_type
 {
 	FLUSH_ON_HOST = 0,
@@ -325,123 +335,104 @@ namespace openfpm
 		}
 	};
 
-	template<typename reduction_type, typename vector_reduction, typename T,unsigned int impl, typename red_type>
+	template<typename reduction_type, unsigned int impl, typename red_type>
 	struct sparse_vector_reduction_cpu_impl
 	{
-		template<typename vector_data_type, typename vector_index_type,typename vector_index_type_reo>
-		static inline void red(size_t & i, vector_data_type & vector_data_red,
+		template<typename vector_data_type, typename vector_index_type_reo>
+		static inline void red(size_t s, size_t start, size_t stop,
+				   vector_data_type & vector_data_red,
 				   vector_data_type & vector_data,
-				   vector_index_type & vector_index,
 				   vector_index_type_reo & reorder_add_index_cpu)
 		{
-			size_t start = reorder_add_index_cpu.get(i).id;
-			red_type red = vector_data.template get<reduction_type::prop::value>(i);
+			red_type red = vector_data.template get<reduction_type::prop::value>(reorder_add_index_cpu.get(start).id2);
 
-			size_t j = 1;
-			for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
+			for (size_t j = start + 1 ; j < stop ; j++)
 			{
-				cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(i+j),red);
-				//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
+				cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(reorder_add_index_cpu.get(j).id2),red);
 			}
-			vector_data_red.add();
-			vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1) = red;
 
-			if (T::value == 0)
-			{
-				vector_index.add();
-				vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
-			}
-
-			i += j;
+			vector_data_red.template get<reduction_type::prop::value>(s) = red;
 		}
 	};
 
 
-	template<typename reduction_type, typename vector_reduction, typename T,unsigned int impl, typename red_type, unsigned int N1>
-	struct sparse_vector_reduction_cpu_impl<reduction_type,vector_reduction,T,impl,red_type[N1]>
+	template<typename reduction_type, unsigned int impl, typename red_type, unsigned int N1>
+	struct sparse_vector_reduction_cpu_impl<reduction_type,impl,red_type[N1]>
 	{
-		template<typename vector_data_type, typename vector_index_type,typename vector_index_type_reo>
-		static inline void red(size_t & i, vector_data_type & vector_data_red,
+		template<typename vector_data_type, typename vector_index_type_reo>
+		static inline void red(size_t s, size_t start, size_t stop,
+				   vector_data_type & vector_data_red,
 				   vector_data_type & vector_data,
-				   vector_index_type & vector_index,
 				   vector_index_type_reo & reorder_add_index_cpu)
 		{
-			size_t start = reorder_add_index_cpu.get(i).id;
 			red_type red[N1];
 
 			for (size_t k = 0 ; k < N1 ; k++)
 			{
-				red[k] = vector_data.template get<reduction_type::prop::value>(i)[k];
+				red[k] = vector_data.template get<reduction_type::prop::value>(reorder_add_index_cpu.get(start).id2)[k];
 			}
 
-			size_t j = 1;
-			for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
+			for (size_t j = start + 1 ; j < stop ; j++)
 			{
-				auto ev = vector_data.template get<reduction_type::prop::value>(i+j);
+				auto ev = vector_data.template get<reduction_type::prop::value>(reorder_add_index_cpu.get(j).id2);
 				cpu_block_process<reduction_type,impl+1>::process(ev,red);
-				//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
 			}
 
-			vector_data_red.add();
-
 			for (size_t k = 0 ; k < N1 ; k++)
 			{
-				vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1)[k] = red[k];
-			}
-
-			if (T::value == 0)
-			{
-				vector_index.add();
-				vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
+				vector_data_red.template get<reduction_type::prop::value>(s)[k] = red[k];
 			}
-
-			i += j;
 		}
 	};
 
 	/*! \brief this class is a functor for "for_each" algorithm
 	 *
-	 * This class is a functor for "for_each" algorithm. For each
-	 * element of the boost::vector the operator() is called.
-	 * Is mainly used to copy one encap into another encap object
+	 * For each reduction operator it reduce the segments of inserted elements with the
+	 * same index. The segments are distributed across the OpenMP threads, the elements
+	 * of a segment are reduced in the order they were inserted
 	 *
-	 * \tparam encap source
-	 * \tparam encap dst
+	 * \tparam vector_data_type vector of the data
+	 * \tparam vector_seg_type vector of the segment offsets
+	 * \tparam vector_index_type_reo vector of the inserted elements sorted by index
+	 * \tparam vector_reduction boost::mpl::vector of the reduction operators
+	 * \tparam impl implementation (VECTOR_SPARSE_STANDARD or VECTOR_SPARSE_BLOCK)
 	 *
 	 */
 	template<typename vector_data_type,
-			typename vector_index_type,
+			typename vector_seg_type,
 	        typename vector_index_type_reo,
 	        typename vector_reduction,
 	        unsigned int impl>
 	struct sparse_vector_reduction_cpu
 	{
-		//! Vector in which to the reduction
+		//! Vector in which to the reduction (one element for each segment)
 		vector_data_type & vector_data_red;
 
-		//! Vector in which to the reduction
+		//! inserted data (unsorted)
 		vector_data_type & vector_data;
 
-		//! reorder vector index
+		//! inserted elements sorted by index (id2 is the position in vector_data)
 		vector_index_type_reo & reorder_add_index_cpu;
 
-		//! Index type vector
-		vector_index_type & vector_index;
+		//! the segment s is reorder_add_index_cpu[seg_offset[s]] ... reorder_add_index_cpu[seg_offset[s+1]-1]
+		vector_seg_type & seg_offset;
 
 		/*! \brief constructor
 		 *
-		 * \param src source encapsulated object
-		 * \param dst source encapsulated object
+		 * \param vector_data_red output reduced data
+		 * \param vector_data inserted data
+		 * \param seg_offset segment offsets
+		 * \param reorder_add_index_cpu inserted elements sorted by index
 		 *
 		 */
 		inline sparse_vector_reduction_cpu(vector_data_type & vector_data_red,
 									   vector_data_type & vector_data,
-									   vector_index_type & vector_index,
+									   vector_seg_type & seg_offset,
 									   vector_index_type_reo & reorder_add_index_cpu)
-		:vector_data_red(vector_data_red),vector_data(vector_data),vector_index(vector_index),reorder_add_index_cpu(reorder_add_index_cpu)
+		:vector_data_red(vector_data_red),vector_data(vector_data),reorder_add_index_cpu(reorder_add_index_cpu),seg_offset(seg_offset)
 		{};
 
-		//! It call the copy function for each property
+		//! It reduce the segments for the property of the reduction operator T
 		template<typename T>
 		inline void operator()(T& t) const
 		{
@@ -450,30 +441,14 @@ namespace openfpm
 
             if (reduction_type::is_special() == false)
 			{
-    			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; )
-    			{
-    				sparse_vector_reduction_cpu_impl<reduction_type,vector_reduction,T,impl,red_type>::red(i,vector_data_red,vector_data,vector_index,reorder_add_index_cpu);
-
-/*    				size_t start = reorder_add_index_cpu.get(i).id;
-    				red_type red = vector_data.template get<reduction_type::prop::value>(i);
-
-    				size_t j = 1;
-    				for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
-    				{
-    					cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(i+j),red);
-    					//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
-    				}
-    				vector_data_red.add();
-    				vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1) = red;
-
-    				if (T::value == 0)
-    				{
-    					vector_index.add();
-    					vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
-    				}
-
-    				i += j;*/
-    			}
+            	vector_par_for(seg_offset.size() - 1,[&](size_t start, size_t stop)
+            	{
+            		for (size_t s = start ; s < stop ; s++)
+            		{
+            			sparse_vector_reduction_cpu_impl<reduction_type,impl,red_type>::red(s,seg_offset.template get<0>(s),seg_offset.template get<0>(s+1),
+            			                                                                  vector_data_red,vector_data,reorder_add_index_cpu);
+            		}
+            	});
 			}
 		}
 	};
@@ -818,6 +793,22 @@ namespace openfpm
 		CudaMemory mem;
 
 		openfpm::vector<reorder<Ti>> reorder_add_index_cpu;
+		openfpm::vector<reorder<Ti>> reorder_add_index_cpu_swp;
+
+		//! offsets of the segments of equal indexes in reorder_add_index_cpu
+		openfpm::vector<aggregate<size_t>> seg_offset_cpu;
+
+		//! for each added index: position in vct_index, position after the merge, 1 if it already exist
+		openfpm::vector<aggregate<size_t,size_t,char>> merge_pos_cpu;
+
+		//! Eytzinger layout of vct_index (1-based, empty if not valid)
+		openfpm::vector<Ti> index_mirror;
+
+		//! position in vct_index of the elements of index_mirror
+		openfpm::vector<Ti> index_mirror_pos;
+
+		//! true if the Eytzinger mirror is rebuilt on every host flush
+		bool index_mirror_on = false;
 
 		size_t max_ele;
 
@@ -867,6 +858,88 @@ namespace openfpm
 			id = (x == v)?id:vct_data.size()-1;
 		}
 
+		/*! \brief search the element x in the Eytzinger mirror of the indexes
+		 *
+		 * The mirror store the sorted indexes as an implicit binary tree in breadth-first
+		 * order, the search descend the tree prefetching the nodes some levels below
+		 *
+		 * \param x element to search
+		 * \param id output position of x in the data, or the position of the background
+		 *
+		 */
+		inline void _eytzinger_search(Ti x, Ti & id) const
+		{
+			const Ti * e = &index_mirror.get(0);
+			size_t n = index_mirror.size() - 1;
+			size_t k = 1;
+
+			while (k <= n)
+			{
+				__builtin_prefetch(e + k*(64/sizeof(Ti)), 0, 0);
+				k = 2*k + (e[k] < x);
+			}
+
+			// undo the right turns after the last left turn, k is the lower bound (0 if none)
+			k >>= __builtin_ffsll(~(long long)k);
+
+			id = (k != 0 && e[k] == x)?index_mirror_pos.get(k):vct_data.size()-1;
+		}
+
+		/*! \brief search the element x with the Eytzinger mirror if it is valid
+		 *
+		 * \param x element to search
+		 * \param id output position of x in the data, or the position of the background
+		 *
+		 */
+		inline void _search(Ti x, Ti & id) const
+		{
+			if (index_mirror.size() != 0)
+			{_eytzinger_search(x,id);}
+			else
+			{this->_branchfree_search<false>(x,id);}
+		}
+
+		/*! \brief Fill the Eytzinger mirror with an in-order visit of the implicit tree
+		 *
+		 * \param i next element of vct_index to place
+		 * \param k node of the tree
+		 *
+		 * \return the next element of vct_index to place after the sub-tree of k
+		 *
+		 */
+		size_t index_mirror_fill(size_t i, size_t k)
+		{
+			if (k >= index_mirror.size())
+			{return i;}
+
+			i = index_mirror_fill(i,2*k);
+
+			index_mirror.get(k) = vct_index.template get<0>(i);
+			index_mirror_pos.get(k) = i;
+			i++;
+
+			return index_mirror_fill(i,2*k+1);
+		}
+
+		/*! \brief Rebuild the Eytzinger mirror (if enabled) after vct_index changed on host, or drop it
+		 *
+		 * \param on_host true if vct_index on host is up to date
+		 *
+		 */
+		void index_mirror_update(bool on_host)
+		{
+			index_mirror.clear();
+			index_mirror_pos.clear();
+
+			if (index_mirror_on == false || on_host == false)
+			{return;}
+
+			index_mirror.resize(vct_index.size() + 1);
+			index_mirror_pos.resize(vct_index.size() + 1);
+
+			index_mirror_fill(0,1);
+		}
+
 
 		/* \brief take the indexes for the insertion pools and create a continuos array
 		 *
@@ -1378,104 +1451,182 @@ namespace openfpm
 			if (vct_add_index.size() == 0)
 			{return;}
 
-			// First copy the added index to reorder
-			reorder_add_index_cpu.resize(vct_add_index.size());
-			vct_add_data_cont.resize(vct_add_index.size());
+			size_t n_add = vct_add_index.size();
 
-			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; i++)
+			// Sort the added indexes, id2 is the position of the added element
+			reorder_add_index_cpu.resize(n_add);
+			reorder_add_index_cpu_swp.resize(n_add);
+
+			vector_par_for(n_add,[&](size_t start, size_t stop)
 			{
-				reorder_add_index_cpu.get(i).id = vct_add_index.template get<0>(i);
-				reorder_add_index_cpu.get(i).id2 = i;
-			}
+				for (size_t i = start ; i < stop ; i++)
+				{
+					reorder_add_index_cpu.get(i).id = vct_add_index.template get<0>(i);
+					reorder_add_index_cpu.get(i).id2 = i;
+				}
+			});
+
+			vector_par_radix_sort(&reorder_add_index_cpu.get(0),&reorder_add_index_cpu_swp.get(0),n_add,
+			                      [](const reorder<Ti> & r) {return radix_key(r.id);});
+
+			// Find the segments of equal indexes
+			auto is_head = [&](size_t i) -> size_t
+			{return i == 0 || reorder_add_index_cpu.get(i).id != reorder_add_index_cpu.get(i-1).id;};
 
-			reorder_add_index_cpu.sort();
+			seg_offset_cpu.resize(n_add + 1);
 
-			// Copy the data
-			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; i++)
+			size_t n_seg = vector_par_scan(n_add,is_head,[&](size_t i, size_t s)
 			{
-				vct_add_data_cont.get(i) = vct_add_data.get(reorder_add_index_cpu.get(i).id2);
-			}
+				if (is_head(i))
+				{seg_offset_cpu.template get<0>(s) = i;}
+			});
+
+			seg_offset_cpu.resize(n_seg + 1);
+			seg_offset_cpu.template get<0>(n_seg) = n_add;
+
+			// Reduce every segment
+			vct_add_index_unique.resize(n_seg);
+			vct_add_data_unique.resize(n_seg);
+
+			vector_par_for(n_seg,[&](size_t start, size_t stop)
+			{
+				for (size_t k = start ; k < stop ; k++)
+				{vct_add_index_unique.template get<0>(k) = reorder_add_index_cpu.get(seg_offset_cpu.template get<0>(k)).id;}
+			});
 
 			typedef boost::mpl::vector<v_reduce...> vv_reduce;
 
 			sparse_vector_reduction_cpu<decltype(vct_add_data),
-										decltype(vct_add_index_unique),
+										decltype(seg_offset_cpu),
 										decltype(reorder_add_index_cpu),
 										vv_reduce,
 										impl2>
 			        svr(vct_add_data_unique,
-			        	vct_add_data_cont,
-			        	vct_add_index_unique,
+			        	vct_add_data,
+			        	seg_offset_cpu,
 			        	reorder_add_index_cpu);
 
 			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(svr);
 
-			// merge the the data
+			// merge the the data, for every added index find the position in vct_index and if it already exist,
+			// its position after the merge is the position in vct_index plus the new indexes before it
 
-			vector<T,Memory,layout_base,grow_p,impl> vct_data_tmp;
-			vector<aggregate<Ti>,Memory,layout_base,grow_p> vct_index_tmp;
+			size_t n_old = vct_index.size();
+			merge_pos_cpu.resize(n_seg);
 
-			vct_data_tmp.resize(vct_data.size() + vct_add_data_unique.size());
-			vct_index_tmp.resize(vct_index.size() + vct_add_index_unique.size());
+			const Ti * idx = (n_old != 0)?&vct_index.template get<0>(0):NULL;
+
+			vector_par_for(n_seg,[&](size_t start, size_t stop)
+			{
+				for (size_t k = start ; k < stop ; k++)
+				{
+					Ti id = vct_add_index_unique.template get<0>(k);
+					size_t p = std::lower_bound(idx,idx + n_old,id) - idx;
+
+					merge_pos_cpu.template get<0>(k) = p;
+					merge_pos_cpu.template get<2>(k) = (p < n_old && idx[p] == id);
+				}
+			});
+
+			size_t n_new = vector_par_scan(n_seg,[&](size_t k) -> size_t {return 1 - merge_pos_cpu.template get<2>(k);},
+			                               [&](size_t k, size_t s) {merge_pos_cpu.template get<1>(k) = merge_pos_cpu.template get<0>(k) + s;});
 
-			Ti di = 0;
-			Ti ai = 0;
-			size_t i = 0;
+			if (n_new * VECTOR_SPARSE_INPLACE_MERGE_RATIO <= n_old)
+			{
+				// Few new indexes, move the old elements in place starting from the last block.
+				// The old elements before the first new index are not touched
+				vct_index.resize(n_old + n_new);
+				vct_data.resize(n_old + n_new);
+
+				size_t shift = n_new;
+				for (long int k = n_seg - 1 ; k >= 0 && shift != 0 ; k--)
+				{
+					size_t b_start = merge_pos_cpu.template get<0>(k);
+					size_t b_stop = (k == (long int)n_seg - 1)?n_old:merge_pos_cpu.template get<0>(k+1);
+
+					for (size_t j = b_stop ; j > b_start ; j--)
+					{
+						vct_index.template get<0>(j - 1 + shift) = vct_index.template get<0>(j - 1);
+						vct_data.get(j - 1 + shift) = vct_data.get(j - 1);
+					}
 
-			for ( ; i < vct_data_tmp.size() ; i++)
+					shift -= 1 - merge_pos_cpu.template get<2>(k);
+				}
+			}
+			else
 			{
-				Ti id_a = (ai < vct_add_index_unique.size())?vct_add_index_unique.template get<0>(ai):std::numeric_limits<Ti>::max();
-				Ti id_d = (di < vct_index.size())?vct_index.template get<0>(di):std::numeric_limits<Ti>::max();
+				vector<T,Memory,layout_base,grow_p,impl> vct_data_tmp;
+				vector<aggregate<Ti>,Memory,layout_base,grow_p> vct_index_tmp;
 
-				if (  id_a <= id_d )
+				vct_data_tmp.resize(n_old + n_new);
+				vct_index_tmp.resize(n_old + n_new);
+
+				// Every range of old elements find with a binary search the number of new indexes before it
+				vector_par_for(n_old,[&](size_t start, size_t stop)
 				{
-					vct_index_tmp.template get<0>(i) = id_a;
+					size_t lo = 0;
+					size_t hi = n_seg;
 
-					if (id_a == id_d)
+					while (lo < hi)
 					{
-						auto dst = vct_data_tmp.get(i);
-						auto src = vct_add_data_unique.get(ai);
+						size_t mid = (lo + hi) / 2;
 
-						sparse_vector_reduction_solve_conflict_assign_cpu<decltype(vct_data_tmp.get(i)),
-																		  decltype(vct_add_data.get(ai)),
-																		  vv_reduce>
-						sva(src,dst);
+						if (merge_pos_cpu.template get<0>(mid) <= start)
+						{lo = mid + 1;}
+						else
+						{hi = mid;}
+					}
 
-						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(sva);
-						ai++;
+					size_t k = lo;
+					size_t shift = (k < n_seg)?merge_pos_cpu.template get<1>(k) - merge_pos_cpu.template get<0>(k):n_new;
 
-						dst = vct_data_tmp.get(i);
-						src = vct_data.get(di);
+					for (size_t j = start ; j < stop ; j++)
+					{
+						for ( ; k < n_seg && merge_pos_cpu.template get<0>(k) <= j ; k++)
+						{shift += 1 - merge_pos_cpu.template get<2>(k);}
 
-						sparse_vector_reduction_solve_conflict_reduce_cpu<decltype(vct_data_tmp.get(i)),
-								  	  	  	  	  	  	  	  	  	  	  decltype(vct_data.get(di)),
-								  	  	  	  	  	  	  	  	  	  	  vv_reduce,
-								  	  	  	  	  	  	  	  	  	  	  impl2>
-						svr(src,dst);
-						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(svr);
+						vct_index_tmp.template get<0>(j + shift) = vct_index.template get<0>(j);
+						vct_data_tmp.get(j + shift) = vct_data.get(j);
+					}
+				});
 
-						di++;
+				vct_index.swap(vct_index_tmp);
+				vct_data.swap(vct_data_tmp);
+			}
 
-						vct_data_tmp.resize(vct_data_tmp.size()-1);
-						vct_index_tmp.resize(vct_index_tmp.size()-1);
+			// Write the added elements, when the index already exist the old element is reduced
+			// into the added one and the reduced properties are copied back
+			vector_par_for(n_seg,[&](size_t start, size_t stop)
+			{
+				for (size_t k = start ; k < stop ; k++)
+				{
+					size_t i = merge_pos_cpu.template get<1>(k);
+
+					if (merge_pos_cpu.template get<2>(k) == 0)
+					{
+						vct_index.template get<0>(i) = vct_add_index_unique.template get<0>(k);
+						vct_data.get(i) = vct_add_data_unique.get(k);
 					}
 					else
 					{
-						vct_index_tmp.template get<0>(i) = vct_add_index_unique.template get<0>(ai);
-						vct_data_tmp.get(i) = vct_add_data_unique.get(ai);
-						ai++;
+						auto dst = vct_add_data_unique.get(k);
+						auto src = vct_data.get(i);
+
+						sparse_vector_reduction_solve_conflict_reduce_cpu<decltype(src),
+																		  decltype(dst),
+																		  vv_reduce,
+																		  impl2>
+						svr(src,dst);
+						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(svr);
+
+						sparse_vector_reduction_solve_conflict_assign_cpu<decltype(dst),
+																		  decltype(src),
+																		  vv_reduce>
+						sva(dst,src);
+						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(sva);
 					}
 				}
-				else
-				{
-					vct_index_tmp.template get<0>(i) = vct_index.template get<0>(di);
-					vct_data_tmp.get(i) = vct_data.get(di);
-					di++;
-				}
-			}
-
-			vct_index.swap(vct_index_tmp);
-			vct_data.swap(vct_data_tmp);
+			});
 
 			vct_add_data.clear();
 			vct_add_index.clear();
@@ -1541,13 +1692,131 @@ namespace openfpm
 		inline openfpm::sparse_index<Ti> get_sparse(Ti id) const
 		{
 			Ti di;
-			this->_branchfree_search<false>(id,di);
+			this->_search(id,di);
 			openfpm::sparse_index<Ti> sid;
 			sid.id = di;
 
 			return sid;
 		}
 
+		/*! \brief Get the sparse index of a set of elements
+		 *
+		 * For each i pos.template get<0>(i) is set to the position in the data buffer (getDataBuffer())
+		 * of the element ids.template get<0>(i), or to the position of the background if the element
+		 * does not exist. Unsorted ids are searched with groups of VECTOR_SPARSE_BATCH_GROUP interleaved
+		 * binary searches, so the cache misses of the searches overlap. Sorted ids are searched with a
+		 * merge-join, each id start a galloping search from the position of the previous one.
+		 * The ids are processed in parallel
+		 *
+		 * \param ids elements to get (for example an openfpm::vector<aggregate<Ti>>)
+		 * \param pos output positions in the data buffer, it is resized to ids.size()
+		 * \param sorted true if the ids are sorted in increasing order
+		 *
+		 */
+		template<typename vector_ids_type, typename vector_pos_type>
+		void get_sparse_batch(const vector_ids_type & ids, vector_pos_type & pos, bool sorted = false) const
+		{
+			pos.resize(ids.size());
+
+			const size_t n = vct_index.size();
+			const Ti bck_pos = vct_data.size()-1;
+
+			if (n == 0)
+			{
+				for (size_t i = 0 ; i < ids.size() ; i++)
+				{pos.template get<0>(i) = bck_pos;}
+
+				return;
+			}
+
+			const Ti * a = &vct_index.template get<0>(0);
+
+			if (sorted == true)
+			{
+				vector_par_for(ids.size(),[&](size_t start, size_t stop)
+				{
+					size_t p = std::lower_bound(a,a+n,(Ti)ids.template get<0>(start)) - a;
+
+					for (size_t i = start ; i < stop ; i++)
+					{
+						Ti x = ids.template get<0>(i);
+
+						// gallop from the previous position, a[lo] < x or lo == p
+						size_t lo = p;
+						size_t step = 1;
+						while (p + step < n && a[p + step] < x)
+						{
+							lo = p + step;
+							step *= 2;
+						}
+
+						p = std::lower_bound(a+lo,a+std::min(p+step,n),x) - a;
+
+						pos.template get<0>(i) = (p < n && a[p] == x)?(Ti)p:bck_pos;
+					}
+				});
+
+				return;
+			}
+
+			vector_par_for(ids.size(),[&](size_t start, size_t stop)
+			{
+				Ti x[VECTOR_SPARSE_BATCH_GROUP];
+				const Ti * base[VECTOR_SPARSE_BATCH_GROUP];
+
+				for (size_t g0 = start ; g0 < stop ; g0 += VECTOR_SPARSE_BATCH_GROUP)
+				{
+					size_t ng = std::min((size_t)VECTOR_SPARSE_BATCH_GROUP,stop - g0);
+
+					for (size_t g = 0 ; g < ng ; g++)
+					{
+						x[g] = ids.template get<0>(g0 + g);
+						base[g] = a;
+					}
+
+					// all the searches have the same length, they proceed in lockstep
+					size_t len = n;
+					while (len > 1)
+					{
+						size_t half = len / 2;
+
+						for (size_t g = 0 ; g < ng ; g++)
+						{__builtin_prefetch(base[g] + half/2, 0, 0);}
+
+						for (size_t g = 0 ; g < ng ; g++)
+						{base[g] = (base[g][half] < x[g])?base[g]+half:base[g];}
+
+						len -= half;
+					}
+
+					for (size_t g = 0 ; g < ng ; g++)
+					{
+						size_t p = base[g] - a + (*base[g] < x[g]);
+						pos.template get<0>(g0 + g) = (p < n && a[p] == x[g])?(Ti)p:bck_pos;
+					}
+				}
+			});
+		}
+
+		/*! \brief Enable or disable the Eytzinger mirror of the indexes
+		 *
+		 * When enabled a copy of the indexes in Eytzinger (breadth-first) layout is built on every
+		 * host flush and used by get and get_sparse, the search prefetch the next levels of the tree
+		 * and is faster than the binary search on large vectors. Operations that change the indexes
+		 * outside a host flush (insertFlush, device flush, swapIndexVector) drop the mirror until
+		 * the next host flush or call to setIndexMirror
+		 *
+		 * \note if the index buffer is changed with getIndexBuffer, call setIndexMirror(true) again
+		 *
+		 * \param on true to enable the mirror
+		 *
+		 */
+		void setIndexMirror(bool on)
+		{
+			index_mirror_on = on;
+			index_mirror_update(true);
+		}
+
 		/*! \brief Get an element of the vector
 		 *
 		 * Get an element of the vector
@@ -1562,7 +1831,7 @@ namespace openfpm
 		inline auto get(Ti id) const -> decltype(vct_data.template get<p>(id))
 		{
 			Ti di;
-			this->_branchfree_search<false>(id,di);
+			this->_search(id,di);
 			return vct_data.template get<p>(di);
 		}
 
@@ -1579,7 +1848,7 @@ namespace openfpm
 		inline auto get(Ti id) const -> decltype(vct_data.get(id))
 		{
 			Ti di;
-			this->_branchfree_search<false>(id,di);
+			this->_search(id,di);
 			return vct_data.get(di);
 		}
 
@@ -1604,6 +1873,7 @@ namespace openfpm
 		void swapIndexVector(vector<aggregate<Ti>,Memory,layout_base,grow_p> & iv)
 		{
 			vct_index.swap(iv);
+			index_mirror_update(false);
 		}
 
 		/*! \brief Set the background to bck (which value get must return when the value is not find)
@@ -1680,6 +1950,7 @@ namespace openfpm
 			is_new = true;
 			
 			// It does not exist, we create it di contain the index where we have to create the new block
+			index_mirror_update(false);
 			vct_index.insert(di);
 			vct_data.isert(di);
 
@@ -1706,6 +1977,7 @@ namespace openfpm
 			}
 
 			// It does not exist, we create it di contain the index where we have to create the new block
+			index_mirror_update(false);
 			vct_index.insert(di);
 			vct_data.insert(di);
 			is_new = true;
@@ -1750,6 +2022,7 @@ namespace openfpm
 			{this->flush_on_cpu<v_reduce ... >();}
 
 			resetBck();
+			index_mirror_update(!(opt & flush_type::FLUSH_ON_DEVICE));
 		}
 
 		/*! \brief merge the added element to the main data array but save the insert buffer in v
@@ -1773,6 +2046,7 @@ namespace openfpm
 			{this->flush_on_cpu<v_reduce ... >();}
 
 			resetBck();
+			index_mirror_update(!(opt & flush_type::FLUSH_ON_DEVICE));
 		}
 
 		/*! \brief merge the added element to the main data array
@@ -1792,6 +2066,7 @@ namespace openfpm
 			{this->flush_on_cpu<v_reduce ... >();}
 
 			resetBck();
+			index_mirror_update(!(opt & flush_type::FLUSH_ON_DEVICE));
 		}
 
 		/*! \brief merge the added element to the main data array
@@ -1811,6 +2086,7 @@ namespace openfpm
 			}
 
 			resetBck();
+			index_mirror_update(false);
 		}
 
 		/*! \brief Return how many element you have in this map
@@ -1967,6 +2243,8 @@ namespace openfpm
 			max_ele = 0;
 			n_gpu_add_block_slot = 0;
 			n_gpu_rem_block_slot = 0;
+
+			index_mirror_update(true);
 		}
 
 		void swap(vector_sparse<T,Ti,Memory,layout,layout_base,grow_p,impl,impl2,block_functor> & sp)
@@ -1979,6 +2257,10 @@ namespace openfpm
 			size_t max_ele_ = sp.max_ele;
 			sp.max_ele = max_ele;
 			this->max_ele = max_ele_;
+
+			index_mirror.swap(sp.index_mirror);
+			index_mirror_pos.swap(sp.index_mirror_pos);
+			std::swap(index_mirror_on,sp.index_mirror_on);
 		}
 
 		vector<T,Memory,layout_base,grow_p> & private_get_vct_add_data()
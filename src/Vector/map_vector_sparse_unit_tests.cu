@@ -2,6 +2,7 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 #include "map_vector_sparse.hpp"
+#include <map>
 
 BOOST_AUTO_TEST_SUITE( sparse_vector_test )
 
@@ -89,4 +90,198 @@ BOOST_AUTO_TEST_CASE ( test_sparse_vector_use )
 	BOOST_REQUIRE_EQUAL(vs.get<0>(1),2050);
 }
 
+BOOST_AUTO_TEST_CASE ( test_sparse_vector_flush_cpu )
+{
+	openfpm::vector_sparse<aggregate<int,float,int>> vs;
+
+	vs.template setBackground<0>(0);
+	vs.template setBackground<1>(-1.0);
+	vs.template setBackground<2>(-1);
+
+	std::map<long int,int> ref_add;
+	std::map<long int,float> ref_right;
+	std::map<long int,int> ref_max;
+
+	gpu::ofp_context_t gpuContext;
+
+	srand(0);
+
+	// many insertions (merge on a new vector), few insertions (merge in place), many insertions with negative indexes
+	size_t n_ins[] = {200000,100,200000};
+	long int id_low[] = {0,0,-500000};
+
+	for (size_t r = 0 ; r < 3 ; r++)
+	{
+		std::map<long int,float> last;
+
+		for (size_t i = 0 ; i < n_ins[r] ; i++)
+		{
+			long int id = id_low[r] + rand() % 1000000;
+			int v = rand() % 1000;
+
+			auto e = vs.insert(id);
+			e.template get<0>() = v;
+			e.template get<1>() = v + 0.5f;
+			e.template get<2>() = v;
+
+			ref_add[id] += v;
+			last[id] = v + 0.5f;
+			ref_max[id] = (ref_max.find(id) == ref_max.end())?v:std::max(ref_max[id],v);
+		}
+
+		// sRight keep the last inserted element, but the old value when the index already exist
+		for (auto & l : last)
+		{
+			if (ref_right.find(l.first) == ref_right.end())
+			{ref_right[l.first] = l.second;}
+		}
+
+		vs.template flush<sadd_<0>,sRight_<1>,smax_<2>>(gpuContext);
+
+		BOOST_REQUIRE_EQUAL(vs.size(),ref_add.size());
+
+		bool match = true;
+		for (auto & a : ref_add)
+		{
+			match &= vs.template get<0>(a.first) == a.second;
+			match &= vs.template get<1>(a.first) == ref_right[a.first];
+			match &= vs.template get<2>(a.first) == ref_max[a.first];
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+		BOOST_REQUIRE_EQUAL(vs.template get<2>(2000000),-1);
+	}
+}
+
+/*! \brief Radix sort an array and check it against std::stable_sort
+ *
+ * \return true if the result match
+ *
+ */
+static bool test_radix_sort_check()
+{
+	size_t n = 4*VECTOR_PAR_MIN_SIZE + 17;
+
+	std::vector<std::pair<long int,size_t>> v(n);
+	std::vector<std::pair<long int,size_t>> tmp(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{v[i] = std::make_pair((long int)(rand() % 100000) - 50000,i);}
+
+	std::vector<std::pair<long int,size_t>> ref = v;
+	std::stable_sort(ref.begin(),ref.end(),[](const std::pair<long int,size_t> & a, const std::pair<long int,size_t> & b){return a.first < b.first;});
+
+	vector_par_radix_sort(&v[0],&tmp[0],n,[](const std::pair<long int,size_t> & a){return radix_key(a.first);});
+
+	return v == ref;
+}
+
+BOOST_AUTO_TEST_CASE ( test_sparse_vector_radix_sort_team )
+{
+	srand(0);
+
+	// default team
+	BOOST_REQUIRE_EQUAL(test_radix_sort_check(),true);
+
+#ifdef HAVE_OPENMP
+
+	// OpenMP can start less threads than requested
+	int dyn = omp_get_dynamic();
+	omp_set_dynamic(1);
+
+	BOOST_REQUIRE_EQUAL(test_radix_sort_check(),true);
+
+	omp_set_dynamic(dyn);
+
+	// called inside a parallel region, the inner team has one thread
+	bool match = true;
+
+	#pragma omp parallel num_threads(2) reduction(&&:match)
+	{
+		#pragma omp critical
+		{match = test_radix_sort_check();}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+#endif
+}
+
+BOOST_AUTO_TEST_CASE ( test_sparse_vector_get_batch )
+{
+	openfpm::vector_sparse<aggregate<int>> vs;
+	vs.template setBackground<0>(-1);
+
+	gpu::ofp_context_t gpuContext;
+
+	// an empty vector return the background
+	openfpm::vector<aggregate<long int>> ids;
+	openfpm::vector<aggregate<long int>> pos;
+
+	ids.add();
+	ids.template get<0>(0) = 3;
+	vs.get_sparse_batch(ids,pos);
+	BOOST_REQUIRE_EQUAL(pos.template get<0>(0),vs.getDataBuffer().size()-1);
+
+	vs.setIndexMirror(true);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(3),-1);
+
+	// only even indexes exist
+	for (int i = -50000 ; i < 50000 ; i++)
+	{vs.template insert<0>(2*i) = i;}
+
+	vs.template flush<sadd_<0>>(gpuContext);
+
+	srand(0);
+	ids.resize(100000);
+	for (size_t i = 0 ; i < ids.size() ; i++)
+	{ids.template get<0>(i) = rand() % 220000 - 110000;}
+
+	// unsorted batch, get with the mirror and without it
+	vs.get_sparse_batch(ids,pos);
+
+	bool match = true;
+	for (size_t i = 0 ; i < ids.size() ; i++)
+	{
+		long int id = ids.template get<0>(i);
+		int exp = (id % 2 == 0 && id >= -100000 && id < 100000)?id/2:-1;
+
+		match &= vs.getDataBuffer().template get<0>(pos.template get<0>(i)) == exp;
+		match &= vs.template get<0>(id) == exp;
+	}
+
+	vs.setIndexMirror(false);
+	for (size_t i = 0 ; i < ids.size() ; i++)
+	{match &= vs.template get<0>(ids.template get<0>(i)) == vs.getDataBuffer().template get<0>(pos.template get<0>(i));}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// sorted batch
+	openfpm::vector<aggregate<long int>> pos_s;
+	std::sort(&ids.template get<0>(0),&ids.template get<0>(0) + ids.size());
+	vs.get_sparse_batch(ids,pos_s,true);
+	vs.get_sparse_batch(ids,pos);
+
+	for (size_t i = 0 ; i < ids.size() ; i++)
+	{match &= pos.template get<0>(i) == pos_s.template get<0>(i);}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// insertFlush drop the mirror, the next flush rebuild it
+	bool is_new;
+	vs.setIndexMirror(true);
+	vs.insertFlush(1,is_new).template get<0>() = 7;
+	BOOST_REQUIRE_EQUAL(is_new,true);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(1),7);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(2),1);
+
+	vs.template insert<0>(3) = 9;
+	vs.template flush<sadd_<0>>(gpuContext);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(1),7);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(3),9);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(5),-1);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(-100000),-50000);
+	BOOST_REQUIRE_EQUAL(vs.template get<0>(-100002),-1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
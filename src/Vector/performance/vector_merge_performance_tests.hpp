@@ -0,0 +1,122 @@
+/*
+ * vector_merge_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_MERGE_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_MERGE_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Time a merge (or add) between vectors
+ *
+ * \param f function that reset the destination
+ * \param m function that does the merge
+ * \param mean output mean time
+ * \param dev output standard deviation
+ *
+ */
+template<typename reset_func, typename merge_func>
+void vector_performance_merge_time(reset_func f, merge_func m, double & mean, double & dev)
+{
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		f();
+
+		timer t;
+		t.start();
+
+		m();
+
+		t.stop();
+		times.add(t.getwct());
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+BOOST_AUTO_TEST_SUITE( vector_merge_performance )
+
+BOOST_AUTO_TEST_CASE(vector_performance_merge_prp)
+{
+	typedef aggregate<double,double[3]> obj;
+
+	size_t n_dst = 1 << 22;
+	size_t n_src = 1 << 22;
+
+	openfpm::vector<obj> src;
+	openfpm::vector<size_t> opart_u;
+	openfpm::vector<size_t> opart_r;
+
+	src.resize(n_src);
+	opart_u.resize(n_src);
+	opart_r.resize(n_src);
+
+	for (size_t i = 0 ; i < n_src ; i++)
+	{
+		src.template get<0>(i) = i;
+		src.template get<1>(i)[0] = 1.0;
+		src.template get<1>(i)[1] = 2.0;
+		src.template get<1>(i)[2] = 3.0;
+
+		// a permutation (unique indexes) and a ghost_put like pattern with repeated indexes
+		opart_u.get(i) = (i * 7919) % n_dst;
+		opart_r.get(i) = (i * 7919) % (n_dst / 4);
+	}
+
+	openfpm::vector<obj> dst;
+
+	auto reset = [&]()
+	{
+		dst.resize(n_dst);
+		for (size_t i = 0 ; i < n_dst ; i++)
+		{
+			dst.template get<0>(i) = 0.0;
+			dst.template get<1>(i)[0] = 0.0;
+			dst.template get<1>(i)[1] = 0.0;
+			dst.template get<1>(i)[2] = 0.0;
+		}
+	};
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	// 1,2,4 ... threads, the last one is always max_threads
+	for (size_t nt = 1 ; nt <= max_threads ; nt = (nt < max_threads && 2*nt > max_threads)?max_threads:2*nt)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		double mean_s, dev_s, mean_u, dev_u, mean_sr, dev_sr, mean_rs, dev_rs, mean_a, dev_a;
+
+		vector_performance_merge_time(reset,[&](){dst.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart_u);},mean_s,dev_s);
+		vector_performance_merge_time(reset,[&](){dst.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart_u,MERGE_PRP_UNIQUE);},mean_u,dev_u);
+		vector_performance_merge_time(reset,[&](){dst.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart_r);},mean_rs,dev_rs);
+		vector_performance_merge_time(reset,[&](){dst.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart_r,MERGE_PRP_SORT_REDUCE);},mean_sr,dev_sr);
+		vector_performance_merge_time([&](){dst.clear();},[&](){dst.template add_prp<obj,HeapMemory,typename openfpm::grow_policy_double,OPENFPM_NATIVE,memory_traits_lin,0,1>(src);},mean_a,dev_a);
+
+		std::cout << "Vector merge_prp " << n_src << " elements, threads: " << nt << std::endl;
+		std::cout << "    unique indexes  serial: " << mean_s << " s (dev " << dev_s << ")  parallel: " << mean_u << " s (dev " << dev_u << ")  speedup: " << mean_s / mean_u << std::endl;
+		std::cout << "    repeated indexes  serial: " << mean_rs << " s (dev " << dev_rs << ")  sort-reduce: " << mean_sr << " s (dev " << dev_sr << ")  speedup: " << mean_rs / mean_sr << std::endl;
+		std::cout << "    add_prp: " << mean_a << " s (dev " << dev_a << ")" << std::endl;
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_MERGE_PERFORMANCE_TESTS_HPP_ */
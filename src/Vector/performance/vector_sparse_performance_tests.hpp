@@ -0,0 +1,138 @@
+/*
+ * vector_sparse_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_SPARSE_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_SPARSE_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "Vector/map_vector_sparse.hpp"
+#include "util/stat/common_statistics.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Time a set of lookups on a sparse vector
+ *
+ * \param f function that does the lookups and return a checksum
+ * \param mean output mean time
+ * \param dev output standard deviation
+ * \param check output checksum
+ *
+ */
+template<typename lookup_func>
+void vector_sparse_performance_time(lookup_func f, double & mean, double & dev, long int & check)
+{
+	openfpm::vector<double> times;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		check = f();
+
+		t.stop();
+		times.add(t.getwct());
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+BOOST_AUTO_TEST_SUITE( vector_sparse_performance )
+
+BOOST_AUTO_TEST_CASE(vector_sparse_performance_get)
+{
+	size_t n_ele = 1 << 24;
+	size_t n_qry = 1 << 21;
+
+	openfpm::vector_sparse<aggregate<int>> vs;
+	vs.template setBackground<0>(0);
+
+	gpu::ofp_context_t gpuContext;
+
+	// one index every three exist
+	for (size_t i = 0 ; i < n_ele ; i++)
+	{vs.template insert<0>(3*i) = 1 + (i & 0xFF);}
+
+	vs.template flush<sadd_<0>>(gpuContext);
+
+	openfpm::vector<aggregate<long int>> ids;
+	openfpm::vector<aggregate<long int>> ids_s;
+	openfpm::vector<aggregate<long int>> pos;
+
+	ids.resize(n_qry);
+
+	srand(0);
+	for (size_t i = 0 ; i < n_qry ; i++)
+	{ids.template get<0>(i) = ((size_t)rand() * RAND_MAX + rand()) % (3*n_ele);}
+
+	ids_s = ids;
+	std::sort(&ids_s.template get<0>(0),&ids_s.template get<0>(0) + n_qry);
+
+	auto get_all = [&]()
+	{
+		long int sum = 0;
+		for (size_t i = 0 ; i < n_qry ; i++)
+		{sum += vs.template get<0>(ids.template get<0>(i));}
+
+		return sum;
+	};
+
+	auto get_batch = [&](openfpm::vector<aggregate<long int>> & q, bool sorted)
+	{
+		vs.get_sparse_batch(q,pos,sorted);
+
+		long int sum = 0;
+		for (size_t i = 0 ; i < n_qry ; i++)
+		{sum += vs.getDataBuffer().template get<0>(pos.template get<0>(i));}
+
+		return sum;
+	};
+
+	size_t max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+
+	double mean_g, dev_g, mean_e, dev_e, mean_b, dev_b, mean_bs, dev_bs, mean_bp, dev_bp, mean_bsp, dev_bsp;
+	long int check_g, check_e, check_b, check_bs, check_bp, check_bsp;
+
+	vector_sparse_performance_time(get_all,mean_g,dev_g,check_g);
+
+	vs.setIndexMirror(true);
+	vector_sparse_performance_time(get_all,mean_e,dev_e,check_e);
+	vs.setIndexMirror(false);
+
+	vector_sparse_performance_time([&](){return get_batch(ids,false);},mean_b,dev_b,check_b);
+	vector_sparse_performance_time([&](){return get_batch(ids_s,true);},mean_bs,dev_bs,check_bs);
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+
+	vector_sparse_performance_time([&](){return get_batch(ids,false);},mean_bp,dev_bp,check_bp);
+	vector_sparse_performance_time([&](){return get_batch(ids_s,true);},mean_bsp,dev_bsp,check_bsp);
+
+	std::cout << "Vector sparse " << n_qry << " lookups on " << n_ele << " elements" << std::endl;
+	std::cout << "    get (binary search): " << mean_g << " s (dev " << dev_g << ")" << std::endl;
+	std::cout << "    get (Eytzinger mirror): " << mean_e << " s (dev " << dev_e << ")  speedup: " << mean_g / mean_e << std::endl;
+	std::cout << "    get_sparse_batch unsorted, 1 thread: " << mean_b << " s (dev " << dev_b << ")  speedup: " << mean_g / mean_b
+	          << "  " << max_threads << " threads: " << mean_bp << " s (dev " << dev_bp << ")  speedup: " << mean_g / mean_bp << std::endl;
+	std::cout << "    get_sparse_batch sorted, 1 thread: " << mean_bs << " s (dev " << dev_bs << ")  speedup: " << mean_g / mean_bs
+	          << "  " << max_threads << " threads: " << mean_bsp << " s (dev " << dev_bsp << ")  speedup: " << mean_g / mean_bsp << std::endl;
+
+	BOOST_REQUIRE_EQUAL(check_g,check_e);
+	BOOST_REQUIRE_EQUAL(check_g,check_b);
+	BOOST_REQUIRE_EQUAL(check_g,check_bs);
+	BOOST_REQUIRE_EQUAL(check_g,check_bp);
+	BOOST_REQUIRE_EQUAL(check_g,check_bsp);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_SPARSE_PERFORMANCE_TESTS_HPP_ */
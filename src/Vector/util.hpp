@@ -91,6 +91,22 @@ template<typename T>
 struct is_gpu_ker_celllist<T, typename Void<typename T::yes_is_gpu_ker_celllist>::type> : std::true_type
 {};
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \brief Check if the cell-list memory structure can be constructed in parallel on host
+ *
+ * The structure must implement construct_host(cell_ids), construct_host_count(cnt)
+ * and getCellPointer(cell)
+ *
+ */
+template<typename T, typename Sfinae = void>
+struct has_host_parallel_construct: std::false_type {};
+
+
+template<typename T>
+struct has_host_parallel_construct<T, typename Void<typename T::yes_has_host_parallel_construct>::type> : std::true_type
+{};
+
 // structure to check the device pointer
 
 /*! \brief this class is a functor for "for_each" algorithm
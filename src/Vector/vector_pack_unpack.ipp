@@ -366,3 +366,91 @@ template<int ... prp, typename MemType> inline void unpack(ExtPreAlloc<MemType>
 	}
 }
 
+
+/*! \brief Pack the vector as a list of segments without copying the data
+ *
+ * A header segment with the number of elements is appended to segs, followed by one segment for
+ * each selected property (one for each component of array properties) that point directly to the
+ * data of the vector. With memory_traits_lin the vector is a single segment and all the properties
+ * must be selected. The segments are valid until the vector is modified
+ *
+ * \tparam prp properties to pack (all if empty)
+ *
+ * \param segs list where the segments are appended
+ *
+ */
+template<int ... prp> void packSegments(Pack_segments & segs) const
+{
+	static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be packed in segments");
+
+	size_t n = this->size();
+	segs.addHeader(&n,1);
+
+	pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::add(*this,segs,n,base.size());
+}
+
+/*! \brief Resize the vector and append the segments where the packed data must be placed
+ *
+ * It is the receiving side of packSegments, the data segments of a packed vector (header excluded)
+ * can be received directly into the returned segments
+ *
+ * \tparam prp properties to unpack (all if empty)
+ *
+ * \param n number of elements (from the header)
+ * \param segs list where the destination segments are appended
+ *
+ */
+template<int ... prp> void placeSegments(size_t n, Pack_segments & segs)
+{
+	static_assert(has_pack_agg<T,prp...>::result::value == false,"properties with a pack() member cannot be unpacked from segments");
+
+	this->resize(n);
+
+	pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::add(*this,segs,n,base.size());
+}
+
+/*! \brief Check that a list of segments contains a vector packed with packSegments
+ *
+ * \tparam prp properties (all if empty)
+ *
+ * \param segs segments
+ * \param id segment where the vector start (its header)
+ *
+ * \return false if the segments do not match the vector
+ *
+ */
+template<int ... prp> static bool checkSegments(const Pack_segments & segs, size_t id)
+{
+	const size_t * hdr = pack_segments_header(segs,id,1);
+	if (hdr == NULL)
+	{return false;}
+
+	Pack_segments exp;
+	pack_segments_impl<is_layout_inte<layout_base<T>>::value,T,prp...>::expected(exp,hdr[0]);
+
+	return pack_segments_check(segs,id+1,exp);
+}
+
+/*! \brief Unpack a vector from a list of segments produced by packSegments
+ *
+ * \tparam prp properties to unpack (all if empty)
+ *
+ * \param segs segments
+ * \param id segment where the vector start (its header), at the end the segment after the vector
+ *
+ * \return false if the segments do not match the vector, in this case the vector is not modified
+ *
+ */
+template<int ... prp> bool unpackSegments(const Pack_segments & segs, size_t & id)
+{
+	if (checkSegments<prp...>(segs,id) == false)
+	{return false;}
+
+	size_t n = *(const size_t *)segs.getPointer(id);
+	id++;
+
+	Pack_segments dst;
+	placeSegments<prp...>(n,dst);
+
+	return pack_segments_copy(segs,id,dst);
+}
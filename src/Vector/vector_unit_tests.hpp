@@ -230,6 +230,125 @@ template <typename vector> void test_vector_remove_aggregate()
 	}
 }
 
+//! fill a vector with points where all the properties depend on the index
+template <typename vector> void fill_vector_remove_block(vector & v1, size_t n)
+{
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		v1.add();
+		v1.template get<0>(i) = i;
+		v1.template get<1>(i) = i + 1;
+		v1.template get<2>(i) = i + 2;
+		v1.template get<3>(i) = i + 3;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v1.template get<4>(i)[j] = i + 4 + j;
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{v1.template get<5>(i)[j][k] = i + 7 + 3*j + k;}
+		}
+	}
+}
+
+//! check that the element i of the vector is the original element id
+template <typename vector> void check_vector_remove_block(vector & v1, size_t i, size_t id)
+{
+	BOOST_REQUIRE_EQUAL(v1.template get<0>(i),id);
+	BOOST_REQUIRE_EQUAL(v1.template get<1>(i),id + 1);
+	BOOST_REQUIRE_EQUAL(v1.template get<2>(i),id + 2);
+	BOOST_REQUIRE_EQUAL(v1.template get<3>(i),id + 3);
+
+	for (size_t j = 0 ; j < 3 ; j++)
+	{
+		BOOST_REQUIRE_EQUAL(v1.template get<4>(i)[j],id + 4 + j);
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{BOOST_REQUIRE_EQUAL(v1.template get<5>(i)[j][k],id + 7 + 3*j + k);}
+	}
+}
+
+template <typename vector> void test_vector_remove_block()
+{
+	vector v1;
+	vector v2;
+
+	fill_vector_remove_block(v1,V_REM_PUSH);
+	fill_vector_remove_block(v2,V_REM_PUSH);
+
+	// remove runs of different length, the first and the last element
+	openfpm::vector<size_t> rem;
+	std::vector<size_t> kept;
+
+	size_t run = 1;
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		if (i == 0 || i == V_REM_PUSH - 1 || i % (run + 2) == 0)
+		{
+			rem.add(i);
+			run = (run % 7) + 1;
+		}
+		else
+		{kept.push_back(i);}
+	}
+
+	// ordered remove
+
+	v1.remove(rem);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),kept.size());
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{check_vector_remove_block(v1,i,kept[i]);}
+
+	// single remove
+
+	v1.remove(10);
+	kept.erase(kept.begin() + 10);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),kept.size());
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{check_vector_remove_block(v1,i,kept[i]);}
+
+	// unordered remove, the elements are the same but in different order
+
+	v2.remove_unordered(rem);
+
+	BOOST_REQUIRE_EQUAL(v2.size(),V_REM_PUSH - rem.size());
+
+	std::vector<size_t> ids;
+	for (size_t i = 0 ; i < v2.size() ; i++)
+	{
+		size_t id = v2.template get<0>(i);
+		check_vector_remove_block(v2,i,id);
+		ids.push_back(id);
+
+		// only the holes are filled, the other elements remain in place
+		if (std::binary_search(&rem.get(0),&rem.get(0) + rem.size(),i) == false)
+		{BOOST_REQUIRE_EQUAL(id,i);}
+	}
+
+	std::sort(ids.begin(),ids.end());
+
+	std::vector<size_t> kept2;
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		if (std::binary_search(&rem.get(0),&rem.get(0) + rem.size(),i) == false)
+		{kept2.push_back(i);}
+	}
+
+	BOOST_REQUIRE(ids == kept2);
+
+	// single unordered remove
+
+	size_t last = v2.template get<0>(v2.size()-1);
+	v2.remove_unordered(3);
+
+	BOOST_REQUIRE_EQUAL(v2.size(),kept2.size() - 1);
+	check_vector_remove_block(v2,3,last);
+}
+
 template <typename vector> void test_vector_insert()
 {
 	typedef Point_test<float> p;
@@ -526,6 +645,144 @@ BOOST_AUTO_TEST_CASE(vector_remove_aggregate )
 	test_vector_remove_aggregate< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
 }
 
+BOOST_AUTO_TEST_CASE(vector_remove_block_and_unordered )
+{
+	test_vector_remove_block<openfpm::vector<Point_test<float>>>();
+	test_vector_remove_block< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
+
+	// properties that cannot be moved with a memmove
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> v;
+
+	for (size_t i = 0 ; i < 64 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i).add(i);
+	}
+
+	openfpm::vector<size_t> rem;
+	for (size_t i = 0 ; i < 64 ; i += 3)
+	{rem.add(i);}
+
+	v.remove(rem);
+
+	BOOST_REQUIRE_EQUAL(v.size(),42ul);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v.template get<0>(i),(int)(i + i/2 + 1));
+		BOOST_REQUIRE_EQUAL(v.template get<1>(i).get(0),(int)(i + i/2 + 1));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(vector_merge_prp_parallel )
+{
+	typedef aggregate<double,double[3]> obj;
+
+	size_t n_dst = 40000;
+	size_t n_src = 100000;
+
+	openfpm::vector<obj> src;
+	openfpm::vector<size_t> opart;
+	openfpm::vector<size_t> opart_u;
+
+	for (size_t i = 0 ; i < n_src ; i++)
+	{
+		src.add();
+		src.template get<0>(i) = i;
+		src.template get<1>(i)[0] = i % 7;
+		src.template get<1>(i)[1] = i % 11;
+		src.template get<1>(i)[2] = i % 13;
+
+		// repeated indexes
+		opart.add((i * 7919) % n_dst);
+	}
+
+	// unique indexes
+	for (size_t i = 0 ; i < n_dst ; i++)
+	{opart_u.add((i * 7919) % n_dst);}
+
+	openfpm::vector<obj> src_u;
+	for (size_t i = 0 ; i < n_dst ; i++)
+	{src_u.add(src.get(i));}
+
+	auto init = [&](openfpm::vector<obj> & v)
+	{
+		v.resize(n_dst);
+		for (size_t i = 0 ; i < n_dst ; i++)
+		{
+			v.template get<0>(i) = 1.0;
+			v.template get<1>(i)[0] = 2.0;
+			v.template get<1>(i)[1] = 3.0;
+			v.template get<1>(i)[2] = 4.0;
+		}
+	};
+
+	auto check = [&](openfpm::vector<obj> & v1, openfpm::vector<obj> & v2)
+	{
+		BOOST_REQUIRE_EQUAL(v1.size(),v2.size());
+
+		for (size_t i = 0 ; i < v1.size() ; i++)
+		{
+			BOOST_REQUIRE_EQUAL(v1.template get<0>(i),v2.template get<0>(i));
+			BOOST_REQUIRE_EQUAL(v1.template get<1>(i)[0],v2.template get<1>(i)[0]);
+			BOOST_REQUIRE_EQUAL(v1.template get<1>(i)[1],v2.template get<1>(i)[1]);
+			BOOST_REQUIRE_EQUAL(v1.template get<1>(i)[2],v2.template get<1>(i)[2]);
+		}
+	};
+
+	openfpm::vector<obj> v_ref;
+	openfpm::vector<obj> v;
+
+	// repeated indexes, add and replace (the last source element must win)
+
+	init(v_ref);
+	init(v);
+	v_ref.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart);
+	v.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart,MERGE_PRP_SORT_REDUCE);
+	check(v_ref,v);
+
+	init(v_ref);
+	init(v);
+	v_ref.template merge_prp<replace_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart);
+	v.template merge_prp<replace_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src,opart,MERGE_PRP_SORT_REDUCE);
+	check(v_ref,v);
+
+	// unique indexes
+
+	init(v_ref);
+	init(v);
+	v_ref.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src_u,opart_u);
+	v.template merge_prp<add_,obj,HeapMemory,typename openfpm::grow_policy_double,0,1>(src_u,opart_u,MERGE_PRP_UNIQUE);
+	check(v_ref,v);
+
+	// contiguous merge
+
+	init(v);
+	v.template merge_prp_v<add_,obj,HeapMemory,typename openfpm::grow_policy_double,memory_traits_lin,0,1>(src_u,0);
+
+	for (size_t i = 0 ; i < n_dst ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v.template get<0>(i),1.0 + i);
+		BOOST_REQUIRE_EQUAL(v.template get<1>(i)[2],4.0 + i % 13);
+	}
+
+	// add_prp
+
+	openfpm::vector<obj> va;
+	init(va);
+	va.template add_prp<obj,HeapMemory,typename openfpm::grow_policy_double,OPENFPM_NATIVE,memory_traits_lin,0,1>(src);
+
+	BOOST_REQUIRE_EQUAL(va.size(),n_dst + n_src);
+
+	for (size_t i = 0 ; i < n_src ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(va.template get<0>(n_dst + i),src.template get<0>(i));
+		BOOST_REQUIRE_EQUAL(va.template get<1>(n_dst + i)[1],src.template get<1>(i)[1]);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(vector_insert )
 {
 	test_vector_insert<openfpm::vector<Point_test<float>>>();
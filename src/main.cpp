@@ -27,6 +27,7 @@
 #include "Point_test_unit_tests.hpp"
 #include "util/test/util_test.hpp"
 #include "Space/Shape/Box_unit_tests.hpp"
+#include "Space/Shape/BoxIndex_unit_tests.hpp"
 #include "NN/CellList/CellList_test.hpp"
 #include "Vector/vector_unit_tests.hpp"
 #include "Space/Shape/HyperCube_unit_test.hpp"
@@ -615,6 +615,26 @@ public:
 		return *this;
 	}
 
+	/*! \brief Assignment from an element with AoSoA layout
+	 *
+	 * \param ec object encapsulated to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	template<unsigned int W>
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const encapc<dim,T,memory_aosoa<T,W>> & ec)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_cpu_encap_encap_general<encapc<dim,T,memory_aosoa<T,W>>,encapc<dim,T,Mem>> cp(ec,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
 	/*! \brief Assignment
 	 *
 	 * \param obj object to copy
@@ -900,6 +920,193 @@ public:
 	}
 };
 
+/*! \brief this structure encapsulate an object of a grid with AoSoA layout
+ *
+ * Like the memory_traits_inte case it store a reference to the memory and the
+ * element id
+ *
+ * \see memory_traits_aosoa
+ *
+ *	\param dim Dimensionality of the grid
+ *	\param T type of object the grid store
+ *	\param W number of elements in a tile
+ *
+ */
+template<unsigned int dim,typename T, unsigned int W>
+class encapc<dim,T,memory_aosoa<T,W>>
+{
+	//! type of layout
+	typedef memory_aosoa<T,W> Mem;
+
+	//! layout of the encapsulated object
+	typedef typename memory_traits_lin<T>::type Mem2;
+
+	//! reference to the encapsulated object
+	Mem & data;
+
+	//! element id
+	size_t k;
+
+#ifdef SE_CLASS1
+	bool init = false;
+#endif
+
+#ifdef SE_CLASS1
+	__device__ __host__ void check_init() const
+	{
+		if (init == false)
+		{
+			#ifdef CUDA_ON_CPU
+			std::cout << __FILE__ << ":" << __LINE__ << " Error using unallocated pointer" << std::endl;
+			#else
+			assert(init == true);
+			#endif
+		}
+	}
+#endif
+
+public:
+
+	//! Original list if types
+	typedef typename T::type type;
+
+	//! indicate it is an encapsulated object
+	typedef int yes_i_am_encap;
+
+	//! original object type
+	typedef T T_type;
+
+	//! number of properties
+	static const int max_prop = T::max_prop;
+
+#ifdef SE_CLASS1
+	__device__ __host__ ~encapc()
+	{init = false;}
+#endif
+
+	//! constructor require a key and a memory data
+	__device__ __host__ encapc(Mem & data, size_t k)
+	:data(data),k(k)
+	{
+#ifdef SE_CLASS1
+		init = true;
+#endif
+	}
+
+	//! copy constructor
+	__device__ __host__ encapc(const encapc<dim,T,Mem> & ec)
+	:data(ec.data), k(ec.k)
+	{
+#ifdef SE_CLASS1
+		init = true;
+#endif
+	}
+
+	/*! \brief Access the data
+	 *
+	 * \tparam p property selected
+	 *
+	 * \return The reference of the data
+	 *
+	 */
+	template <unsigned int p>
+	__device__ __host__ auto get() -> decltype(data.template get<p>(k))
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return data.template get<p>(k);
+	}
+
+	/*! \brief Access the data
+	 *
+	 * \tparam p property selected
+	 *
+	 * \return The reference of the data
+	 *
+	 */
+	template <unsigned int p> __device__ __host__ auto get() const -> decltype(data.template get<p>(k))
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return data.template get<p>(k);
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param ec encapsulator
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const encapc<dim,T,Mem> & ec)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_cpu_encap_single<encapc<dim,T,Mem>> cp(ec,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param ec encapsulator
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const encapc<dim,T,Mem2> & ec)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_cpu_encap_encap_general<encapc<dim,T,Mem2>,encapc<dim,T,Mem>> cp(ec,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param obj object to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const T & obj)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_fusion_vector_encap<typename T::type,decltype(*this)> cp(obj.data,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	__device__ __host__ inline Mem & private_get_data()
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return data;
+	}
+
+	__device__ __host__ inline size_t private_get_k()
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return k;
+	}
+};
+
 #include "util/common.hpp"
 
 template<typename T, typename Sfinae = void>
@@ -950,4 +1157,19 @@ struct mem_geto<dim,T,layout,data_type,g1_type,key_type,1>
 	}
 };
 
+//! Case memory_traits_aosoa
+template<unsigned int dim, typename T,typename layout, unsigned int W, typename g1_type, typename key_type>
+struct mem_geto<dim,T,layout,memory_aosoa<T,W>,g1_type,key_type,0>
+{
+	__device__ __host__ static inline encapc<dim,T,memory_aosoa<T,W>> get(memory_aosoa<T,W> & data_, const g1_type & g1, const key_type & v1)
+	{
+		return encapc<dim,T,memory_aosoa<T,W>>(data_,g1.LinId(v1));
+	}
+
+	static inline encapc<dim,T,memory_aosoa<T,W>> get_lin(memory_aosoa<T,W> & data_, const size_t & v1)
+	{
+		return encapc<dim,T,memory_aosoa<T,W>>(data_,v1);
+	}
+};
+
 #endif /* ENCAP_HPP_ */
@@ -0,0 +1,571 @@
+/*
+ * PoolMemory.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_POOLMEMORY_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_POOLMEMORY_HPP_
+
+#include "memory/memory.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+//! Alignment of the buffers allocated by PoolMemory
+#define POOL_MEMORY_ALIGNMENT 64
+
+//! Smallest size class (2^POOL_MEMORY_MIN_CLASS bytes)
+#define POOL_MEMORY_MIN_CLASS 6
+
+//! Biggest size class (2^POOL_MEMORY_MAX_CLASS bytes), bigger buffers are not cached
+#define POOL_MEMORY_MAX_CLASS 28
+
+//! Maximum number of bytes cached by the pool of a thread
+#ifndef POOL_MEMORY_MAX_CACHED
+#define POOL_MEMORY_MAX_CACHED ((size_t)1 << 30)
+#endif
+
+/*! \brief Counters of a memory pool
+ *
+ */
+struct pool_memory_stats
+{
+	//! number of buffers requested to the pool
+	size_t n_alloc = 0;
+
+	//! number of buffers served from the free lists
+	size_t n_reuse = 0;
+
+	//! number of buffers allocated with malloc
+	size_t n_malloc = 0;
+
+	//! number of buffers released with free
+	size_t n_free = 0;
+
+	//! bytes currently cached in the free lists
+	size_t cached = 0;
+};
+
+/*! \brief Size-class pool of a thread
+ *
+ * The buffers are grouped in classes of power of two sizes, a released buffer is
+ * kept in the free list of its class and reused by the next request of the same class
+ *
+ */
+class pool_memory_cache
+{
+	//! free lists, one for each class
+	std::vector<unsigned char *> free_list[POOL_MEMORY_MAX_CLASS+1];
+
+	//! counters
+	pool_memory_stats stats;
+
+	//! false when the thread is terminating and the pool has been destroyed
+	bool is_alive = true;
+
+	/*! \brief Allocate an aligned buffer with malloc
+	 *
+	 * \param sz size of the buffer
+	 *
+	 * \return the buffer
+	 *
+	 */
+	static unsigned char * malloc_aligned(size_t sz)
+	{
+		void * ptr = NULL;
+
+		if (posix_memalign(&ptr,POOL_MEMORY_ALIGNMENT,sz) != 0)	{return NULL;}
+
+		return static_cast<unsigned char *>(ptr);
+	}
+
+public:
+
+	/*! \brief Return the class of a buffer of size sz
+	 *
+	 * \param sz size
+	 *
+	 * \return the class (POOL_MEMORY_MAX_CLASS+1 if the buffer is too big to be cached)
+	 *
+	 */
+	static size_t size_class(size_t sz)
+	{
+		size_t c = POOL_MEMORY_MIN_CLASS;
+		while (c <= POOL_MEMORY_MAX_CLASS && ((size_t)1 << c) < sz)	{c++;}
+
+		return c;
+	}
+
+	/*! \brief Get a buffer of at least sz bytes
+	 *
+	 * \param sz size requested
+	 * \param cap output effective size of the buffer
+	 *
+	 * \return the buffer
+	 *
+	 */
+	unsigned char * get(size_t sz, size_t & cap)
+	{
+		stats.n_alloc++;
+
+		size_t c = size_class(sz);
+
+		if (c > POOL_MEMORY_MAX_CLASS)
+		{
+			stats.n_malloc++;
+			cap = sz;
+			return malloc_aligned(sz);
+		}
+
+		cap = (size_t)1 << c;
+
+		if (free_list[c].size() != 0)
+		{
+			unsigned char * ptr = free_list[c].back();
+			free_list[c].pop_back();
+
+			stats.n_reuse++;
+			stats.cached -= cap;
+
+			return ptr;
+		}
+
+		stats.n_malloc++;
+		return malloc_aligned(cap);
+	}
+
+	/*! \brief Release a buffer
+	 *
+	 * \param ptr buffer
+	 * \param cap effective size of the buffer (as returned by get)
+	 *
+	 */
+	void put(unsigned char * ptr, size_t cap)
+	{
+		if (ptr == NULL)	{return;}
+
+		size_t c = size_class(cap);
+
+		// buffers released after the destruction of the pool (static objects) are freed
+		if (c > POOL_MEMORY_MAX_CLASS || stats.cached + cap > POOL_MEMORY_MAX_CACHED || is_alive == false)
+		{
+			stats.n_free++;
+			free(ptr);
+			return;
+		}
+
+		free_list[c].push_back(ptr);
+		stats.cached += cap;
+	}
+
+	/*! \brief Release all the cached buffers
+	 *
+	 */
+	void release()
+	{
+		for (size_t c = 0 ; c <= POOL_MEMORY_MAX_CLASS ; c++)
+		{
+			for (size_t i = 0 ; i < free_list[c].size() ; i++)
+			{free(free_list[c][i]);}
+
+			stats.n_free += free_list[c].size();
+			free_list[c].clear();
+			free_list[c].shrink_to_fit();
+		}
+
+		stats.cached = 0;
+	}
+
+	//! Return the counters
+	pool_memory_stats & getStats()
+	{
+		return stats;
+	}
+
+	//! destructor
+	~pool_memory_cache()
+	{
+		release();
+		is_alive = false;
+	}
+};
+
+/*! \brief Memory allocated from a per-thread pool of buffers
+ *
+ * It can be used in place of HeapMemory in openfpm::vector and grid_base. When
+ * the memory is destroyed (or grow) the old buffer is not freed but returned to
+ * the pool of the thread, short lived temporary buffers reuse them avoiding malloc
+ * and free. Buffers are rounded to power of two sizes, so a resize that stay in the
+ * same size class does not reallocate.
+ *
+ * The buffers released by a thread go to the pool of that thread, the pool can
+ * be emptied with PoolMemory::release_pool()
+ *
+ * ### Example
+ *
+ * \code
+ * openfpm::vector<aggregate<double,size_t>,PoolMemory> tmp;
+ * \endcode
+ *
+ */
+class PoolMemory : public memory
+{
+	//! Size of the memory
+	size_t sz;
+
+	//! Effective size of the buffer
+	size_t cap;
+
+	//! device memory
+	unsigned char * dm;
+
+	//! Reference counter
+	long int ref_cnt;
+
+	/*! \brief Return the pool of the calling thread
+	 *
+	 * \return the pool
+	 *
+	 */
+	static pool_memory_cache & pool()
+	{
+		static thread_local pool_memory_cache pc;
+
+		return pc;
+	}
+
+public:
+
+	/*! \brief allocate memory
+	 *
+	 * \param sz size of memory
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		if (dm != NULL)
+		{
+			if (sz != 0)
+			{std::cerr << __FILE__ << ":" << __LINE__ << " error memory already allocated" << std::endl;}
+
+			return false;
+		}
+
+		dm = pool().get(sz,cap);
+		this->sz = sz;
+
+		if (dm == NULL && sz != 0)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error allocating " << sz << " bytes" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	//! destroy the memory, the buffer is returned to the pool
+	virtual void destroy()
+	{
+		pool().put(dm,cap);
+
+		dm = NULL;
+		sz = 0;
+		cap = 0;
+	}
+
+	/*! \brief copy the data from a pointer
+	 *
+	 * \param m memory from where to copy
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the source memory is bigger than the destination" << std::endl;
+			return false;
+		}
+
+		memcpy(dm,m.getPointer(),m.size());
+
+		return true;
+	}
+
+	/*! \brief the the size of the allocated memory
+	 *
+	 * \return the size of the allocated memory
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief resize the memory allocated
+	 *
+	 * The memory is never shrink, if the new size fit into the buffer no reallocation is done
+	 *
+	 * \param sz size
+	 *
+	 * \return true if success
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)	{return true;}
+
+		if (sz <= cap && dm != NULL)
+		{
+			this->sz = sz;
+			return true;
+		}
+
+		unsigned char * dm_old = dm;
+		size_t sz_old = this->sz;
+		size_t cap_old = cap;
+
+		dm = NULL;
+
+		if (allocate(sz) == false)
+		{
+			// keep the old buffer
+			dm = dm_old;
+			this->sz = sz_old;
+			cap = cap_old;
+
+			return false;
+		}
+
+		if (dm_old != NULL)
+		{
+			memcpy(dm,dm_old,sz_old);
+			pool().put(dm_old,cap_old);
+		}
+
+		return true;
+	}
+
+	/*! \brief Return a readable pointer with your data
+	 *
+	 * \return a readable pointer with your data
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return dm;
+	}
+
+	/*! \brief Return a readable pointer with your data
+	 *
+	 * \return a readable pointer with your data
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return dm;
+	}
+
+	/*! \brief Return the pointer of the device (the same of the host)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return dm;
+	}
+
+	/*! \brief Return the pointer of the device (the same of the host)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getDevicePointerNoCopy()
+	{
+		return dm;
+	}
+
+	//! Do nothing
+	virtual void deviceToHost() {};
+
+	//! Do nothing
+	virtual void deviceToHost(size_t start, size_t stop) {};
+
+	//! Do nothing
+	virtual void hostToDevice() {};
+
+	//! Do nothing
+	virtual void hostToDevice(size_t start, size_t stop) {};
+
+	//! Do nothing
+	void deviceToHost(PoolMemory & mem) {};
+
+	//! Do nothing
+	void hostToDevice(PoolMemory & mem) {};
+
+	/*! \brief fill memory with the selected byte
+	 *
+	 * \param c byte to fill
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		memset(dm,c,sz);
+	}
+
+	//! Increment the reference counter
+	virtual void incRef()
+	{ref_cnt++;}
+
+	//! Decrement the reference counter
+	virtual void decRef()
+	{ref_cnt--;}
+
+	/*! \brief Return the reference counter
+	 *
+	 * \return the reference counter
+	 *
+	 */
+	virtual long int ref()
+	{
+		return ref_cnt;
+	}
+
+	/*! \brief A buffer from the pool is not initialized
+	 *
+	 * \return false
+	 *
+	 */
+	virtual bool isInitialized()
+	{
+		return false;
+	}
+
+	/*! \brief Device and host memory are the same
+	 *
+	 * \return true
+	 *
+	 */
+	static constexpr bool isDeviceHostSame()
+	{
+		return true;
+	}
+
+	/*! \brief Swap the memory
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	void swap(PoolMemory & mem)
+	{
+		std::swap(sz,mem.sz);
+		std::swap(cap,mem.cap);
+		std::swap(dm,mem.dm);
+		std::swap(ref_cnt,mem.ref_cnt);
+	}
+
+	/*! \brief Swap with a different kind of memory is not possible
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	template<typename Mem> void swap(Mem & mem)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error PoolMemory can be swapped only with PoolMemory" << std::endl;
+	}
+
+	/*! \brief copy memory
+	 *
+	 * \param mem memory to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	PoolMemory & operator=(const PoolMemory & mem)
+	{
+		resize(mem.size());
+		copy(mem);
+
+		return *this;
+	}
+
+	/*! \brief move memory
+	 *
+	 * \param mem memory to move
+	 *
+	 * \return itself
+	 *
+	 */
+	PoolMemory & operator=(PoolMemory && mem)
+	{
+		swap(mem);
+
+		return *this;
+	}
+
+	//! Constructor
+	PoolMemory()
+	:sz(0),cap(0),dm(NULL),ref_cnt(0)
+	{}
+
+	/*! \brief copy constructor
+	 *
+	 * \param mem memory to copy
+	 *
+	 */
+	PoolMemory(const PoolMemory & mem)
+	:PoolMemory()
+	{
+		allocate(mem.size());
+		copy(mem);
+	}
+
+	/*! \brief move constructor
+	 *
+	 * \param mem memory to move
+	 *
+	 */
+	PoolMemory(PoolMemory && mem) noexcept
+	:PoolMemory()
+	{
+		swap(mem);
+	}
+
+	//! Destructor
+	~PoolMemory() noexcept
+	{
+		if(ref_cnt == 0)
+		{destroy();}
+		else
+		{std::cerr << __FILE__ << ":" << __LINE__ << " error destroying a live object" << std::endl;}
+	}
+
+	/*! \brief Release all the buffers cached by the pool of the calling thread
+	 *
+	 */
+	static void release_pool()
+	{
+		pool().release();
+	}
+
+	/*! \brief Return the counters of the pool of the calling thread
+	 *
+	 * \return the counters
+	 *
+	 */
+	static pool_memory_stats & pool_stats()
+	{
+		return pool().getStats();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_POOLMEMORY_HPP_ */
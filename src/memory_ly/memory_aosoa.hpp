@@ -0,0 +1,476 @@
+/*
+ * memory_aosoa.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_AOSOA_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_AOSOA_HPP_
+
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/range_c.hpp>
+#include <boost/fusion/include/mpl.hpp>
+#include "memory_array.hpp"
+#include "util/for_each_ref.hpp"
+#include "util/common.hpp"
+
+constexpr int AOSOA_layout = 3;
+
+/*! \brief Offset of the property p inside one packed object of the AoSoA layout
+ *
+ * Properties are packed in order, each one aligned to its own alignment
+ *
+ * \tparam T aggregate
+ * \tparam p property
+ *
+ */
+template<typename T, int p>
+struct aosoa_prp_offset
+{
+	//! type of the previous property
+	typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<p-1>>::type prev_type;
+
+	//! type of the property
+	typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type prp_type;
+
+	//! end of the previous property
+	static const size_t end = aosoa_prp_offset<T,p-1>::value + sizeof(prev_type);
+
+	//! offset of the property
+	static const size_t value = (end + alignof(prp_type) - 1) / alignof(prp_type) * alignof(prp_type);
+};
+
+template<typename T>
+struct aosoa_prp_offset<T,0>
+{
+	static const size_t value = 0;
+};
+
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * It value-initialize the property T::value of a range of elements
+ *
+ * \tparam mem_type memory_aosoa
+ *
+ */
+template<typename mem_type>
+struct aosoa_init_prp
+{
+	//! memory to initialize
+	mem_type & mem;
+
+	//! first element
+	size_t start;
+
+	//! last element (excluded)
+	size_t stop;
+
+	//! constructor
+	aosoa_init_prp(mem_type & mem, size_t start, size_t stop)
+	:mem(mem),start(start),stop(stop)
+	{};
+
+	//! It initialize the property T::value
+	template<typename T>
+	inline void operator()(T& t) const
+	{
+		typedef typename mem_type::template prp_type<T::value>::type prp;
+
+		for (size_t i = start ; i < stop ; i++)
+		{new (&mem.template get<T::value>(i)) prp();}
+	}
+};
+
+/*! \brief Container for the memory of an AoSoA (array of structures of arrays) layout
+ *
+ * The elements are stored in tiles of W elements, inside a tile the properties
+ * are stored one after the other and each property is an array of W values.
+ * Element i property p is at
+ *
+ * tile(i/W) + W*aosoa_prp_offset<T,p> + (i%W)*sizeof(prp_p)
+ *
+ * A kernel that walk the elements in order read W contiguous values of the same
+ * property (like SoA), while all the properties of an element are at most one
+ * tile apart (like AoS)
+ *
+ * It has the same interface of memory_c (setMemory, allocate, swap ...), the properties
+ * are accessed with get<p>(i)
+ *
+ * \see memory_traits_aosoa
+ *
+ * \tparam T aggregate
+ * \tparam W number of elements in a tile (power of two)
+ *
+ */
+template<typename T, unsigned int W>
+class memory_aosoa
+{
+	static_assert(W != 0 && (W & (W - 1)) == 0,"the tile width W of memory_aosoa must be a power of two");
+
+	//! indicate this object manage the memory (see memory_c)
+	bool manage_memory = true;
+
+	//! last property
+	static const int last = T::max_prop - 1;
+
+	//! type of the last property
+	typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<last>>::type last_type;
+
+	//! size of one packed object
+	static const size_t obj_raw = aosoa_prp_offset<T,last>::value + sizeof(last_type);
+
+public:
+
+	//! type of the property p
+	template<unsigned int p>
+	struct prp_type
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type type;
+	};
+
+	//! define itself
+	typedef memory_aosoa<T,W> type;
+
+	//! number of elements in a tile
+	static const unsigned int tile_width = W;
+
+	//! size in byte of one packed object, the tiles stay aligned like T::type
+	static const size_t obj_size = (obj_raw + alignof(typename T::type) - 1) / alignof(typename T::type) * alignof(typename T::type);
+
+	//! size in byte of one tile
+	static const size_t tile_size = W*obj_size;
+
+	//! object that allocate memory like HeapMemory or CudaMemory
+	memory * mem;
+
+	//! the memory as an array of bytes
+	memory_array<unsigned char> mem_r;
+
+	/*! \brief number of elements to allocate to contain sz elements
+	 *
+	 * \param sz number of elements
+	 *
+	 * \return sz rounded to a multiple of the tile width
+	 *
+	 */
+	static inline size_t n_alloc(size_t sz)
+	{
+		return (sz + W - 1) / W * W;
+	}
+
+	/*! \brief This function set the object that allocate memory
+	 *
+	 * \param mem the memory object
+	 *
+	 */
+	void setMemory(memory & mem)
+	{
+		if (manage_memory)
+		{
+			if (this->mem != NULL)
+			{
+				this->mem->decRef();
+
+				if (this->mem->ref() == 0 && &mem != this->mem)
+					delete(this->mem);
+			}
+			mem.incRef();
+		}
+		this->mem = &mem;
+	}
+
+	/*! \brief This function bind the memory_aosoa to this memory_aosoa as reference
+	 *
+	 * \param ref memory to reference
+	 *
+	 * \return true
+	 *
+	 */
+	bool bind_ref(const memory_aosoa<T,W> & ref)
+	{
+		mem = ref.mem;
+
+		if (manage_memory)
+		{mem->incRef();}
+
+		mem_r = ref.mem_r;
+
+		return true;
+	}
+
+	/*! \brief This function get the object that allocate memory
+	 *
+	 * \return memory object to allocate memory
+	 *
+	 */
+	memory& getMemory()
+	{
+		return *this->mem;
+	}
+
+	/*! \brief This function get the object that allocate memory
+	 *
+	 * \return memory object to allocate memory
+	 *
+	 */
+	const memory& getMemory() const
+	{
+		return *this->mem;
+	}
+
+	/*! \brief This function allocate memory for sz elements
+	 *
+	 * The allocation is rounded to full tiles
+	 *
+	 * \param sz number of elements
+	 * \param skip_initialization does not initialize the elements
+	 *
+	 * \return true
+	 *
+	 */
+	bool allocate(const size_t sz, bool skip_initialization = false)
+	{
+		memory * mem = this->mem;
+
+		size_t n_tile = n_alloc(sz) / W;
+
+		//! We create a chunk of memory
+		mem->resize( n_tile*tile_size );
+
+		mem_r.initialize(mem->getPointer(),n_tile*tile_size,true);
+
+		if ((mem->isInitialized() | skip_initialization) == false)
+		{
+			aosoa_init_prp<memory_aosoa<T,W>> ini(*this,0,n_tile*W);
+
+			boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(ini);
+		}
+
+		return true;
+	}
+
+	//! constructor
+	memory_aosoa(bool manage_memory = true)
+	:manage_memory(manage_memory),mem(NULL){}
+
+	//! destructor
+	~memory_aosoa()
+	{
+		if (manage_memory)
+		{
+			if (mem != NULL)
+			{
+				mem->decRef();
+
+				if (mem->ref() == 0)
+					delete(mem);
+			}
+		}
+	}
+
+	/*! \brief Disable the management of memory (it is used for toKernel views)
+	 *
+	 */
+	void disable_manage_memory()
+	{
+		manage_memory = false;
+	}
+
+	/*! \brief swap the memory
+	 *
+	 * \param mem_obj memory to swap with
+	 *
+	 */
+	void swap(memory_aosoa & mem_obj)
+	{
+		memory * mem_tmp = mem;
+		mem = mem_obj.mem;
+		mem_obj.mem = mem_tmp;
+
+		mem_obj.mem_r.swap(mem_r);
+	}
+
+	/*! \brief swap the memory
+	 *
+	 * swap the content of the memory objects
+	 *
+	 * \param mem_obj memory to swap with
+	 *
+	 */
+	template<typename Mem_type>
+	__host__ void swap_nomode(memory_aosoa & mem_obj)
+	{
+		Mem_type * mem_tmp = static_cast<Mem_type*>(mem);
+		mem_tmp->swap(*static_cast<Mem_type*>(mem_obj.mem));
+
+		mem_obj.mem_r.swap(mem_r);
+	}
+
+	/*! \brief Get the property p of the element i
+	 *
+	 * \tparam p property
+	 *
+	 * \param i element
+	 *
+	 * \return a reference to the property
+	 *
+	 */
+	template<unsigned int p>
+	__device__ __host__ inline typename prp_type<p>::type & get(size_t i) const
+	{
+		unsigned char * ptr = static_cast<unsigned char *>(mem_r.get_pointer())
+				            + (i / W)*tile_size
+				            + W*aosoa_prp_offset<T,p>::value
+				            + (i % W)*sizeof(typename prp_type<p>::type);
+
+		return *reinterpret_cast<typename prp_type<p>::type *>(ptr);
+	}
+};
+
+template<typename T, unsigned int W> const unsigned int memory_aosoa<T,W>::tile_width;
+template<typename T, unsigned int W> const size_t memory_aosoa<T,W>::obj_size;
+template<typename T, unsigned int W> const size_t memory_aosoa<T,W>::tile_size;
+
+/*! \brief Transform the aggregate into the AoSoA memory specification (memory_traits)
+ *
+ * Hybrid between memory_traits_lin and memory_traits_inte, the elements are
+ * stored in tiles of W elements, and inside a tile each property is stored
+ * as an array of W values (see memory_aosoa)
+ *
+ * Differently from memory_traits_lin and memory_traits_inte the tile width is a
+ * parameter, so the layout meta-function is the nested template layout
+ *
+ * ### Use an AoSoA layout with tiles of 8 elements
+ * \snippet memory_conf_unit_tests.cpp AoSoA layout
+ *
+ * \tparam W number of elements in a tile (power of two)
+ *
+ */
+template<unsigned int W>
+struct memory_traits_aosoa
+{
+	/*! \brief memory_traits of the AoSoA layout
+	 *
+	 * \tparam T base type (T::type must define a boost::fusion::vector )
+	 *
+	 */
+	template<typename T>
+	struct layout
+	{
+		//! tiles of W elements
+		typedef memory_aosoa<T,W> type;
+
+		//! indicate that it is an AoSoA layout
+		typedef int yes_is_aosoa;
+
+		typedef boost::mpl::int_<AOSOA_layout> type_value;
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param v1 element id
+		 *
+		 * \return a reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type, typename key_type>
+		__host__ __device__ static inline auto get(data_type & data_, const g1_type & g1, const key_type & v1) -> decltype(data_.template get<p>(g1.LinId(v1)))
+		{
+			return data_.template get<p>(g1.LinId(v1));
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param lin_id element id
+		 *
+		 * \return a reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type>
+		__host__ __device__ static inline auto get_lin(data_type & data_, const g1_type & g1, size_t lin_id) -> decltype(data_.template get<p>(lin_id))
+		{
+			return data_.template get<p>(lin_id);
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param v1 element id
+		 *
+		 * \return a const reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type, typename key_type>
+		__host__ __device__ static inline auto get_c(const data_type & data_, const g1_type & g1, const key_type & v1) -> const typename data_type::template prp_type<p>::type &
+		{
+			return data_.template get<p>(g1.LinId(v1));
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param lin_id element id
+		 *
+		 * \return a const reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type>
+		__host__ __device__ static inline auto get_lin_c(const data_type & data_, const g1_type & g1, size_t lin_id) -> const typename data_type::template prp_type<p>::type &
+		{
+			return data_.template get<p>(lin_id);
+		}
+
+		/*! \brief Copy the memory from host to device
+		 *
+		 * The tiles that contain the elements are copied
+		 *
+		 * \tparam (all properties are copied to prp is useless in this case)
+		 *
+		 * \param start start point
+		 * \param stop stop point
+		 *
+		 */
+		template<typename S, typename data_type, unsigned int ... prp>
+		static void hostToDevice(data_type & data_, size_t start, size_t stop)
+		{
+			data_.mem->hostToDevice(start / W * data_type::tile_size,(stop / W + 1) * data_type::tile_size);
+		}
+
+		/*! \brief Synchronize the memory buffer in the device with the memory in the host
+		 *
+		 * The tiles that contain the elements are copied
+		 *
+		 * \param start starting element to transfer
+		 * \param stop stop element to transfer
+		 *
+		 * \tparam properties to transfer (ignored all properties are trasfert)
+		 *
+		 */
+		template<typename data_type, unsigned int ... prp>
+		static void deviceToHost(data_type & data_, size_t start, size_t stop)
+		{
+			data_.mem->deviceToHost(start / W * data_type::tile_size,(stop / W + 1) * data_type::tile_size);
+		}
+	};
+};
+
+template<typename T, typename Sfinae = void>
+struct is_layout_aosoa: std::false_type {};
+
+
+/*! \brief is_layout_aosoa
+ *
+ * return true if T is a memory_traits_aosoa<W>::layout
+ *
+ */
+template<typename T>
+struct is_layout_aosoa<T, typename Void< typename T::yes_is_aosoa>::type> : std::true_type
+{};
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_AOSOA_HPP_ */
@@ -14,6 +14,7 @@
 #include "Vector/util.hpp"
 #include "util/tokernel_transformation.hpp"
 #include "util/hostDevice_util_funcs.hpp"
+#include "memory_aosoa.hpp"
 
 constexpr int SOA_layout_IA = 2;
 constexpr int SOA_layout = 1;
@@ -2,6 +2,7 @@
 #include <boost/test/unit_test.hpp>
 #include "memory_ly/memory_conf.hpp"
 #include "Vector/map_vector.hpp"
+#include "memory_ly/PoolMemory.hpp"
 
 BOOST_AUTO_TEST_SUITE( memory_conf_test )
 
@@ -25,4 +26,194 @@ BOOST_AUTO_TEST_CASE( memory_conf_use )
 	BOOST_REQUIRE_EQUAL(test,true);
 }
 
+BOOST_AUTO_TEST_CASE( pool_memory_use )
+{
+	PoolMemory::release_pool();
+	pool_memory_stats & stats = PoolMemory::pool_stats();
+
+	size_t n_malloc = stats.n_malloc;
+
+	// vector and grid with pool memory and both layouts
+
+	for (size_t k = 0 ; k < 16 ; k++)
+	{
+		openfpm::vector<aggregate<double,float[3]>,PoolMemory> v;
+		openfpm::vector<aggregate<double,float[3]>,PoolMemory,memory_traits_inte> vi;
+
+		for (size_t i = 0 ; i < 1000 ; i++)
+		{
+			v.add();
+			v.template get<0>(i) = i;
+			v.template get<1>(i)[2] = i + 2;
+
+			vi.add();
+			vi.template get<0>(i) = i;
+			vi.template get<1>(i)[2] = i + 2;
+		}
+
+		openfpm::vector<aggregate<double,float[3]>,PoolMemory> v2 = v;
+		v.resize(10);
+
+		size_t sz[2] = {32,32};
+		grid_base<2,aggregate<double>,PoolMemory> g(sz);
+		g.setMemory();
+		g.template get<0>(grid_key_dx<2>({3,4})) = 7.0;
+
+		for (size_t i = 0 ; i < 1000 ; i++)
+		{
+			BOOST_REQUIRE_EQUAL(v2.template get<0>(i),i);
+			BOOST_REQUIRE_EQUAL(v2.template get<1>(i)[2],i + 2);
+			BOOST_REQUIRE_EQUAL(vi.template get<0>(i),i);
+			BOOST_REQUIRE_EQUAL(vi.template get<1>(i)[2],i + 2);
+		}
+
+		BOOST_REQUIRE_EQUAL(g.template get<0>(grid_key_dx<2>({3,4})),7.0);
+
+		// the buffers are aligned
+		BOOST_REQUIRE_EQUAL((size_t)v.getPointer() % POOL_MEMORY_ALIGNMENT,0ul);
+	}
+
+	// after the first iteration all the buffers come from the pool
+	size_t n_malloc_first = stats.n_malloc - n_malloc;
+	BOOST_REQUIRE(stats.n_reuse > 0);
+	BOOST_REQUIRE(n_malloc_first < 16 * 10);
+
+	size_t n_malloc_2 = stats.n_malloc;
+
+	{
+		openfpm::vector<aggregate<double,float[3]>,PoolMemory> v;
+		v.resize(1000);
+	}
+
+	{
+		openfpm::vector<aggregate<double,float[3]>,PoolMemory> v;
+		v.resize(1000);
+	}
+
+	BOOST_REQUIRE_EQUAL(stats.n_malloc,n_malloc_2);
+
+	// a failed resize keep the old buffer
+
+	{
+		PoolMemory m;
+		m.allocate(100);
+		memset(m.getPointer(),7,100);
+
+		void * ptr = m.getPointer();
+
+		BOOST_REQUIRE_EQUAL(m.resize((size_t)1 << 62),false);
+		BOOST_REQUIRE_EQUAL(m.getPointer(),ptr);
+		BOOST_REQUIRE_EQUAL(m.size(),100ul);
+		BOOST_REQUIRE_EQUAL(((unsigned char *)m.getPointer())[99],7);
+
+		BOOST_REQUIRE_EQUAL(m.resize(5000),true);
+		BOOST_REQUIRE_EQUAL(((unsigned char *)m.getPointer())[99],7);
+	}
+
+	// bulk release
+
+	BOOST_REQUIRE(stats.cached != 0);
+	PoolMemory::release_pool();
+	BOOST_REQUIRE_EQUAL(stats.cached,0ul);
+}
+
+BOOST_AUTO_TEST_CASE( memory_aosoa_use )
+{
+	typedef aggregate<float,double,float[3],char> part;
+
+	//! [AoSoA layout]
+
+	// vector of particles stored in tiles of 8 particles
+	openfpm::vector<part,HeapMemory,memory_traits_aosoa<8>::layout> v;
+
+	//! [AoSoA layout]
+
+	openfpm::vector<part> vl;
+
+	BOOST_REQUIRE_EQUAL(is_layout_aosoa<memory_traits_aosoa<8>::layout<part>>::value,true);
+	BOOST_REQUIRE_EQUAL(is_layout_aosoa<memory_traits_lin<part>>::value,false);
+
+	// packed object float,double,float[3],char = 4 + 4 (pad) + 8 + 12 + 1 -> 32
+	typedef memory_aosoa<part,8> mem_type;
+	BOOST_REQUIRE_EQUAL(mem_type::obj_size,32ul);
+	BOOST_REQUIRE_EQUAL(mem_type::tile_size,8*32ul);
+
+	for (size_t i = 0 ; i < 1001 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i) = 2.0*i;
+		v.template get<2>(i)[0] = i + 1;
+		v.template get<2>(i)[1] = i + 2;
+		v.template get<2>(i)[2] = i + 3;
+		v.template get<3>(i) = i % 128;
+
+		vl.add();
+		vl.get(i) = v.get(i);
+	}
+
+	// tiles interleave the properties
+	BOOST_REQUIRE_EQUAL((char *)&v.template get<0>(1) - (char *)&v.template get<0>(0),(long int)sizeof(float));
+	BOOST_REQUIRE_EQUAL((char *)&v.template get<1>(0) - (char *)&v.template get<0>(0),(long int)(8*8));
+	BOOST_REQUIRE_EQUAL((char *)&v.template get<0>(8) - (char *)&v.template get<0>(0),(long int)mem_type::tile_size);
+
+	// copy, remove and resize go trough the encap objects
+	openfpm::vector<part,HeapMemory,memory_traits_aosoa<8>::layout> v2 = v;
+	v.remove(0);
+	v.resize(500);
+
+	for (size_t i = 0 ; i < 1001 ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v2.template get<0>(i),i);
+		BOOST_REQUIRE_EQUAL(v2.template get<1>(i),2.0*i);
+		BOOST_REQUIRE_EQUAL(v2.template get<2>(i)[2],i + 3);
+		BOOST_REQUIRE_EQUAL(v2.template get<3>(i),(char)(i % 128));
+
+		BOOST_REQUIRE_EQUAL(vl.template get<0>(i),i);
+		BOOST_REQUIRE_EQUAL(vl.template get<2>(i)[1],i + 2);
+		BOOST_REQUIRE_EQUAL(vl.template get<3>(i),(char)(i % 128));
+	}
+
+	BOOST_REQUIRE_EQUAL(v.size(),500ul);
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v.template get<0>(i),i+1);
+		BOOST_REQUIRE_EQUAL(v.template get<2>(i)[0],i + 2);
+	}
+
+	// grid
+
+	size_t sz[2] = {17,13};
+	grid_cpu_aosoa<2,part,4> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 100*key.get(1);
+		g.template get<2>(key)[1] = key.get(0);
+
+		++it;
+	}
+
+	grid_cpu_aosoa<2,part,4> g2 = g;
+
+	size_t sz2[2] = {20,20};
+	g.resize(sz2);
+
+	auto it2 = g2.getIterator();
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		BOOST_REQUIRE_EQUAL(g.template get<0>(key),key.get(0) + 100*key.get(1));
+		BOOST_REQUIRE_EQUAL(g2.template get<0>(key),key.get(0) + 100*key.get(1));
+		BOOST_REQUIRE_EQUAL(g2.template get<2>(key)[1],key.get(0));
+
+		++it2;
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/*
+ * PoolMemory_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_POOLMEMORY_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_POOLMEMORY_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "memory_ly/PoolMemory.hpp"
+#include "util/stat/common_statistics.hpp"
+
+/*! \brief Simulate the temporary buffers of a time-step
+ *
+ * Many short-lived vectors (ids, pack buffers, neighborhood scratch) of different sizes
+ * are created, filled and destroyed
+ *
+ * \tparam Memory memory of the temporary vectors
+ *
+ * \param n_step number of time-steps
+ * \param n_tmp number of temporary vectors for each time-step
+ *
+ * \return a checksum to avoid the removal of the loops
+ *
+ */
+template<typename Memory>
+size_t pool_performance_timestep(size_t n_step, size_t n_tmp)
+{
+	size_t check = 0;
+
+	for (size_t s = 0 ; s < n_step ; s++)
+	{
+		for (size_t t = 0 ; t < n_tmp ; t++)
+		{
+			size_t n = 16 + (t * 97) % 2048;
+
+			// ids filled with add (it grow the buffer several times)
+			openfpm::vector<aggregate<size_t>,Memory> ids;
+
+			for (size_t i = 0 ; i < n ; i++)
+			{
+				ids.add();
+				ids.template get<0>(i) = i;
+			}
+
+			// scratch buffer with fixed size
+			openfpm::vector<aggregate<double,double[3]>,Memory> scratch;
+			scratch.resize(n);
+
+			for (size_t i = 0 ; i < n ; i++)
+			{scratch.template get<0>(i) = ids.template get<0>(i);}
+
+			check += (size_t)scratch.template get<0>(n-1);
+		}
+	}
+
+	return check;
+}
+
+BOOST_AUTO_TEST_SUITE( pool_memory_performance )
+
+BOOST_AUTO_TEST_CASE(pool_memory_performance_temporaries)
+{
+	size_t n_step = 64;
+	size_t n_tmp = 256;
+
+	openfpm::vector<double> times_h;
+	openfpm::vector<double> times_p;
+
+	size_t check_h = 0;
+	size_t check_p = 0;
+
+	PoolMemory::release_pool();
+	pool_memory_stats & stats = PoolMemory::pool_stats();
+
+	size_t n_alloc = stats.n_alloc;
+	size_t n_malloc = stats.n_malloc;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		check_h += pool_performance_timestep<HeapMemory>(n_step,n_tmp);
+
+		t.stop();
+		times_h.add(t.getwct());
+
+		timer t2;
+		t2.start();
+
+		check_p += pool_performance_timestep<PoolMemory>(n_step,n_tmp);
+
+		t2.stop();
+		times_p.add(t2.getwct());
+	}
+
+	BOOST_REQUIRE_EQUAL(check_h,check_p);
+
+	// with HeapMemory every buffer request is a malloc
+	n_alloc = stats.n_alloc - n_alloc;
+	n_malloc = stats.n_malloc - n_malloc;
+
+	double mean_h;
+	double dev_h;
+	double mean_p;
+	double dev_p;
+	standard_deviation(times_h,mean_h,dev_h);
+	standard_deviation(times_p,mean_p,dev_p);
+
+	double n_vect = 2.0 * n_step * n_tmp;
+
+	std::cout << "Temporary vectors " << (size_t)n_vect << " per run" << std::endl;
+	std::cout << "    HeapMemory: " << mean_h << " s (dev " << dev_h << ")  " << n_vect / mean_h << " vectors/s  malloc calls: " << n_alloc << std::endl;
+	std::cout << "    PoolMemory: " << mean_p << " s (dev " << dev_p << ")  " << n_vect / mean_p << " vectors/s  malloc calls: " << n_malloc
+			  << "  speedup: " << mean_h / mean_p << std::endl;
+
+	PoolMemory::release_pool();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_POOLMEMORY_PERFORMANCE_TESTS_HPP_ */
@@ -0,0 +1,167 @@
+/*
+ * memory_layout_performance_tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_MEMORY_LAYOUT_PERFORMANCE_TESTS_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_MEMORY_LAYOUT_PERFORMANCE_TESTS_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "util/stat/common_statistics.hpp"
+
+//! particle: position, velocity, force, mass, id
+typedef aggregate<float[3],float[3],float[3],float,int> ly_part;
+
+/*! \brief Time three particle kernels on a vector with a given layout
+ *
+ * * push: x += v*dt, v += f*dt/m (stream on all the properties but the id)
+ * * kinetic: sum of m*v*v (stream on two properties)
+ * * gather: sum of the positions of particles taken in random order
+ *
+ * \tparam layout_base memory layout
+ *
+ * \param n_part number of particles
+ * \param t_push output time of the push kernel
+ * \param t_kin output time of the kinetic energy kernel
+ * \param t_gather output time of the gather kernel
+ * \param check output checksum
+ *
+ */
+template<template<typename> class layout_base>
+void ly_performance_kernels(size_t n_part, double (& t_push)[2], double (& t_kin)[2], double (& t_gather)[2], double & check)
+{
+	openfpm::vector<ly_part,HeapMemory,layout_base> v;
+	v.resize(n_part);
+
+	openfpm::vector<aggregate<int>> ord;
+	ord.resize(n_part);
+
+	srand(0);
+	for (size_t i = 0 ; i < n_part ; i++)
+	{
+		for (size_t k = 0 ; k < 3 ; k++)
+		{
+			v.template get<0>(i)[k] = (float)rand() / RAND_MAX;
+			v.template get<1>(i)[k] = (float)rand() / RAND_MAX - 0.5f;
+			v.template get<2>(i)[k] = (float)rand() / RAND_MAX - 0.5f;
+		}
+		v.template get<3>(i) = 1.0f + (float)rand() / RAND_MAX;
+		v.template get<4>(i) = i;
+
+		ord.template get<0>(i) = rand() % n_part;
+	}
+
+	openfpm::vector<double> times_push;
+	openfpm::vector<double> times_kin;
+	openfpm::vector<double> times_gather;
+
+	float dt = 0.001;
+	check = 0.0;
+
+	for (size_t r = 0 ; r < N_STAT_SMALL ; r++)
+	{
+		timer t;
+		t.start();
+
+		for (size_t i = 0 ; i < n_part ; i++)
+		{
+			float dt_m = dt / v.template get<3>(i);
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{
+				v.template get<0>(i)[k] += v.template get<1>(i)[k] * dt;
+				v.template get<1>(i)[k] += v.template get<2>(i)[k] * dt_m;
+			}
+		}
+
+		t.stop();
+		times_push.add(t.getwct());
+
+		timer t2;
+		t2.start();
+
+		double ek = 0.0;
+		for (size_t i = 0 ; i < n_part ; i++)
+		{
+			float v2 = 0.0;
+			for (size_t k = 0 ; k < 3 ; k++)
+			{v2 += v.template get<1>(i)[k] * v.template get<1>(i)[k];}
+
+			ek += v.template get<3>(i) * v2;
+		}
+
+		t2.stop();
+		times_kin.add(t2.getwct());
+
+		timer t3;
+		t3.start();
+
+		double xs = 0.0;
+		for (size_t i = 0 ; i < n_part ; i++)
+		{
+			int q = ord.template get<0>(i);
+
+			xs += v.template get<0>(q)[0] + v.template get<0>(q)[1] + v.template get<0>(q)[2];
+		}
+
+		t3.stop();
+		times_gather.add(t3.getwct());
+
+		check += ek + xs;
+	}
+
+	standard_deviation(times_push,t_push[0],t_push[1]);
+	standard_deviation(times_kin,t_kin[0],t_kin[1]);
+	standard_deviation(times_gather,t_gather[0],t_gather[1]);
+}
+
+/*! \brief Print the result of one layout
+ *
+ * \param name name of the layout
+ * \param n_part number of particles
+ * \param t_push time of the push kernel
+ * \param t_kin time of the kinetic energy kernel
+ * \param t_gather time of the gather kernel
+ *
+ */
+static inline void ly_performance_print(const char * name, size_t n_part, double (& t_push)[2], double (& t_kin)[2], double (& t_gather)[2])
+{
+	std::cout << "    " << name << "  push: " << n_part / t_push[0] << " part/s (dev " << t_push[1] << " s)"
+	          << "  kinetic: " << n_part / t_kin[0] << " part/s (dev " << t_kin[1] << " s)"
+	          << "  gather: " << n_part / t_gather[0] << " part/s (dev " << t_gather[1] << " s)" << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE( memory_layout_performance )
+
+BOOST_AUTO_TEST_CASE(memory_layout_performance_particles)
+{
+	size_t n_part = 4*1024*1024;
+
+	double t_push[2], t_kin[2], t_gather[2];
+	double check_l, check_i, check_a8, check_a16;
+
+	std::cout << "Particle kernels on " << n_part << " particles aggregate<float[3],float[3],float[3],float,int>" << std::endl;
+
+	ly_performance_kernels<memory_traits_lin>(n_part,t_push,t_kin,t_gather,check_l);
+	ly_performance_print("AoS   (memory_traits_lin)      ",n_part,t_push,t_kin,t_gather);
+
+	ly_performance_kernels<memory_traits_inte>(n_part,t_push,t_kin,t_gather,check_i);
+	ly_performance_print("SoA   (memory_traits_inte)     ",n_part,t_push,t_kin,t_gather);
+
+	ly_performance_kernels<memory_traits_aosoa<8>::layout>(n_part,t_push,t_kin,t_gather,check_a8);
+	ly_performance_print("AoSoA (memory_traits_aosoa<8>) ",n_part,t_push,t_kin,t_gather);
+
+	ly_performance_kernels<memory_traits_aosoa<16>::layout>(n_part,t_push,t_kin,t_gather,check_a16);
+	ly_performance_print("AoSoA (memory_traits_aosoa<16>)",n_part,t_push,t_kin,t_gather);
+
+	// same operations in the same order
+	BOOST_REQUIRE_EQUAL(check_l,check_i);
+	BOOST_REQUIRE_EQUAL(check_l,check_a8);
+	BOOST_REQUIRE_EQUAL(check_l,check_a16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_PERFORMANCE_MEMORY_LAYOUT_PERFORMANCE_TESTS_HPP_ */
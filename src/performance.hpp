@@ -34,6 +34,17 @@ BOOST_AUTO_TEST_SUITE( performance )
 //// Include tests ////////
 
 #include "Grid/performance/grid_performance_tests.hpp"
+#include "Grid/performance/grid_linearizer_performance_tests.hpp"
+#include "Grid/performance/grid_copy_performance_tests.hpp"
+#include "NN/CellList/performance/CellList_performance_tests.hpp"
+#include "NN/VerletList/performance/VerletList_performance_tests.hpp"
+#include "SparseGrid/performance/SparseGrid_performance_tests.hpp"
+#include "Vector/performance/vector_merge_performance_tests.hpp"
+#include "Vector/performance/vector_sparse_performance_tests.hpp"
+#include "memory_ly/performance/PoolMemory_performance_tests.hpp"
+#include "memory_ly/performance/memory_layout_performance_tests.hpp"
+#include "Packer_Unpacker/performance/Packer_performance_tests.hpp"
+#include "Space/performance/BoxIndex_performance_tests.hpp"
 //#include "Vector/performance/vector_performance_test.hpp"
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,374 @@
+/*
+ * hilbert.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: i-bird
+ */
+
+#ifndef HILBERT_HPP_
+#define HILBERT_HPP_
+
+#include "util/zmorton.hpp"
+
+//! Below this number of keys the batch functions run serial
+#define HILBERT_BATCH_PAR_MIN 4096
+
+/*! \brief State tables of the 2D and 3D Hilbert curves
+ *
+ * For a state s and the Morton digit c of a cell (bit i of c is the bit of the
+ * coordinate i) hilbertN_enc[s][c] is (next_state << N) | hilbert_digit,
+ * hilbertN_dec[s][d] is (next_state << N) | morton_digit. The curve start in the
+ * state 0 and it is the same curve produced by lin_hid for a generic dimension
+ *
+ */
+static constexpr unsigned char hilbert2_enc[4][4] = {
+	{4, 11, 1, 2}, {0, 5, 15, 6}, {10, 3, 9, 12}, {14, 13, 7, 8}};
+static constexpr unsigned char hilbert2_dec[4][4] = {
+	{4, 2, 3, 9}, {0, 5, 7, 14}, {15, 10, 8, 1}, {11, 13, 12, 6}};
+static constexpr unsigned char hilbert3_enc[24][8] = {
+	{8, 23, 27, 36, 41, 54, 2, 5}, {56, 67, 73, 10, 87, 44, 94, 13}, {148, 127, 21, 78, 51, 136, 18, 89},
+	{126, 79, 29, 132, 137, 88, 26, 3}, {72, 57, 131, 34, 95, 86, 4, 37}, {32, 99, 111, 12, 1, 42, 118, 45},
+	{156, 31, 19, 160, 53, 6, 50, 113}, {0, 33, 119, 110, 171, 58, 76, 61}, {134, 69, 185, 66, 39, 100, 104, 11},
+	{40, 55, 9, 22, 123, 60, 74, 77}, {180, 85, 91, 82, 135, 38, 184, 105}, {140, 83, 93, 90, 71, 144, 14, 17},
+	{174, 101, 63, 68, 177, 98, 80, 43}, {188, 109, 175, 62, 115, 106, 176, 81}, {164, 107, 103, 152, 117, 114, 46, 49},
+	{30, 7, 161, 112, 125, 172, 122, 75}, {70, 145, 133, 130, 15, 16, 28, 35}, {138, 179, 141, 92, 25, 128, 166, 191},
+	{146, 129, 149, 190, 155, 24, 20, 167}, {154, 169, 147, 120, 157, 182, 52, 143}, {162, 187, 121, 168, 165, 116, 142, 183},
+	{102, 153, 47, 48, 173, 170, 124, 59}, {178, 181, 139, 84, 97, 158, 64, 151}, {186, 189, 65, 150, 163, 108, 96, 159}};
+static constexpr unsigned char hilbert3_dec[24][8] = {
+	{8, 44, 6, 26, 35, 7, 53, 17}, {56, 74, 11, 65, 45, 15, 94, 84}, {141, 95, 22, 52, 144, 18, 75, 121},
+	{93, 140, 30, 7, 131, 26, 120, 73}, {72, 57, 35, 130, 6, 39, 85, 92}, {32, 4, 45, 97, 11, 47, 118, 106},
+	{163, 119, 54, 18, 152, 52, 5, 25}, {0, 33, 61, 172, 78, 63, 107, 114}, {110, 186, 67, 15, 101, 65, 128, 36},
+	{40, 10, 78, 124, 61, 79, 19, 49}, {190, 111, 83, 90, 176, 81, 37, 132}, {149, 23, 91, 81, 136, 90, 14, 68},
+	{86, 180, 101, 47, 67, 97, 168, 58}, {182, 87, 109, 116, 184, 105, 59, 170}, {155, 55, 117, 105, 160, 116, 46, 98},
+	{115, 162, 126, 79, 173, 124, 24, 1}, {21, 145, 131, 39, 30, 130, 64, 12}, {133, 28, 136, 177, 91, 138, 166, 191},
+	{29, 129, 144, 156, 22, 146, 187, 167}, {123, 169, 152, 146, 54, 156, 181, 143}, {171, 122, 160, 185, 117, 164, 142, 183},
+	{51, 153, 173, 63, 126, 172, 96, 42}, {70, 100, 176, 138, 83, 177, 157, 151}, {102, 66, 184, 164, 109, 185, 147, 159}};
+
+/*! \brief State table of an Hilbert curve that process two levels with one lookup
+ *
+ * \tparam dim dimensionality
+ * \tparam n_state number of states of the curve
+ *
+ */
+template<unsigned int dim, unsigned int n_state>
+struct hilbert_table
+{
+	//! one level (next_state << dim) | digit
+	unsigned char l1[n_state][1 << dim];
+
+	//! two levels (next_state << 2*dim) | digits
+	unsigned short l2[n_state][1 << 2*dim];
+
+	/*! \brief Construct the two levels table from the one level table
+	 *
+	 * \param t one level table
+	 *
+	 */
+	constexpr hilbert_table(const unsigned char (& t)[n_state][1 << dim])
+	:l1{},l2{}
+	{
+		for (unsigned int s = 0 ; s < n_state ; s++)
+		{
+			for (unsigned int c = 0 ; c < (1 << dim) ; c++)
+			{l1[s][c] = t[s][c];}
+		}
+
+		for (unsigned int s = 0 ; s < n_state ; s++)
+		{
+			for (unsigned int c = 0 ; c < (1 << 2*dim) ; c++)
+			{
+				unsigned int e1 = t[s][c >> dim];
+				unsigned int e2 = t[e1 >> dim][c & ((1 << dim) - 1)];
+
+				l2[s][c] = (unsigned short)(((e2 >> dim) << 2*dim) | ((e1 & ((1 << dim) - 1)) << dim) | (e2 & ((1 << dim) - 1)));
+			}
+		}
+	}
+
+	/*! \brief Walk the digits of a key from the coarse level, starting from the state 0
+	 *
+	 * \param in key to convert
+	 * \param m order of the curve
+	 *
+	 * \return the converted key
+	 *
+	 */
+	inline size_t walk(size_t in, unsigned int m) const
+	{
+		size_t out = 0;
+		unsigned int s = 0;
+		int l = m;
+
+		if (m & 0x1)
+		{
+			unsigned int e = l1[0][(in >> ((m-1)*dim)) & ((1 << dim) - 1)];
+
+			out = e & ((1 << dim) - 1);
+			s = e >> dim;
+			l--;
+		}
+
+		for (l -= 2 ; l >= 0 ; l -= 2)
+		{
+			unsigned int e = l2[s][(in >> (l*dim)) & ((1 << 2*dim) - 1)];
+
+			out = (out << 2*dim) | (e & ((1 << 2*dim) - 1));
+			s = e >> 2*dim;
+		}
+
+		return out;
+	}
+};
+
+static constexpr hilbert_table<2,4> hilbert2_enc_t(hilbert2_enc);
+static constexpr hilbert_table<2,4> hilbert2_dec_t(hilbert2_dec);
+static constexpr hilbert_table<3,24> hilbert3_enc_t(hilbert3_enc);
+static constexpr hilbert_table<3,24> hilbert3_dec_t(hilbert3_dec);
+
+/*! \brief Order of the Hilbert curve that cover a grid
+ *
+ * \param sz size of the grid in each direction
+ *
+ * \return the smallest m such that 2^m >= sz[i] for every i
+ *
+ */
+template<unsigned int dim>
+inline unsigned int hilbert_order(const size_t (& sz)[dim])
+{
+	unsigned int m = 0;
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{
+		while (((size_t)1 << m) < sz[i])
+		{m++;}
+	}
+
+	return m;
+}
+
+/*! \brief Linearize an N-dimensional key following an Hilbert curve
+ *
+ * The curve of order m pass through the 2^m x 2^m ... cells, the key is calculated
+ * with the transposition algorithm of Skilling (AIP Conf. Proc. 707, 2004) in
+ * m*dim steps. It work in any dimension, lin_hid use it when there is no
+ * table-driven implementation
+ *
+ * \param key N-dimensional key
+ * \param m order of the curve, (m*dim <= 64)
+ *
+ * \return the Hilbert key
+ *
+ */
+template<unsigned int dim, typename T>
+inline size_t lin_hid_skilling(const grid_key_dx<dim,T> & key, unsigned int m)
+{
+	static_assert(dim < 64,"Hilbert keys are supported up to dimension 63");
+
+	if (m == 0)
+	{return 0;}
+
+	size_t X[dim];
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{X[i] = key.get(i);}
+
+	// undo the rotations and reflections of the sub-cubes
+	for (size_t Q = (size_t)1 << (m-1) ; Q > 1 ; Q >>= 1)
+	{
+		size_t P = Q - 1;
+
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{
+			if (X[i] & Q)
+			{X[0] ^= P;}
+			else
+			{
+				size_t t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	for (unsigned int i = 1 ; i < dim ; i++)
+	{X[i] ^= X[i-1];}
+
+	size_t t = 0;
+	for (size_t Q = (size_t)1 << (m-1) ; Q > 1 ; Q >>= 1)
+	{
+		if (X[dim-1] & Q)
+		{t ^= Q - 1;}
+	}
+
+	// the transposed key has the bit b of the digit i in X[i]
+	size_t lin = 0;
+
+	for (int b = m-1 ; b >= 0 ; b--)
+	{
+		for (unsigned int i = 0 ; i < dim ; i++)
+		{lin = (lin << 1) | (((X[i] ^ t) >> b) & 0x1);}
+	}
+
+	return lin;
+}
+
+/*! \brief Inverse of lin_hid_skilling, from the Hilbert key to the N-dimensional key
+ *
+ * \param lin Hilbert key
+ * \param key N-dimensional key
+ * \param m order of the curve
+ *
+ */
+template<unsigned int dim, typename T>
+inline void invlin_hid_skilling(size_t lin, grid_key_dx<dim,T> & key, unsigned int m)
+{
+	static_assert(dim < 64,"Hilbert keys are supported up to dimension 63");
+
+	size_t X[dim];
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{X[i] = 0;}
+
+	int bit = m*dim - 1;
+	for (int b = m-1 ; b >= 0 ; b--)
+	{
+		for (unsigned int i = 0 ; i < dim ; i++, bit--)
+		{X[i] |= ((lin >> bit) & 0x1) << b;}
+	}
+
+	if (m != 0)
+	{
+		// Gray decode
+		size_t t = X[dim-1] >> 1;
+		for (int i = dim-1 ; i > 0 ; i--)
+		{X[i] ^= X[i-1];}
+		X[0] ^= t;
+
+		// undo the excess work
+		for (size_t Q = 2 ; Q != (size_t)2 << (m-1) ; Q <<= 1)
+		{
+			size_t P = Q - 1;
+
+			for (int i = dim-1 ; i >= 0 ; i--)
+			{
+				if (X[i] & Q)
+				{X[0] ^= P;}
+				else
+				{
+					t = (X[0] ^ X[i]) & P;
+					X[0] ^= t;
+					X[i] ^= t;
+				}
+			}
+		}
+	}
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{key.set_d(i,X[i]);}
+}
+
+/*! \brief Linearize an N-dimensional key following an Hilbert curve
+ *
+ * The curve of order m pass through the 2^m x 2^m ... cells. 2D and 3D have a
+ * table-driven implementation on the Morton key with one lookup every two levels,
+ * the other dimensions use lin_hid_skilling. Both give the same curve
+ *
+ * \param key N-dimensional key
+ * \param m order of the curve, (m*dim <= 64)
+ *
+ * \return the Hilbert key
+ *
+ */
+template<unsigned int dim, typename T>
+inline size_t lin_hid(const grid_key_dx<dim,T> & key, unsigned int m)
+{
+	return lin_hid_skilling(key,m);
+}
+
+/*! \brief Inverse of lin_hid, from the Hilbert key to the N-dimensional key
+ *
+ * \param lin Hilbert key
+ * \param key N-dimensional key
+ * \param m order of the curve
+ *
+ */
+template<unsigned int dim, typename T>
+inline void invlin_hid(size_t lin, grid_key_dx<dim,T> & key, unsigned int m)
+{
+	invlin_hid_skilling(lin,key,m);
+}
+
+template<typename T>
+inline size_t lin_hid(const grid_key_dx<1,T> & key, unsigned int m)
+{
+	return key.get(0);
+}
+
+template<typename T>
+inline void invlin_hid(size_t lin, grid_key_dx<1,T> & key, unsigned int m)
+{
+	key.set_d(0,lin);
+}
+
+template<typename T>
+inline size_t lin_hid(const grid_key_dx<2,T> & key, unsigned int m)
+{
+	return hilbert2_enc_t.walk(lin_zid(key),m);
+}
+
+template<typename T>
+inline void invlin_hid(size_t lin, grid_key_dx<2,T> & key, unsigned int m)
+{
+	invlin_zid(hilbert2_dec_t.walk(lin,m),key);
+}
+
+template<typename T>
+inline size_t lin_hid(const grid_key_dx<3,T> & key, unsigned int m)
+{
+	return hilbert3_enc_t.walk(lin_zid(key),m);
+}
+
+template<typename T>
+inline void invlin_hid(size_t lin, grid_key_dx<3,T> & key, unsigned int m)
+{
+	invlin_zid(hilbert3_dec_t.walk(lin,m),key);
+}
+
+/*! \brief Hilbert keys of a set of N-dimensional keys
+ *
+ * Used to sort particles, cells or blocks along an Hilbert curve, the keys are calculated in parallel
+ *
+ * \param keys vector of grid_key_dx (for example openfpm::vector<grid_key_dx<dim>>)
+ * \param lin output vector of Hilbert keys (for example openfpm::vector<size_t>), it is resized
+ * \param m order of the curve
+ *
+ */
+template<typename vector_key_type, typename vector_lin_type>
+void lin_hid_batch(const vector_key_type & keys, vector_lin_type & lin, unsigned int m)
+{
+	lin.resize(keys.size());
+
+	#pragma omp parallel for if (keys.size() >= HILBERT_BATCH_PAR_MIN)
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{lin.get(i) = lin_hid(keys.get(i),m);}
+}
+
+/*! \brief N-dimensional keys of a set of Hilbert keys
+ *
+ * \param lin vector of Hilbert keys (for example openfpm::vector<size_t>)
+ * \param keys output vector of grid_key_dx (for example openfpm::vector<grid_key_dx<dim>>), it is resized
+ * \param m order of the curve
+ *
+ */
+template<typename vector_lin_type, typename vector_key_type>
+void invlin_hid_batch(const vector_lin_type & lin, vector_key_type & keys, unsigned int m)
+{
+	keys.resize(lin.size());
+
+	#pragma omp parallel for if (lin.size() >= HILBERT_BATCH_PAR_MIN)
+	for (size_t i = 0 ; i < lin.size() ; i++)
+	{invlin_hid(lin.get(i),keys.get(i),m);}
+}
+
+#endif /* HILBERT_HPP_ */
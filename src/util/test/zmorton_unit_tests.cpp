@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "util/zmorton.hpp"
+#include "Vector/map_vector.hpp"
 
 template<typename T>
 bool check(size_t res, grid_key_dx<2,T> & k)
@@ -89,6 +90,50 @@ bool check(size_t res, grid_key_dx<2,T> & k)
 	return check;
 }
 
+/*! \brief Reference Morton key, the bit b of the coordinate i go in b*dim + i
+ *
+ */
+template<unsigned int dim>
+size_t zmorton_reference(const grid_key_dx<dim> & k)
+{
+	size_t res = 0;
+
+	for (size_t b = 0 ; b*dim < 64 ; b++)
+	{
+		for (size_t i = 0 ; i < dim && b*dim + i < 64 ; i++)
+		{res |= (((size_t)k.get(i) >> b) & 0x1) << (b*dim + i);}
+	}
+
+	return res;
+}
+
+/*! \brief Check lin_zid and invlin_zid against the reference with random keys
+ *
+ */
+template<unsigned int dim>
+void zmorton_check_ndim(size_t n)
+{
+	bool match = true;
+
+	for (size_t j = 0 ; j < n ; j++)
+	{
+		grid_key_dx<dim> key;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{key.set_d(i,(((size_t)rand() << 31) ^ rand()) & (((size_t)1 << (64 / dim)) - 1) & 0x7FFFFFFF);}
+
+		size_t lin = lin_zid(key);
+		match &= (lin == zmorton_reference(key));
+
+		grid_key_dx<dim> ikey;
+		invlin_zid(lin,ikey);
+
+		match &= (key == ikey);
+	}
+
+	BOOST_REQUIRE(match == true);
+}
+
 BOOST_AUTO_TEST_SUITE( zmorton_suite_test )
 
 BOOST_AUTO_TEST_CASE( zmorton_linearization_test )
@@ -537,6 +582,64 @@ BOOST_AUTO_TEST_CASE( zmorton_invlinearization_test )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( zmorton_ndim_test )
+{
+	srand(0);
+
+	zmorton_check_ndim<2>(10000);
+	zmorton_check_ndim<3>(10000);
+	zmorton_check_ndim<4>(10000);
+	zmorton_check_ndim<5>(10000);
+	zmorton_check_ndim<7>(10000);
+
+	// 4D first bits
+
+	grid_key_dx<4> key({1,0,0,0});
+	BOOST_REQUIRE_EQUAL(lin_zid(key),1ul);
+
+	grid_key_dx<4> key2({0,0,0,1});
+	BOOST_REQUIRE_EQUAL(lin_zid(key2),8ul);
+
+	grid_key_dx<4> key3({2,2,2,2});
+	BOOST_REQUIRE_EQUAL(lin_zid(key3),0xF0ul);
+
+	grid_key_dx<4> key4({0xFFFF,0xFFFF,0xFFFF,0xFFFF});
+	BOOST_REQUIRE_EQUAL(lin_zid(key4),0xFFFFFFFFFFFFFFFFul);
+}
+
+BOOST_AUTO_TEST_CASE( zmorton_batch_test )
+{
+	openfpm::vector<grid_key_dx<3>> keys;
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		grid_key_dx<3> k({(long int)(i % 17),(long int)(i % 31),(long int)(i / 7)});
+		keys.add(k);
+	}
+
+	//! [Morton keys of a set of keys]
+
+	openfpm::vector<size_t> lin;
+	lin_zid_batch(keys,lin);
+
+	openfpm::vector<grid_key_dx<3>> keys2;
+	invlin_zid_batch(lin,keys2);
+
+	//! [Morton keys of a set of keys]
+
+	BOOST_REQUIRE_EQUAL(lin.size(),keys.size());
+	BOOST_REQUIRE_EQUAL(keys2.size(),keys.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{
+		match &= lin.get(i) == lin_zid(keys.get(i));
+		match &= keys2.get(i) == keys.get(i);
+	}
+
+	BOOST_REQUIRE(match == true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
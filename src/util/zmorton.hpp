@@ -10,6 +10,155 @@
 
 #include "Grid/grid_key.hpp"
 
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#endif
+
+//! Below this number of keys the batch functions run serial
+#define ZMORTON_BATCH_PAR_MIN 4096
+
+/*! \brief Mask of the bits of the coordinate i in a Morton key of dimension dim
+ *
+ * The bit b of the coordinate i is the bit b*dim + i of the key
+ *
+ * \param dim dimensionality
+ * \param i coordinate
+ *
+ * \return the mask
+ *
+ */
+constexpr size_t zmorton_mask(unsigned int dim, unsigned int i)
+{
+	size_t m = 0;
+
+	for (unsigned int b = i ; b < 64 ; b += dim)
+	{m |= (size_t)1 << b;}
+
+	return m;
+}
+
+/*! \brief Mask of the bits of the coordinate i in a Morton key of dimension dim (compile-time)
+ *
+ * \tparam dim dimensionality
+ * \tparam i coordinate
+ *
+ */
+template<unsigned int dim, unsigned int i>
+struct zmorton_mask_ct
+{
+	static constexpr size_t value = zmorton_mask(dim,i);
+};
+
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+/*! \brief Deposit and extract the bits of the coordinates i ... dim-1 with BMI2
+ *
+ * \tparam dim dimensionality
+ * \tparam i coordinate
+ *
+ */
+template<unsigned int dim, unsigned int i>
+struct zmorton_bmi2
+{
+	//! deposit the bits of the coordinates i ... dim-1
+	template<typename key_type>
+	static inline size_t pdep(const key_type & key)
+	{
+		return _pdep_u64((size_t)key.get(i),zmorton_mask_ct<dim,i>::value) | zmorton_bmi2<dim,i+1>::pdep(key);
+	}
+
+	//! extract the bits of the coordinates i ... dim-1
+	template<typename key_type>
+	static inline void pext(size_t lin, key_type & key)
+	{
+		key.set_d(i,_pext_u64(lin,zmorton_mask_ct<dim,i>::value));
+		zmorton_bmi2<dim,i+1>::pext(lin,key);
+	}
+};
+
+template<unsigned int dim>
+struct zmorton_bmi2<dim,dim>
+{
+	template<typename key_type>
+	static inline size_t pdep(const key_type & key)
+	{return 0;}
+
+	template<typename key_type>
+	static inline void pext(size_t lin, key_type & key)
+	{}
+};
+
+#endif
+
+/*! \brief Morton (Z) key of an N-dimensional key
+ *
+ * The bits of the coordinates are interleaved, the bit b of the coordinate i is the
+ * bit b*dim + i of the key, so only the first 64/dim bits of each coordinate are used.
+ * When BMI2 is available (-mbmi2 or -march) the bits are deposited with pdep,
+ * otherwise they are moved one by one. 2D and 3D have a specialized implementation
+ *
+ * \param key N-dimensional key
+ *
+ * \return the Morton key
+ *
+ */
+template<unsigned int dim, typename T>
+inline __device__ __host__ size_t lin_zid(const grid_key_dx<dim,T> & key)
+{
+	static_assert(dim < 64,"Morton keys are supported up to dimension 63");
+
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	return zmorton_bmi2<dim,0>::pdep(key);
+
+#else
+
+	size_t lin = 0;
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{
+		size_t x = key.get(i);
+
+		for (unsigned int b = i ; x != 0 && b < 64 ; b += dim, x >>= 1)
+		{lin |= (x & 0x1) << b;}
+	}
+
+	return lin;
+
+#endif
+}
+
+/*! \brief Inverse of lin_zid, from the Morton key to the N-dimensional key
+ *
+ * \param lin Morton key
+ * \param key N-dimensional key
+ *
+ */
+template<unsigned int dim, typename T>
+inline __device__ __host__ void invlin_zid(size_t lin, grid_key_dx<dim,T> & key)
+{
+	static_assert(dim < 64,"Morton keys are supported up to dimension 63");
+
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	zmorton_bmi2<dim,0>::pext(lin,key);
+
+#else
+
+	for (unsigned int i = 0 ; i < dim ; i++)
+	{
+		size_t x = 0;
+		size_t l = lin >> i;
+
+		for (unsigned int b = 0 ; l != 0 ; b++, l >>= dim)
+		{x |= (l & 0x1) << b;}
+
+		key.set_d(i,x);
+	}
+
+#endif
+}
+
 template<typename T>
 inline __device__ __host__ size_t lin_zid(const grid_key_dx<1,T> & key)
 {
@@ -29,6 +178,11 @@ inline __device__ __host__  size_t lin_zid(const grid_key_dx<2,T> & key)
 	size_t x = key.get(0);
 	size_t y = key.get(1);
 
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	return _pdep_u64(x,0x5555555555555555) | _pdep_u64(y,0xAAAAAAAAAAAAAAAA);
+
+#else
 
 	x = (x | (x << 16)) & 0x0000FFFF0000FFFF;
 	x = (x | (x << 8)) & 0x00FF00FF00FF00FF;
@@ -43,11 +197,20 @@ inline __device__ __host__  size_t lin_zid(const grid_key_dx<2,T> & key)
 	y = (y | (y << 1)) & 0x5555555555555555;
 
 	return x | (y << 1);
+
+#endif
 }
 
 template<typename T>
 inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<2,T> & key)
 {
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	key.set_d(0,_pext_u64(lin,0x5555555555555555));
+	key.set_d(1,_pext_u64(lin,0xAAAAAAAAAAAAAAAA));
+
+#else
+
 	size_t x = lin & 0x5555555555555555;
 	size_t y = (lin & 0xAAAAAAAAAAAAAAAA) >> 1;
 
@@ -65,6 +228,8 @@ inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<2,T> & key)
 
 	key.set_d(0,x);
 	key.set_d(1,y);
+
+#endif
 }
 
 static const size_t S3[] = {2, 4, 8, 16, 32};
@@ -76,6 +241,12 @@ inline __device__ __host__  size_t lin_zid(const grid_key_dx<3,T> & key)
 	size_t z = key.get(2);
 	size_t y = key.get(1);
 
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	return _pdep_u64(x,zmorton_mask_ct<3,0>::value) | _pdep_u64(y,zmorton_mask_ct<3,1>::value) | _pdep_u64(z,zmorton_mask_ct<3,2>::value);
+
+#else
+
 	x = (x | (x << 32)) & 0xFFFF0000FFFFFFFF;
 	x = (x | (x << 16)) & 0x0FFF000FFF000FFF;
 	x = (x | (x << 8)) & 0xF00F00F00F00F00F;
@@ -95,11 +266,21 @@ inline __device__ __host__  size_t lin_zid(const grid_key_dx<3,T> & key)
 	z = (z | (z << 2)) & 0x9249249249249249;
 
 	return x | (y << 1) | (z << 2);
+
+#endif
 }
 
 template<typename T>
 inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<3,T> & key)
 {
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+
+	key.set_d(0,_pext_u64(lin,zmorton_mask_ct<3,0>::value));
+	key.set_d(1,_pext_u64(lin,zmorton_mask_ct<3,1>::value));
+	key.set_d(2,_pext_u64(lin,zmorton_mask_ct<3,2>::value));
+
+#else
+
 	size_t x = lin & 0x9249249249249249;
 	size_t y = (lin >> 1) & 0x9249249249249249;
 	size_t z = (lin >> 2) & 0x9249249249249249;
@@ -125,6 +306,42 @@ inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<3,T> & key)
 	key.set_d(0,x);
 	key.set_d(1,y);
 	key.set_d(2,z);
+
+#endif
+}
+
+/*! \brief Morton keys of a set of N-dimensional keys
+ *
+ * Used to sort particles, cells or blocks by Z-order, the keys are calculated in parallel
+ *
+ * \param keys vector of grid_key_dx (for example openfpm::vector<grid_key_dx<dim>>)
+ * \param lin output vector of Morton keys (for example openfpm::vector<size_t>), it is resized
+ *
+ */
+template<typename vector_key_type, typename vector_lin_type>
+void lin_zid_batch(const vector_key_type & keys, vector_lin_type & lin)
+{
+	lin.resize(keys.size());
+
+	#pragma omp parallel for if (keys.size() >= ZMORTON_BATCH_PAR_MIN)
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{lin.get(i) = lin_zid(keys.get(i));}
+}
+
+/*! \brief N-dimensional keys of a set of Morton keys
+ *
+ * \param lin vector of Morton keys (for example openfpm::vector<size_t>)
+ * \param keys output vector of grid_key_dx (for example openfpm::vector<grid_key_dx<dim>>), it is resized
+ *
+ */
+template<typename vector_lin_type, typename vector_key_type>
+void invlin_zid_batch(const vector_lin_type & lin, vector_key_type & keys)
+{
+	keys.resize(lin.size());
+
+	#pragma omp parallel for if (lin.size() >= ZMORTON_BATCH_PAR_MIN)
+	for (size_t i = 0 ; i < lin.size() ; i++)
+	{invlin_zid(lin.get(i),keys.get(i));}
 }
 
 #endif /* ZMORTON_HPP_ */